@@ -0,0 +1,62 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/domain/chain/block.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+#include <kth/infrastructure/utility/endian.hpp>
+
+using namespace kth;
+using namespace kd;
+
+namespace {
+
+// Two inputs and two outputs with p2pkh sized scripts per transaction.
+data_chunk make_block(size_t transactions) {
+    chain::transaction::list txs;
+    txs.reserve(transactions);
+
+    for (size_t i = 0; i < transactions; ++i) {
+        auto const hash = bitcoin_hash(to_little_endian(uint64_t(i)));
+
+        chain::input::list inputs;
+        inputs.emplace_back(chain::output_point{hash, 0}, chain::script{data_chunk(107, 0x51), false}, 0xffffffff);
+        inputs.emplace_back(chain::output_point{hash, 1}, chain::script{data_chunk(107, 0x52), false}, 0xffffffff);
+
+        chain::output::list outputs;
+        outputs.emplace_back(1000, chain::script{data_chunk(25, 0x76), false}, chain::token_data_opt{});
+        outputs.emplace_back(2000, chain::script{data_chunk(25, 0xa9), false}, chain::token_data_opt{});
+
+        txs.emplace_back(1, 0, std::move(inputs), std::move(outputs));
+    }
+
+    chain::block const block(chain::header{}, std::move(txs));
+    return block.to_data();
+}
+
+} // namespace
+
+TEST_CASE("block deserialization", "[!benchmark][block arena]") {
+    // Roughly a 2MB block.
+    auto const raw = make_block(5'000);
+    std::vector<std::byte> buffer(raw.size() * 4);
+
+    BENCHMARK("default resource") {
+        byte_reader reader(raw);
+        return chain::block::from_data(reader).has_value();
+    };
+
+    BENCHMARK("monotonic resource") {
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+        byte_reader reader(raw);
+        return chain::block::from_data(reader, true, &arena).has_value();
+    };
+}
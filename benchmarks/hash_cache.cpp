@@ -0,0 +1,135 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/domain/chain/transaction.hpp>
+#include <kth/domain/utility/atomic_cache.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/utility/thread.hpp>
+
+using namespace kth;
+using namespace kd;
+
+namespace {
+
+// The memoization scheme formerly used by transaction and hash_memoizer.
+class locked_cache {
+public:
+    template <typename Compute>
+    hash_digest get(Compute&& compute) const {
+        mutex_.lock_upgrade();
+
+        if ( ! hash_) {
+            mutex_.unlock_upgrade_and_lock();
+            hash_ = std::make_shared<hash_digest>(compute());
+            mutex_.unlock_and_lock_upgrade();
+        }
+
+        auto const hash = *hash_;
+        mutex_.unlock_upgrade();
+        return hash;
+    }
+
+private:
+    mutable upgrade_mutex mutex_;
+    mutable std::shared_ptr<hash_digest> hash_;
+};
+
+size_t const lookups = 100'000;
+
+size_t threads() {
+    return std::max(2u, std::thread::hardware_concurrency());
+}
+
+// All threads hit the same (already populated) cache entry.
+template <typename Cache>
+size_t contended_lookups(Cache const& cache, hash_digest const& value) {
+    std::vector<std::thread> workers;
+    std::vector<size_t> hits(threads(), 0);
+
+    for (size_t worker = 0; worker < hits.size(); ++worker) {
+        workers.emplace_back([&, worker] {
+            for (size_t i = 0; i < lookups; ++i) {
+                hits[worker] += cache.get([&] { return value; })[i % value.size()] & 1;
+            }
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    size_t total = 0;
+    for (auto const hit : hits) {
+        total += hit;
+    }
+    return total;
+}
+
+chain::transaction make_transaction() {
+    chain::input::list inputs;
+    chain::output::list outputs;
+
+    for (uint32_t index = 0; index < 8; ++index) {
+        inputs.emplace_back(chain::output_point{null_hash, index}, chain::script{}, 0xffffffff);
+        outputs.emplace_back(index, chain::script{}, chain::token_data_opt{});
+    }
+
+    return chain::transaction(1, 0, std::move(inputs), std::move(outputs));
+}
+
+} // namespace
+
+TEST_CASE("hash cache  contended lookups", "[!benchmark][hash cache]") {
+    auto const value = bitcoin_hash(to_chunk(std::string("knuth")));
+
+    locked_cache const locked;
+    atomic_cache<hash_digest> const atomic;
+    REQUIRE(contended_lookups(locked, value) == contended_lookups(atomic, value));
+
+    BENCHMARK("upgrade_mutex + shared_ptr") {
+        return contended_lookups(locked, value);
+    };
+
+    BENCHMARK("atomic_cache") {
+        return contended_lookups(atomic, value);
+    };
+}
+
+TEST_CASE("hash cache  transaction hash and copy", "[!benchmark][hash cache]") {
+    auto const tx = make_transaction();
+    auto const hash = tx.hash();
+
+    BENCHMARK("transaction::hash contended") {
+        std::vector<std::thread> workers;
+        std::vector<size_t> hits(threads(), 0);
+
+        for (size_t worker = 0; worker < hits.size(); ++worker) {
+            workers.emplace_back([&, worker] {
+                for (size_t i = 0; i < lookups; ++i) {
+                    hits[worker] += tx.hash() == hash;
+                }
+            });
+        }
+
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        return hits.front();
+    };
+
+    BENCHMARK("transaction copy") {
+        auto const copy = tx;
+        return copy.hash();
+    };
+}
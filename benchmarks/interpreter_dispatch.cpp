@@ -0,0 +1,195 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/domain/chain/script.hpp>
+#include <kth/domain/chain/transaction.hpp>
+#include <kth/domain/machine/interpreter.hpp>
+#include <kth/domain/machine/program.hpp>
+#include <kth/domain/machine/rule_fork.hpp>
+#include <kth/infrastructure/formats/base_16.hpp>
+#include <kth/infrastructure/machine/sighash_algorithm.hpp>
+#include <kth/infrastructure/math/elliptic_curve.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::infrastructure::machine;
+
+namespace {
+
+using machine::rule_fork;
+
+#if defined(KTH_CURRENCY_BCH)
+uint32_t const forks = rule_fork::bip16_rule | rule_fork::bip65_rule | rule_fork::bip66_rule |
+    rule_fork::bip112_rule | rule_fork::bch_uahf | rule_fork::bch_pythagoras | rule_fork::bch_euclid |
+    rule_fork::bch_pisano | rule_fork::bch_mersenne | rule_fork::bch_fermat | rule_fork::bch_euler |
+    rule_fork::bch_gauss | rule_fork::bch_descartes | rule_fork::bch_lobachevski | rule_fork::bch_galois;
+uint8_t const sign_all = sighash_algorithm::forkid_all;
+#else
+uint32_t const forks = rule_fork::bip16_rule | rule_fork::bip65_rule | rule_fork::bip66_rule | rule_fork::bip112_rule;
+uint8_t const sign_all = sighash_algorithm::all;
+#endif
+
+uint64_t const prevout_value = 100'000;
+
+struct input_program {
+    chain::transaction tx;
+    uint32_t index;
+    uint32_t forks;
+};
+
+struct key {
+    ec_secret secret;
+    std::string point;
+    std::string hash;
+};
+
+key make_key(uint8_t salt) {
+    key result;
+    result.secret.fill(salt);
+    ec_compressed point;
+    REQUIRE(secret_to_public(point, result.secret));
+    result.point = encode_base16(point);
+    result.hash = encode_base16(bitcoin_short_hash(point));
+    return result;
+}
+
+chain::script make_script(std::string const& mnemonic) {
+    chain::script result;
+    REQUIRE(result.from_string(mnemonic));
+    return result;
+}
+
+std::string sign(key const& signer, chain::script const& script_code, chain::transaction const& tx, uint32_t index, uint8_t type) {
+#if defined(KTH_CURRENCY_BCH)
+    auto const endorsement = chain::script::create_endorsement(signer.secret, script_code, tx, index, type, forks, prevout_value);
+#else
+    auto const endorsement = chain::script::create_endorsement(signer.secret, script_code, tx, index, type, forks, chain::script::script_version::unversioned, prevout_value);
+#endif
+    REQUIRE(endorsement);
+    return "[" + encode_base16(*endorsement) + "]";
+}
+
+// The standard post-fork spends, signed with the fork id: p2pkh (sighash all
+// and all|anyone_can_pay), p2pk and a p2sh 2-of-3 multisig. The interpreter
+// verifies ecdsa signatures only, so there are no Schnorr spends.
+std::vector<input_program> make_spends() {
+    auto const first = make_key(0x01);
+    auto const second = make_key(0x02);
+    auto const third = make_key(0x03);
+
+    auto const pay_key_hash = make_script("dup hash160 [" + first.hash + "] equalverify checksig");
+    auto const pay_key = make_script("[" + second.point + "] checksig");
+    auto const redeem = make_script("2 [" + first.point + "] [" + second.point + "] [" + third.point + "] 3 checkmultisig");
+    auto const redeem_hex = encode_base16(redeem.to_data(false));
+    auto const pay_script_hash = make_script("hash160 [" + encode_base16(bitcoin_short_hash(redeem.to_data(false))) + "] equal");
+    std::vector<chain::script> const prevouts{pay_key_hash, pay_key_hash, pay_key, pay_script_hash};
+
+    chain::input::list inputs;
+    for (uint32_t index = 0; index < prevouts.size(); ++index) {
+        auto hash = null_hash;
+        hash.fill(uint8_t(0x10 + index));
+        inputs.emplace_back(chain::output_point{hash, index}, chain::script{}, 0xffffffff);
+    }
+
+    chain::output::list outputs;
+    outputs.emplace_back(prevout_value * prevouts.size() - 1000, pay_key_hash, chain::token_data_opt{});
+    chain::transaction tx(2, 0, std::move(inputs), std::move(outputs));
+
+    for (size_t index = 0; index < prevouts.size(); ++index) {
+        auto& prevout = tx.inputs()[index].previous_output().validation.cache;
+        prevout.set_script(prevouts[index]);
+        prevout.set_value(prevout_value);
+    }
+
+    // Input scripts are not signed, so each is set once all are signed.
+    auto const key_hash_all = sign(first, pay_key_hash, tx, 0, sign_all);
+    auto const key_hash_anyone = sign(first, pay_key_hash, tx, 1, sign_all | sighash_algorithm::anyone_can_pay);
+    auto const key_all = sign(second, pay_key, tx, 2, sign_all);
+    auto const multisig_first = sign(first, redeem, tx, 3, sign_all);
+    auto const multisig_third = sign(third, redeem, tx, 3, sign_all);
+
+    tx.inputs()[0].set_script(make_script(key_hash_all + " [" + first.point + "]"));
+    tx.inputs()[1].set_script(make_script(key_hash_anyone + " [" + first.point + "]"));
+    tx.inputs()[2].set_script(make_script(key_all));
+    tx.inputs()[3].set_script(make_script("0 " + multisig_first + " " + multisig_third + " [" + redeem_hex + "]"));
+
+    std::vector<input_program> result;
+    for (uint32_t index = 0; index < prevouts.size(); ++index) {
+        result.push_back({tx, index, forks});
+    }
+    return result;
+}
+
+// The input, prevout and p2sh redeem scripts of the input as verify() runs
+// them, with the given dispatch.
+code run(input_program const& spend, machine::interpreter::dispatch mode) {
+    using machine::interpreter;
+    auto const& input_script = spend.tx.inputs()[spend.index].script();
+    auto const& prevout_script = spend.tx.inputs()[spend.index].previous_output().validation.cache.script();
+
+    machine::program input(input_script, spend.tx, spend.index, spend.forks);
+    if (auto const ec = interpreter::run(input, mode)) {
+        return ec;
+    }
+
+    machine::program prevout(prevout_script, input);
+    if (auto const ec = interpreter::run(prevout, mode)) {
+        return ec;
+    }
+
+    if ( ! prevout.stack_result(false)) {
+        return error::stack_false;
+    }
+
+    if ( ! prevout_script.is_pay_to_script_hash(spend.forks)) {
+        return error::success;
+    }
+
+    auto const redeem = create<chain::script>(input.pop().to_chunk(), false);
+    machine::program embedded(redeem, std::move(input), true);
+    if (auto const ec = interpreter::run(embedded, mode)) {
+        return ec;
+    }
+
+    return embedded.stack_result(false) ? error::success : error::stack_false;
+}
+
+} // namespace
+
+// Signature checks are included, after the first run their signatures are
+// in the signature cache, as those of transactions verified for the mempool
+// are when their block is connected.
+TEST_CASE("interpreter dispatch", "[!benchmark][interpreter dispatch]") {
+    auto const inputs = make_spends();
+
+    for (auto const& spend : inputs) {
+        auto const switched = run(spend, machine::interpreter::dispatch::switched);
+        REQUIRE(switched == error::success);
+        REQUIRE(run(spend, machine::interpreter::dispatch::threaded) == switched);
+    }
+
+    BENCHMARK("switched") {
+        size_t succeeded = 0;
+        for (auto const& spend : inputs) {
+            succeeded += run(spend, machine::interpreter::dispatch::switched) ? 0 : 1;
+        }
+        return succeeded;
+    };
+
+    BENCHMARK("threaded") {
+        size_t succeeded = 0;
+        for (auto const& spend : inputs) {
+            succeeded += run(spend, machine::interpreter::dispatch::threaded) ? 0 : 1;
+        }
+        return succeeded;
+    };
+}
@@ -0,0 +1,68 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <thread>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/domain/math/merkle.hpp>
+#include <kth/domain/math/sha256.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+#include <kth/infrastructure/utility/endian.hpp>
+
+using namespace kth;
+using namespace kd;
+
+namespace {
+
+// The former block_basis::generate_merkle_root.
+hash_digest pairwise_root(hash_list merkle) {
+    hash_list update;
+    update.reserve((merkle.size() + 1) / 2);
+
+    while (merkle.size() > 1) {
+        if (merkle.size() % 2 != 0) {
+            merkle.push_back(merkle.back());
+        }
+
+        for (auto it = merkle.begin(); it != merkle.end(); it += 2) {
+            update.push_back(bitcoin_hash(build_chunk({it[0], it[1]})));
+        }
+
+        std::swap(merkle, update);
+        update.clear();
+    }
+
+    return merkle.front();
+}
+
+} // namespace
+
+TEST_CASE("merkle root", "[!benchmark][merkle]") {
+    // Roughly the transaction count of a 32MB block.
+    hash_list leaves(100'000);
+    for (size_t i = 0; i < leaves.size(); ++i) {
+        leaves[i] = bitcoin_hash(to_little_endian(uint64_t(i)));
+    }
+
+    auto const threads = std::max(2u, std::thread::hardware_concurrency());
+    REQUIRE(pairwise_root(leaves) == merkle_root(leaves, threads));
+
+    BENCHMARK("pairwise") {
+        return pairwise_root(leaves);
+    };
+
+    BENCHMARK(std::string("in place, ") + sha256_implementation()) {
+        return merkle_root(leaves);
+    };
+
+    BENCHMARK(std::string("in place, threaded, ") + sha256_implementation()) {
+        return merkle_root(leaves, threads);
+    };
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <memory_resource>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/domain/chain/script.hpp>
+#include <kth/domain/chain/transaction.hpp>
+#include <kth/domain/machine/program.hpp>
+#include <kth/domain/machine/rule_fork.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+using namespace kth;
+using namespace kd;
+
+namespace {
+
+// The stack operations of a p2pkh spend, the signature check replaced by
+// dropping the endorsement and the key: [endorsement] [key] dup hash160
+// [hash] equalverify 2drop 1.
+data_chunk make_script() {
+    data_chunk const endorsement(72, 0x30);
+    data_chunk const key(33, 0x02);
+    auto const hash = bitcoin_short_hash(key);
+
+    data_chunk script;
+    script.push_back(uint8_t(endorsement.size()));
+    script.insert(script.end(), endorsement.begin(), endorsement.end());
+    script.push_back(uint8_t(key.size()));
+    script.insert(script.end(), key.begin(), key.end());
+    script.push_back(uint8_t(machine::opcode::dup));
+    script.push_back(uint8_t(machine::opcode::hash160));
+    script.push_back(uint8_t(hash.size()));
+    script.insert(script.end(), hash.begin(), hash.end());
+    script.push_back(uint8_t(machine::opcode::equalverify));
+    script.push_back(uint8_t(machine::opcode::drop2));
+    script.push_back(uint8_t(machine::opcode::push_positive_1));
+    return script;
+}
+
+} // namespace
+
+TEST_CASE("script stack", "[!benchmark][script stack]") {
+    chain::script const script(make_script(), false);
+    chain::transaction const tx;
+    auto const forks = machine::rule_fork::all_rules;
+
+    BENCHMARK("default resource") {
+        machine::program program(script, tx, 0, forks);
+        return program.evaluate();
+    };
+
+    std::pmr::unsynchronized_pool_resource pool;
+
+    BENCHMARK("pool resource") {
+        machine::program program(script, tx, 0, forks, nullptr, &pool);
+        return program.evaluate();
+    };
+}
@@ -0,0 +1,40 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <kth/domain/math/sip_hash.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/math/sip_hash.hpp>
+#include <kth/infrastructure/utility/endian.hpp>
+
+using namespace kth;
+using namespace kd;
+
+TEST_CASE("sip hash short ids", "[!benchmark][sip hash]") {
+    // The short ids of a large mempool, recomputed for every block.
+    hash_list txids(100'000);
+    for (size_t i = 0; i < txids.size(); ++i) {
+        txids[i] = bitcoin_hash(to_little_endian(uint64_t(i)));
+    }
+
+    std::vector<uint64_t> ids(txids.size());
+
+    BENCHMARK("one by one") {
+        for (size_t i = 0; i < txids.size(); ++i) {
+            ids[i] = sip_hash_uint256(1, 2, txids[i]);
+        }
+        return ids.back();
+    };
+
+    BENCHMARK(std::string("batch, ") + sip_hash_implementation()) {
+        sip_hash_uint256_batch(ids.data(), 1, 2, txids.data(), txids.size());
+        return ids.back();
+    };
+}
@@ -23,6 +23,7 @@ class KnuthDomainConan(KnuthConanFileV2):
                "with_qrencode": [True, False],
                "tests": [True, False],
                "examples": [True, False],
+               "benchmarks": [True, False],
                "currency": ['BCH', 'BTC', 'LTC'],
 
                "march_id": ["ANY"],
@@ -43,6 +44,7 @@ class KnuthDomainConan(KnuthConanFileV2):
         "with_qrencode": False,
         "tests": False,
         "examples": False,
+        "benchmarks": False,
         "currency": "BCH",
 
         "march_strategy": "download_if_possible",
@@ -53,10 +55,10 @@ class KnuthDomainConan(KnuthConanFileV2):
         "disable_get_blocks": False,
     }
 
-    exports_sources = "src/*", "CMakeLists.txt", "ci_utils/cmake/*", "cmake/*", "include/*", "test/*", "examples/*", "test_new/*"
+    exports_sources = "src/*", "CMakeLists.txt", "ci_utils/cmake/*", "cmake/*", "include/*", "test/*", "examples/*", "benchmarks/*", "test_new/*"
 
     def build_requirements(self):
-        if self.options.tests:
+        if self.options.tests or self.options.benchmarks:
             self.test_requires("catch2/3.7.1")
 
     def requirements(self):
@@ -92,6 +94,7 @@ class KnuthDomainConan(KnuthConanFileV2):
         tc.variables["WITH_QRENCODE"] = option_on_off(self.options.with_qrencode)
         # tc.variables["WITH_PNG"] = option_on_off(self.options.with_png)
         tc.variables["WITH_PNG"] = option_on_off(self.options.with_qrencode)
+        tc.variables["WITH_BENCHMARKS"] = option_on_off(self.options.benchmarks)
         tc.variables["LOG_LIBRARY"] = self.options.log
         tc.variables["CONAN_DISABLE_CHECK_COMPILER"] = option_on_off(True)
 
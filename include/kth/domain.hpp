@@ -10,7 +10,9 @@
 #include <kth/domain/version.hpp>
 
 #include <kth/domain/chain/abla.hpp>
+#include <kth/domain/chain/abla_schedule.hpp>
 #include <kth/domain/chain/block.hpp>
+#include <kth/domain/chain/block_view.hpp>
 #include <kth/domain/chain/chain_state.hpp>
 #include <kth/domain/common.hpp>
 #include <kth/domain/chain/compact.hpp>
@@ -24,19 +26,34 @@
 #include <kth/domain/chain/point_iterator.hpp>
 #include <kth/domain/chain/point_value.hpp>
 #include <kth/domain/chain/points_value.hpp>
+#include <kth/domain/chain/redeem_script_cache.hpp>
 #include <kth/domain/chain/script.hpp>
+#include <kth/domain/chain/script_cache.hpp>
+#include <kth/domain/chain/script_template.hpp>
+#include <kth/domain/chain/sighash_context.hpp>
 #include <kth/domain/chain/stealth.hpp>
 #include <kth/domain/chain/transaction.hpp>
+#include <kth/domain/chain/utxo_record.hpp>
+#include <kth/domain/chain/verification_context.hpp>
+#include <kth/domain/chain/verification_pool.hpp>
 
 #include <kth/domain/config/network.hpp>
 #include <kth/domain/config/parser.hpp>
 
+#include <kth/domain/machine/bytecode.hpp>
 #include <kth/domain/machine/interpreter.hpp>
 #include <kth/domain/machine/opcode.hpp>
+#include <kth/domain/machine/opcode_profile.hpp>
 #include <kth/domain/machine/operation.hpp>
 #include <kth/domain/machine/program.hpp>
 #include <kth/domain/machine/rule_fork.hpp>
+#include <kth/domain/machine/script_number.hpp>
+#include <kth/domain/machine/signature_cache.hpp>
+#include <kth/domain/machine/stack_element.hpp>
 
+#include <kth/domain/math/merkle.hpp>
+#include <kth/domain/math/sha256.hpp>
+#include <kth/domain/math/sip_hash.hpp>
 #include <kth/domain/math/stealth.hpp>
 
 #include <kth/domain/message/address.hpp>
@@ -45,6 +62,7 @@
 #include <kth/domain/message/block.hpp>
 #include <kth/domain/message/block_transactions.hpp>
 #include <kth/domain/message/compact_block.hpp>
+#include <kth/domain/message/compact_block_reconstructor.hpp>
 #include <kth/domain/message/double_spend_proof.hpp>
 #include <kth/domain/message/fee_filter.hpp>
 #include <kth/domain/message/filter_add.hpp>
@@ -0,0 +1,114 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_ABLA_SCHEDULE_HPP
+#define KTH_DOMAIN_CHAIN_ABLA_SCHEDULE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <kth/domain/chain/abla.hpp>
+#include <kth/domain/define.hpp>
+#include <kth/domain/deserialization.hpp>
+
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain::chain::abla {
+
+/// The ABLA states of a range of heights, from an anchor state. The block
+/// sizes of the range are kept with a snapshot of the state every interval
+/// heights, so the state of any height is replayed from its nearest snapshot
+/// (at most interval - 1 steps) instead of from the anchor, and a reorg
+/// truncates the range without replaying it.
+/// Each state depends on the previous one, so the range is advanced one
+/// height at a time, but without reallocating per height.
+/// The serialization holds the block sizes and the snapshots, loading it
+/// replays the block sizes once to verify every snapshot.
+class KD_API schedule {
+public:
+    static constexpr size_t default_interval = 1000;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    /// The anchor state holds the size of the block at the anchor height.
+    schedule(config const& cfg, size_t anchor_height, state const& anchor_state, size_t interval = default_interval);
+
+    // Deserialization.
+    //-------------------------------------------------------------------------
+
+    static
+    expect<schedule> from_data(byte_reader& reader);
+
+    // Serialization.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    data_chunk to_data() const;
+
+    /// Appends the encoding.
+    void to_data(data_chunk& out) const;
+
+    [[nodiscard]]
+    size_t serialized_size() const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    config const& configuration() const;
+
+    [[nodiscard]]
+    size_t interval() const;
+
+    [[nodiscard]]
+    size_t anchor_height() const;
+
+    [[nodiscard]]
+    size_t top_height() const;
+
+    [[nodiscard]]
+    state const& top() const;
+
+    /// The state of the height, nullopt if it is out of the range.
+    [[nodiscard]]
+    std::optional<state> at(size_t height) const;
+
+    /// The block size limit of the height, nullopt if it is out of the range.
+    [[nodiscard]]
+    std::optional<uint64_t> block_size_limit(size_t height) const;
+
+    // Modifiers.
+    //-------------------------------------------------------------------------
+
+    /// Appends the block of the next height, false (and nothing appended)
+    /// if its state overflows.
+    bool push(uint64_t block_size);
+
+    /// Appends the blocks of the next heights in order, the number appended
+    /// is less than the count only if a state overflows.
+    size_t push(std::span<uint64_t const> block_sizes);
+
+    /// Drops the heights above the height (a reorg), which must be in range.
+    void truncate(size_t height);
+
+private:
+    config config_;
+    size_t interval_;
+    size_t anchor_height_;
+    state top_;
+
+    // The size of the block of each height above the anchor.
+    std::vector<uint64_t> block_sizes_;
+
+    // The state of the anchor height and of every interval heights above it.
+    std::vector<state> snapshots_;
+};
+
+} // namespace kth::domain::chain::abla
+
+#endif // KTH_DOMAIN_CHAIN_ABLA_SCHEDULE_HPP
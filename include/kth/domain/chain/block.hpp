@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 #include <kth/domain/concepts.hpp>
 #include <kth/domain/constants.hpp>
 #include <kth/domain/define.hpp>
+#include <kth/domain/utility/atomic_cache.hpp>
 
 #include <kth/infrastructure/error.hpp>
 #include <kth/infrastructure/math/hash.hpp>
@@ -79,17 +81,20 @@ public:
         : block_basis(std::move(basis))
     {}
 
-    //Note(kth): cannot be defaulted because of the mutex data member.
-    block(block const& x);
-    block(block&& x) noexcept;
+    block(block const& x) = default;
+    block(block&& x) noexcept = default;
     /// This class is move assignable and copy assignable.
-    block& operator=(block const& x);
-    block& operator=(block&& x) noexcept;
+    block& operator=(block const& x) = default;
+    block& operator=(block&& x) noexcept = default;
 
     // Deserialization.
     //-------------------------------------------------------------------------
+    /// The transaction, input and output lists and the script bytes are all
+    /// allocated from the resource, so a whole block can be built into one
+    /// monotonic buffer and released at once. The resource must outlive the
+    /// block and anything moved out of it, copies use the default resource.
     static
-    expect<block> from_data(byte_reader& reader, bool wire = true);
+    expect<block> from_data(byte_reader& reader, bool wire = true, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Serialization.
     //-------------------------------------------------------------------------
@@ -144,23 +149,19 @@ public:
 
     size_t total_inputs(bool with_coinbase = true) const;
 
-    code check() const;
+    /// Zero threads means one per hardware thread (see block_basis::check).
+    code check(size_t threads = 1) const;
     code accept(bool transactions = true) const;
     code accept(chain_state const& state, bool transactions = true) const;
     code connect() const;
+    code connect(verification_pool& pool) const;
 
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
     mutable validation_t validation{};
 
 private:
-    mutable std::optional<size_t> total_inputs_;
-    mutable std::optional<size_t> base_size_;   // total size
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-#else
-    mutable shared_mutex mutex_;
-#endif
+    mutable atomic_cache<size_t> total_inputs_;
+    mutable atomic_cache<size_t> base_size_;   // total size
 };
 
 } // namespace kth::domain::chain
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -35,6 +36,8 @@ namespace kth::domain::chain {
 
 using indexes = std::vector<size_t>;
 
+class verification_pool;
+
 class KD_API block_basis {
 public:
     using list = std::vector<block_basis>;
@@ -55,7 +58,7 @@ public:
     //-------------------------------------------------------------------------
 
     static
-    expect<block_basis> from_data(byte_reader& reader, bool /*wire*/);
+    expect<block_basis> from_data(byte_reader& reader, bool /*wire*/, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     [[nodiscard]]
     bool is_valid() const;
@@ -80,7 +83,12 @@ public:
     }
 
     [[nodiscard]]
-    hash_list to_hashes() const;
+    hash_list to_hashes(size_t threads = 1) const;
+
+    /// Computes and caches the hash of every transaction not yet hashed.
+    /// Transactions are serialized into contiguous arenas and hashed in
+    /// multi-buffer batches, split across threads for large blocks.
+    void hash_transactions(size_t threads = 1) const;
 
     // Properties (size, accessors, cache).
     //-------------------------------------------------------------------------
@@ -126,8 +134,9 @@ public:
     [[nodiscard]]
     uint256_t proof() const;
 
+    /// With threads > 1 the lower levels of large trees are hashed concurrently.
     [[nodiscard]]
-    hash_digest generate_merkle_root() const;
+    hash_digest generate_merkle_root(size_t threads = 1) const;
 
     [[nodiscard]]
     size_t signature_operations(bool bip16, bool bip141) const;
@@ -157,10 +166,12 @@ public:
     bool is_internal_double_spend() const;
 
     [[nodiscard]]
-    bool is_valid_merkle_root() const;
+    bool is_valid_merkle_root(size_t threads = 1) const;
 
+    /// The txids and the merkle root of large blocks are computed across the
+    /// threads, zero threads means one per hardware thread.
     [[nodiscard]]
-    code check(size_t serialized_size_false) const;
+    code check(size_t serialized_size_false, size_t threads = 1) const;
 
     [[nodiscard]]
     code check_transactions() const;
@@ -174,9 +185,15 @@ public:
     [[nodiscard]]
     code connect(chain_state const& state) const;
 
+    [[nodiscard]]
+    code connect(chain_state const& state, verification_pool& pool) const;
+
     [[nodiscard]]
     code connect_transactions(chain_state const& state) const;
 
+    [[nodiscard]]
+    code connect_transactions(chain_state const& state, verification_pool& pool) const;
+
 // protected:
     void reset();
 
@@ -0,0 +1,250 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_BLOCK_VIEW_HPP
+#define KTH_DOMAIN_CHAIN_BLOCK_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include <kth/domain/chain/block.hpp>
+#include <kth/domain/chain/header.hpp>
+#include <kth/domain/chain/output_point.hpp>
+#include <kth/domain/chain/transaction.hpp>
+#include <kth/domain/define.hpp>
+
+#include <kth/infrastructure/error.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain::chain {
+
+class block_view;
+
+/// An input of a transaction in a block_view, borrowed from the wire bytes.
+class KD_API input_view {
+public:
+    input_view(block_view const& block, size_t index);
+
+    [[nodiscard]]
+    output_point previous_output() const;
+
+    /// The script bytes, without the size prefix.
+    [[nodiscard]]
+    byte_span script() const;
+
+    [[nodiscard]]
+    uint32_t sequence() const;
+
+    /// The wire serialization of the input.
+    [[nodiscard]]
+    byte_span data() const;
+
+private:
+    block_view const* block_;
+    size_t index_;
+};
+
+/// An output of a transaction in a block_view, borrowed from the wire bytes.
+class KD_API output_view {
+public:
+    output_view(block_view const& block, size_t index);
+
+    [[nodiscard]]
+    uint64_t value() const;
+
+    [[nodiscard]]
+    bool has_token_data() const;
+
+    /// The token data encoding, without the prefix byte, empty if none.
+    [[nodiscard]]
+    byte_span token_data() const;
+
+    /// The locking script bytes, without the size prefix and token data.
+    [[nodiscard]]
+    byte_span script() const;
+
+    /// The wire serialization of the output.
+    [[nodiscard]]
+    byte_span data() const;
+
+private:
+    block_view const* block_;
+    size_t index_;
+};
+
+/// A transaction of a block_view, borrowed from the wire bytes.
+class KD_API transaction_view {
+public:
+    transaction_view(block_view const& block, size_t index);
+
+    [[nodiscard]]
+    uint32_t version() const;
+
+    [[nodiscard]]
+    uint32_t locktime() const;
+
+    [[nodiscard]]
+    size_t input_count() const;
+
+    [[nodiscard]]
+    input_view input_at(size_t index) const;
+
+    [[nodiscard]]
+    size_t output_count() const;
+
+    [[nodiscard]]
+    output_view output_at(size_t index) const;
+
+    /// The wire serialization of the transaction.
+    [[nodiscard]]
+    byte_span data() const;
+
+    /// The txid, hashed directly from the wire bytes.
+    [[nodiscard]]
+    hash_digest hash() const;
+
+    [[nodiscard]]
+    bool is_coinbase() const;
+
+    [[nodiscard]]
+    bool is_null_non_coinbase() const;
+
+    [[nodiscard]]
+    bool is_oversized_coinbase() const;
+
+    /// Overflow returns max_uint64.
+    [[nodiscard]]
+    uint64_t total_output_value() const;
+
+    /// Same result as transaction::check(max_block_size, false, retarget).
+    [[nodiscard]]
+    code check(bool retarget = true) const;
+
+    [[nodiscard]]
+    expect<transaction> to_transaction(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+private:
+    block_view const* block_;
+    size_t index_;
+};
+
+/// A wire serialized block, parsed into offsets of its transactions, inputs,
+/// outputs and scripts without copying any of them. Only the header is
+/// materialized. Hashes are computed directly from the wire bytes.
+/// The buffer is borrowed: it must outlive the view and must not be modified.
+/// Immutable after construction, safe for concurrent use without locking.
+class KD_API block_view {
+public:
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    block_view() = default;
+
+    // Deserialization.
+    //-------------------------------------------------------------------------
+
+    /// Bytes beyond the end of the block are ignored.
+    static
+    expect<block_view> from_data(byte_span data);
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    /// The wire serialization of the block.
+    [[nodiscard]]
+    byte_span data() const;
+
+    [[nodiscard]]
+    chain::header const& header() const;
+
+    [[nodiscard]]
+    hash_digest hash() const;
+
+    [[nodiscard]]
+    size_t transaction_count() const;
+
+    [[nodiscard]]
+    transaction_view transaction_at(size_t index) const;
+
+    /// Every txid, hashed from the wire bytes in multi-buffer batches, split
+    /// across threads for large blocks. Computed on every call.
+    [[nodiscard]]
+    hash_list transaction_hashes(size_t threads = 1) const;
+
+    // Validation.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    hash_digest generate_merkle_root(size_t threads = 1) const;
+
+    [[nodiscard]]
+    bool is_valid_merkle_root(size_t threads = 1) const;
+
+    [[nodiscard]]
+    bool is_extra_coinbases() const;
+
+    [[nodiscard]]
+    bool is_internal_double_spend() const;
+
+    /// Same result as block::check(size) with the wire size of the block,
+    /// without materializing it. Zero threads means one per hardware thread.
+    [[nodiscard]]
+    code check(size_t threads = 1) const;
+
+    // Materialization.
+    //-------------------------------------------------------------------------
+
+    /// The block is allocated from the resource (see block::from_data).
+    [[nodiscard]]
+    expect<block> to_block(std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+    /// The hashes (as from transaction_hashes) are cached in the transactions.
+    [[nodiscard]]
+    expect<block> to_block(hash_list const& transaction_hashes, std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+
+private:
+    friend class transaction_view;
+    friend class input_view;
+    friend class output_view;
+
+    struct transaction_entry {
+        uint32_t offset;
+        uint32_t size;
+        uint32_t first_input;
+        uint32_t inputs;
+        uint32_t first_output;
+        uint32_t outputs;
+    };
+
+    struct input_entry {
+        uint32_t offset;
+        uint32_t script_offset;
+        uint32_t script_size;
+    };
+
+    struct output_entry {
+        uint32_t offset;
+        uint32_t token_offset;
+        uint32_t token_size;
+        uint32_t script_offset;
+        uint32_t script_size;
+    };
+
+    expect<void> parse_transaction(byte_reader& reader);
+    uint32_t offset_of(byte_span bytes) const;
+    byte_span slice(uint32_t offset, uint32_t size) const;
+
+    byte_span data_;
+    chain::header header_;
+    std::vector<transaction_entry> transactions_;
+    std::vector<input_entry> inputs_;
+    std::vector<output_entry> outputs_;
+};
+
+} // namespace kth::domain::chain
+
+#endif // KTH_DOMAIN_CHAIN_BLOCK_VIEW_HPP
@@ -7,14 +7,15 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <memory>
+#include <optional>
 
 #include <kth/domain/chain/abla.hpp>
 #include <kth/domain/constants.hpp>
 #include <kth/domain/define.hpp>
 #include <kth/domain/machine/opcode.hpp>
 #include <kth/domain/machine/rule_fork.hpp>
+#include <kth/domain/utility/shared_window.hpp>
 #include <kth/infrastructure/config/checkpoint.hpp>
 #include <kth/infrastructure/math/hash.hpp>
 
@@ -26,9 +27,10 @@ class header;
 
 class KD_API chain_state {
 public:
-    using bitss = std::deque<uint32_t>;                 //TODO(fernando): why deque?
-    using versions = std::deque<uint32_t>;              //TODO(fernando): why deque?
-    using timestamps = std::deque<uint32_t>;            //TODO(fernando): why deque?
+    // The histories of a state are shared with the states derived from it.
+    using bitss = shared_window<uint32_t>;
+    using versions = shared_window<uint32_t>;
+    using timestamps = shared_window<uint32_t>;
     using range = struct {size_t count; size_t high;};
     using ptr = std::shared_ptr<chain_state>;
     using checkpoints = infrastructure::config::checkpoint::list;
@@ -154,6 +156,29 @@ public:
     static
     std::shared_ptr<chain_state> from_pool_ptr(chain_state const& pool, block const& block);
 
+    static
+    std::shared_ptr<chain_state> from_pool_ptr(chain_state const& pool, header const& header);
+
+    /// The memory pool state of the next height, promoted from the state of
+    /// the top block without querying the store: the top values are pushed
+    /// into the shared histories. Null if the next height requires history
+    /// that the top state does not hold (testnet minimum difficulty blocks
+    /// after a retarget height), the state must then be populated.
+    static
+    std::shared_ptr<chain_state> from_top_ptr(chain_state const& top
+#if defined(KTH_CURRENCY_BCH)
+        , abla::state const& abla_state
+#endif
+    );
+
+#if defined(KTH_CURRENCY_BCH)
+    /// As from_top_ptr, for the contextual checks of headers only: the ABLA
+    /// state of the next height is not known, it is left default (zero), so
+    /// the state must not be used to check blocks.
+    static
+    std::shared_ptr<chain_state> from_top_ptr(chain_state const& top);
+#endif
+
     /// Checkpoints must be ordered by height with greatest at back.
     static
     map get_map(size_t height, checkpoints const& checkpoints, uint32_t forks, domain::config::network network);
@@ -439,8 +464,15 @@ public:
     // ------------------------------------------------------------------------
 
 private:
+    // A state with the configuration of base, the median time past and the
+    // work required are computed unless they are known.
+    chain_state(chain_state const& base, data&& values, std::optional<uint32_t> known_median_time_past, std::optional<uint32_t> known_work_required);
+
+    static
+    data to_block(chain_state const& pool, header const& header);
+
     static
-    data to_block(chain_state const& pool, block const& block);
+    std::optional<data> to_pool(chain_state const& top);
 
     static
     uint32_t work_required_retarget(data const& values);
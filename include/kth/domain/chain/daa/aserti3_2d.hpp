@@ -59,6 +59,7 @@ uint256_t shift_2way_safe(uint256_t x, int64_t n, uint256_t const& def) noexcept
 
 } // namespace
 
+inline
 uint256_t aserti3_2d(uint256_t const& anchor_target,
                      uint32_t target_spacing_seconds,
                      int64_t time_diff,
@@ -5,7 +5,9 @@
 #ifndef KTH_DOMAIN_CHAIN_HASH_MEMOIZER_HPP
 #define KTH_DOMAIN_CHAIN_HASH_MEMOIZER_HPP
 
-#include <kth/infrastructure/utility/thread.hpp>
+#include <kth/domain/utility/atomic_cache.hpp>
+
+#include <kth/infrastructure/math/hash.hpp>
 
 namespace kth::domain::chain {
 
@@ -13,54 +15,28 @@ template <typename T>
 class hash_memoizer {
 public:
     hash_digest hash() const {
-#if ! defined(__EMSCRIPTEN__)
-        ///////////////////////////////////////////////////////////////////////////
-        // Critical Section
-        mutex_.lock_upgrade();
-
-        if ( ! hash_) {
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            mutex_.unlock_upgrade_and_lock();
-            hash_ = std::make_shared<hash_digest>(bitcoin_hash(derived().to_data()));
-            mutex_.unlock_and_lock_upgrade();
-            //---------------------------------------------------------------------
-        }
-        auto const hash = *hash_;
-        mutex_.unlock_upgrade();
-        ///////////////////////////////////////////////////////////////////////////
-        return hash;
-#else
-        return bitcoin_hash(derived().to_data());
-#endif
+        return hash_.get([this] { return bitcoin_hash(derived().to_data()); });
     }
 
-    void invalidate() const {
-#if ! defined(__EMSCRIPTEN__)
-        ///////////////////////////////////////////////////////////////////////////
-        // Critical Section
-        mutex_.lock_upgrade();
+    [[nodiscard]]
+    bool is_hash_cached() const {
+        return hash_.has_value();
+    }
 
-        if (hash_) {
-            mutex_.unlock_upgrade_and_lock();
-            //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-            hash_.reset();
-            //---------------------------------------------------------------------
-            mutex_.unlock_and_lock_upgrade();
-        }
+    /// Publishes a hash computed elsewhere, such as in a batch.
+    void cache_hash(hash_digest const& hash) const {
+        hash_.publish(hash);
+    }
 
-        mutex_.unlock_upgrade();
-        ///////////////////////////////////////////////////////////////////////////
-#endif
+    void invalidate() const {
+        hash_.reset();
     }
 
 private:
     T& derived() {return *static_cast<T*>(this);}
     T const& derived() const {return *static_cast<T const*>(this);}
 
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-    mutable std::shared_ptr<hash_digest> hash_;
-#endif
+    mutable atomic_cache<hash_digest> hash_;
 };
 
 } // namespace kth::domain::chain
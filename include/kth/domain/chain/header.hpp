@@ -53,10 +53,11 @@ public:
         : header_basis(basis)
     {}
 
-    /// This class is copy constructible and copy assignable.
-    // Note(kth): Cannot be defaulted because the std::mutex data member.
-    header(header const& x);
-    header& operator=(header const& x);
+    /// This class is move/copy constructible and move/copy assignable.
+    header(header const& x) = default;
+    header(header&& x) noexcept = default;
+    header& operator=(header const& x) = default;
+    header& operator=(header&& x) noexcept = default;
 
 
     // Deserialization.
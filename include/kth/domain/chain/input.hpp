@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 #if defined(__EMSCRIPTEN__)
@@ -35,7 +36,9 @@ namespace kth::domain::chain {
 
 class KD_API input : public input_basis {
 public:
-    using list = std::vector<input>;
+    /// A pmr vector so that a block deserializes into one memory resource,
+    /// copies of a list still allocate from the default resource.
+    using list = std::pmr::vector<input>;
 
     // Constructors.
     //-------------------------------------------------------------------------
@@ -60,7 +63,7 @@ public:
     //-------------------------------------------------------------------------
 
     static
-    expect<input> from_data(byte_reader& reader, bool wire);
+    expect<input> from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Properties (size, accessors, cache).
     //-------------------------------------------------------------------------
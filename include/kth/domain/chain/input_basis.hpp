@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 #include <kth/domain/chain/output_point.hpp>
@@ -54,7 +55,7 @@ public:
     //-------------------------------------------------------------------------
 
     static
-    expect<input_basis> from_data(byte_reader& reader, bool wire);
+    expect<input_basis> from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     [[nodiscard]]
     bool is_valid() const;
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -27,7 +28,8 @@
 namespace kth::domain::chain {
 class KD_API output : public output_basis {
 public:
-    using list = std::vector<output>;
+    /// A pmr vector, as input::list.
+    using list = std::pmr::vector<output>;
 
     /// This is a sentinel used in .value to indicate not found in store.
     /// This is a sentinel used in cache.value to indicate not populated.
@@ -67,7 +69,7 @@ public:
 
 
     static
-    expect<output> from_data(byte_reader& reader, bool wire = true);
+    expect<output> from_data(byte_reader& reader, bool wire = true, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Serialization.
     //-------------------------------------------------------------------------
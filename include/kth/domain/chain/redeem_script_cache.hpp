@@ -0,0 +1,69 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_REDEEM_SCRIPT_CACHE_HPP
+#define KTH_DOMAIN_CHAIN_REDEEM_SCRIPT_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <kth/domain/chain/script.hpp>
+#include <kth/domain/define.hpp>
+#include <kth/domain/machine/bytecode.hpp>
+
+#include <kth/infrastructure/hash_define.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain::chain {
+
+/// Parsed and compiled p2sh redeem scripts, keyed by the script hash of the
+/// prevout (hash160 or hash256, as committed by the output). Spends of many
+/// outputs of the same template (multisig consolidations) parse and compile
+/// the redeem script once.
+/// A hit also requires the same redeem script bytes and forks, so a key
+/// collision can only cost a recompilation.
+/// Not thread safe, intended for one verifying thread (see
+/// verification_context). Cleared when full.
+class KD_API redeem_script_cache {
+public:
+    struct entry {
+        entry(data_chunk&& bytes, uint32_t forks);
+
+        chain::script redeem;
+        machine::bytecode compiled;
+        uint32_t forks;
+    };
+
+    explicit
+    redeem_script_cache(size_t capacity = 1024);
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    size_t size() const;
+
+    [[nodiscard]]
+    size_t capacity() const;
+
+    // Cache.
+    //-------------------------------------------------------------------------
+
+    /// The entry of the redeem script bytes, committed by the prevout script
+    /// hash (20 or 32 bytes). Valid until the next call or clear().
+    entry const& get(byte_span script_hash, byte_span redeem, uint32_t forks);
+
+    void clear();
+
+private:
+    size_t capacity_;
+    boost::unordered_flat_map<hash_digest, std::unique_ptr<entry>> entries_;
+};
+
+} // namespace kth::domain::chain
+
+#endif // KTH_DOMAIN_CHAIN_REDEEM_SCRIPT_CACHE_HPP
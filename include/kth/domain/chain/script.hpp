@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <type_traits>
 
@@ -36,6 +37,7 @@
 #include <kth/domain/concepts.hpp>
 namespace kth::domain::chain {
 
+class sighash_context;
 class transaction;
 class witness;
 
@@ -87,10 +89,10 @@ public:
     //-------------------------------------------------------------------------
 
     static
-    expect<script> from_data(byte_reader& reader, bool wire);
+    expect<script> from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     static
-    expect<script> from_data_with_size(byte_reader& reader, size_t size);
+    expect<script> from_data_with_size(byte_reader& reader, size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /// Deserialization invalidates the iterator.
     void from_operations(operation::list&& ops);
@@ -128,6 +130,8 @@ public:
     // Signing.
     //-------------------------------------------------------------------------
 
+    /// A context built from tx, when provided, supplies the shared parts of
+    /// the version 0 preimage instead of recomputing them for each call.
     static
     std::pair<hash_digest, size_t> generate_signature_hash(transaction const& tx,
                                         uint32_t input_index,
@@ -137,12 +141,13 @@ public:
 #if ! defined(KTH_CURRENCY_BCH)
                                         script_version version = script_version::unversioned,
 #endif // ! KTH_CURRENCY_BCH
-                                        uint64_t value = max_uint64);
+                                        uint64_t value = max_uint64,
+                                        sighash_context const* context = nullptr);
 
     static
     std::pair<bool, size_t> check_signature(ec_signature const& signature,
                             uint8_t sighash_type,
-                            data_chunk const& public_key,
+                            byte_span public_key,
                             script const& script_code,
                             transaction const& tx,
                             uint32_t input_index,
@@ -150,7 +155,8 @@ public:
 #if ! defined(KTH_CURRENCY_BCH)
                             script_version version = script_version::unversioned,
 #endif // ! KTH_CURRENCY_BCH
-                            uint64_t value = max_uint64);
+                            uint64_t value = max_uint64,
+                            sighash_context const* context = nullptr);
 
     // static
     // bool create_endorsement(endorsement& out, ec_secret const& secret, script const& prevout_script, transaction const& tx, uint32_t input_index, uint8_t sighash_type, script_version version = script_version::unversioned, uint64_t value = max_uint64);
@@ -167,7 +173,8 @@ public:
         script_version version = script_version::unversioned,
 #endif // ! KTH_CURRENCY_BCH
         uint64_t value = max_uint64,
-        endorsement_type type = endorsement_type::ecdsa);
+        endorsement_type type = endorsement_type::ecdsa,
+        sighash_context const* context = nullptr);
 
 
     // Utilities (static).
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <string>
 #include <type_traits>
 
@@ -63,10 +64,10 @@ public:
     //-------------------------------------------------------------------------
 
     static
-    expect<script_basis> from_data(byte_reader& reader, bool prefix);
+    expect<script_basis> from_data(byte_reader& reader, bool prefix, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     static
-    expect<script_basis> from_data_with_size(byte_reader& reader, size_t size);
+    expect<script_basis> from_data_with_size(byte_reader& reader, size_t size, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /// Deserialization invalidates the iterator.
     void from_operations(operation::list const& ops);
@@ -90,7 +91,8 @@ public:
             sink.write_variable_little_endian(serialized_size(false));
         }
 
-        sink.write_bytes(bytes_);
+        auto const data = bytes();
+        sink.write_bytes(data.data(), data.size());
     }
 
     [[nodiscard]]
@@ -103,8 +105,9 @@ public:
     [[nodiscard]]
     size_t serialized_size(bool prefix) const;
 
+    /// The unprefixed script bytes, valid while the script is unchanged.
     [[nodiscard]]
-    data_chunk const& bytes() const;
+    byte_span bytes() const;
     // operation::list const& operations() const;
 
     // Utilities (static).
@@ -223,6 +226,10 @@ public:
     static
     size_t serialized_size(operation::list const& ops);
 protected:
+    /// Takes unprefixed script bytes, keeping their allocator.
+    explicit
+    script_basis(std::pmr::vector<uint8_t>&& bytes);
+
     static
     data_chunk operations_to_data(operation::list const& ops);
 
@@ -239,7 +246,12 @@ protected:
         uint32_t active_forks
     );
 
-    data_chunk bytes_;
+    /// Allocated from the resource given to from_data, copies use the default.
+    std::pmr::vector<uint8_t> bytes_;
+
+    /// The bytes of a script built from a moved chunk or from operations,
+    /// taken without a copy. At most one of chunk_ and bytes_ is not empty.
+    data_chunk chunk_;
     bool valid_{false};
 };
 
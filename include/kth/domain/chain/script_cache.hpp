@@ -0,0 +1,52 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_SCRIPT_CACHE_HPP
+#define KTH_DOMAIN_CHAIN_SCRIPT_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <kth/domain/define.hpp>
+#include <kth/domain/math/sha256.hpp>
+#include <kth/domain/utility/cuckoo_cache.hpp>
+
+#include <kth/infrastructure/hash_define.hpp>
+
+namespace kth::domain::chain {
+
+class transaction;
+
+/// The set of transactions whose input scripts all verified, each under the
+/// outputs it spent and the forks it was verified with, so that transactions
+/// connected for the mempool are not interpreted again when their block is
+/// connected.
+/// The forks are part of the entry: once they change at an upgrade height the
+/// entries of the previous forks no longer match and are evicted in time.
+/// Entries are salted sha256 digests, the salt is random per cache.
+/// Thread safe.
+class KD_API script_cache : public cuckoo_cache {
+public:
+    static constexpr size_t default_memory = 8 * 1024 * 1024;
+
+    explicit
+    script_cache(size_t memory = default_memory, size_t shards = 16);
+
+    /// The cache consulted by transaction::connect and verification_pool.
+    static
+    script_cache& global();
+
+    /// The salted entry of the transaction hash, its previous outputs and the
+    /// forks. The entry of a transaction with a missing previous output is
+    /// never inserted, since its connection fails.
+    [[nodiscard]]
+    hash_digest entry(transaction const& tx, uint32_t forks) const;
+
+private:
+    sha256_context salted_;
+};
+
+} // namespace kth::domain::chain
+
+#endif // KTH_DOMAIN_CHAIN_SCRIPT_CACHE_HPP
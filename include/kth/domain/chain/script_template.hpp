@@ -0,0 +1,55 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_SCRIPT_TEMPLATE_HPP
+#define KTH_DOMAIN_CHAIN_SCRIPT_TEMPLATE_HPP
+
+#include <cstddef>
+
+#include <kth/domain/define.hpp>
+
+#include <kth/infrastructure/machine/script_pattern.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+// Output template matchers over serialized (unprefixed) script bytes.
+// Same results as the operation::list patterns of script, without parsing
+// the script into operations: nothing is allocated.
+namespace kth::domain::chain::script_template {
+
+using script_pattern = infrastructure::machine::script_pattern;
+
+/// [dup hash160 [20] equalverify checksig]
+KD_API bool is_pay_public_key_hash(byte_span script);
+
+/// [hash160 [20] equal], consensus (bip16).
+KD_API bool is_pay_script_hash(byte_span script);
+
+/// [hash256 [32] equal], consensus.
+KD_API bool is_pay_script_hash_32(byte_span script);
+
+/// [[public key] checksig]
+KD_API bool is_pay_public_key(byte_span script);
+
+/// [m [public key]... n checkmultisig], 1 <= m <= n <= 16.
+KD_API bool is_pay_multisig(byte_span script);
+
+/// [return [minimal push of up to max_null_data_size bytes]]
+KD_API bool is_null_data(byte_span script);
+
+/// Same result as script::output_pattern.
+KD_API script_pattern output_pattern(byte_span script);
+
+/// The hash of a pay_public_key_hash, pay_script_hash or pay_script_hash_32
+/// script, the key of a pay_public_key script, empty for other patterns.
+KD_API byte_span output_payload(byte_span script, script_pattern pattern);
+
+/// Same result as script::sigops.
+KD_API size_t sigops(byte_span script, bool accurate);
+
+/// Same result as script::is_unspendable.
+KD_API bool is_unspendable(byte_span script);
+
+} // namespace kth::domain::chain::script_template
+
+#endif // KTH_DOMAIN_CHAIN_SCRIPT_TEMPLATE_HPP
@@ -0,0 +1,84 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_SIGHASH_CONTEXT_HPP
+#define KTH_DOMAIN_CHAIN_SIGHASH_CONTEXT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <kth/domain/chain/script_basis.hpp>
+#include <kth/domain/chain/transaction.hpp>
+#include <kth/domain/define.hpp>
+#include <kth/domain/math/sha256.hpp>
+
+#include <kth/infrastructure/hash_define.hpp>
+
+namespace kth::domain::chain {
+
+/// The per transaction components of the version 0 (bip143/forkid) signature
+/// hash, computed once and shared by all inputs.
+/// Holds the inpoints, sequences, outputs and utxos hashes plus the sha256
+/// midstates of every distinct preimage prefix, so hashing an input only
+/// covers the bytes that are specific to it.
+/// Immutable after construction, safe for concurrent use without locking.
+/// The transaction must outlive the context and must not be modified.
+class KD_API sighash_context {
+public:
+    /// The utxos hash is only computed when bch_descartes is active.
+    sighash_context(transaction const& tx, uint32_t active_forks);
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    transaction const& tx() const;
+
+    [[nodiscard]]
+    uint32_t active_forks() const;
+
+    [[nodiscard]]
+    hash_digest const& inpoints_hash() const;
+
+    [[nodiscard]]
+    hash_digest const& sequences_hash() const;
+
+    [[nodiscard]]
+    hash_digest const& outputs_hash() const;
+
+    /// null_hash unless bch_descartes is active.
+    [[nodiscard]]
+    hash_digest const& utxos_hash() const;
+
+    // Signing.
+    //-------------------------------------------------------------------------
+
+    /// Same result as script::generate_version_0_signature_hash.
+    [[nodiscard]]
+    std::pair<hash_digest, size_t> signature_hash(uint32_t input_index, script_basis const& script_code, uint64_t value, uint8_t sighash_type) const;
+
+private:
+    static constexpr size_t any_flag = 1;
+    static constexpr size_t all_flag = 2;
+    static constexpr size_t utxos_flag = 4;
+
+    sha256_context const& prefix(bool any, bool all, bool utxos) const;
+
+    transaction const* tx_;
+    uint32_t active_forks_;
+    bool descartes_;
+    hash_digest inpoints_hash_;
+    hash_digest sequences_hash_;
+    hash_digest outputs_hash_;
+    hash_digest utxos_hash_;
+
+    // Midstates after version, inpoints, utxos and sequences (fields 1 to 4).
+    std::array<sha256_context, 8> prefixes_;
+};
+
+} // namespace kth::domain::chain
+
+#endif // KTH_DOMAIN_CHAIN_SIGHASH_CONTEXT_HPP
@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -24,6 +25,7 @@
 #include <kth/domain/define.hpp>
 #include <kth/domain/machine/opcode.hpp>
 #include <kth/domain/machine/rule_fork.hpp>
+#include <kth/domain/utility/atomic_cache.hpp>
 
 #include <kth/infrastructure/error.hpp>
 #include <kth/infrastructure/math/elliptic_curve.hpp>
@@ -45,11 +47,16 @@ namespace kth::domain::chain {
 
 using template_result = std::tuple<transaction, std::vector<uint32_t>, std::vector<wallet::payment_address>, std::vector<uint64_t>>;
 
+class sighash_context;
+class verification_context;
+class verification_pool;
+
 class KD_API transaction : public transaction_basis {
 public:
     using ins = input::list;
     using outs = output::list;
-    using list = std::vector<transaction>;
+    /// A pmr vector, as input::list.
+    using list = std::pmr::vector<transaction>;
     using hash_ptr = std::shared_ptr<hash_digest>;
 
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
@@ -92,18 +99,16 @@ public:
     // Special member functions.
     //-----------------------------------------------------------------------------
 
-
-    //Note(kth): cannot be defaulted because of the mutex data member.
-    transaction(transaction const& x);
-    transaction(transaction&& x) noexcept;
-    transaction& operator=(transaction const& x);
-    transaction& operator=(transaction&& x) noexcept;
+    transaction(transaction const& x) = default;
+    transaction(transaction&& x) noexcept = default;
+    transaction& operator=(transaction const& x) = default;
+    transaction& operator=(transaction&& x) noexcept = default;
 
     // Deserialization.
     //-----------------------------------------------------------------------------
 
     static
-    expect<transaction> from_data(byte_reader& reader, bool wire);
+    expect<transaction> from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     // Serialization.
     //-----------------------------------------------------------------------------
@@ -137,6 +142,13 @@ public:
 
     hash_digest hash() const;
 
+    /// True if the hash is already computed.
+    bool is_hash_cached() const;
+
+    /// Caches a hash computed elsewhere (such as in a batch over a whole
+    /// block), unless one is already cached. Safe concurrently with hash().
+    void cache_hash(hash_digest const& hash) const;
+
     // Utilities.
     //-------------------------------------------------------------------------
 
@@ -164,7 +176,9 @@ public:
     code accept(chain_state const& state, bool transaction_pool = true) const;
     code connect() const;
     code connect(chain_state const& state) const;
+    code connect(chain_state const& state, verification_pool& pool) const;
     code connect_input(chain_state const& state, size_t input_index) const;
+    code connect_input(chain_state const& state, size_t input_index, sighash_context const& context) const;
 
 
     // THIS IS FOR LIBRARY USE ONLY, DO NOT CREATE A DEPENDENCY ON IT.
@@ -199,40 +213,32 @@ protected:
     bool all_inputs_final() const;
 
 private:
+    code connect_input(chain_state const& state, size_t input_index, sighash_context const* context) const;
+    void invalidate_input_cache() const;
+    void invalidate_output_cache() const;
 
     // TODO(kth): (refactor to transaction_result)
     // this 3 variables should be stored in transaction_unconfired database when the store
     // function is called. This values will be in the transaction_result object before
     // creating the transaction object
 
-    // These share a mutex as they are not expected to contend.
-    mutable hash_ptr hash_;
-    mutable hash_ptr outputs_hash_;
-    mutable hash_ptr inpoints_hash_;
-    mutable hash_ptr sequences_hash_;
-    mutable hash_ptr utxos_hash_;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex hash_mutex_;
-#else
-    mutable shared_mutex hash_mutex_;
-#endif
-
-    // These share a mutex as they are not expected to contend.
-    mutable std::optional<uint64_t> total_input_value_;
-    mutable std::optional<uint64_t> total_output_value_;
-    mutable std::optional<bool> segregated_;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutable upgrade_mutex mutex_;
-#else
-    mutable shared_mutex mutex_;
-#endif
+    // Computed once and published without locking, copies carry them along.
+    mutable atomic_cache<hash_digest> hash_;
+    mutable atomic_cache<hash_digest> outputs_hash_;
+    mutable atomic_cache<hash_digest> inpoints_hash_;
+    mutable atomic_cache<hash_digest> sequences_hash_;
+    mutable atomic_cache<hash_digest> utxos_hash_;
+    mutable atomic_cache<uint64_t> total_input_value_;
+    mutable atomic_cache<uint64_t> total_output_value_;
 };
 
 
-code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script const& input_script, script const& prevout_script, uint64_t /*value*/);
-code verify(transaction const& tx, uint32_t input, uint32_t forks);
+code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script const& input_script, script const& prevout_script, uint64_t /*value*/, sighash_context const* context = nullptr);
+
+/// As above, with the arena and redeem scripts of the given context, which
+/// is reset first. The other overloads use a context of the calling thread.
+code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script const& input_script, script const& prevout_script, uint64_t value, sighash_context const* context, verification_context& verification);
+code verify(transaction const& tx, uint32_t input, uint32_t forks, sighash_context const* context = nullptr);
 
 } // namespace kth::domain::chain
 
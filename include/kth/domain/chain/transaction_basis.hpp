@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <istream>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <string>
 #include <vector>
@@ -64,8 +65,8 @@ namespace detail {
 // }
 
 // Write a length-prefixed collection of inputs or outputs to the sink.
-template <class Sink, class Put>
-void write(Sink& sink, const std::vector<Put>& puts, bool wire) {
+template <class Sink, class Put, class Allocator>
+void write(Sink& sink, const std::vector<Put, Allocator>& puts, bool wire) {
     sink.write_variable_little_endian(puts.size());
 
     auto const serialize = [&](const Put& put) {
@@ -121,7 +122,7 @@ public:
     //-----------------------------------------------------------------------------
 
     static
-    expect<transaction_basis> from_data(byte_reader& reader, bool wire = true);
+    expect<transaction_basis> from_data(byte_reader& reader, bool wire = true, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     [[nodiscard]]
     bool is_valid() const;
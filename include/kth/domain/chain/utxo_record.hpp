@@ -0,0 +1,157 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_UTXO_RECORD_HPP
+#define KTH_DOMAIN_CHAIN_UTXO_RECORD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <kth/domain/chain/output.hpp>
+#include <kth/domain/chain/output_point.hpp>
+#include <kth/domain/chain/token_data.hpp>
+#include <kth/domain/chain/utxo.hpp>
+#include <kth/domain/define.hpp>
+#include <kth/domain/deserialization.hpp>
+
+#include <kth/infrastructure/math/hash.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain::chain {
+
+/// Amounts are stored with their trailing decimal zeros folded into the
+/// low digit, so round values fit in one or two varint bytes.
+KD_API uint64_t compress_amount(uint64_t amount);
+KD_API uint64_t decompress_amount(uint64_t compressed);
+
+/// An unspent output in its compressed storage form, usually 25 to 35 bytes
+/// for standard scripts:
+///
+///   varint  height << 2 | has token << 1 | coinbase
+///   varint  compress_amount(value)
+///   varint  script kind, followed by:
+///           0       p2pkh key hash (20 bytes)
+///           1       p2sh script hash (20 bytes)
+///           2, 3    p2pk key x coordinate (32 bytes), for key prefix 02, 03
+///           4       p2sh32 script hash (32 bytes)
+///           n >= 5  raw script (n - 5 bytes)
+///   [token data, in its output prefix encoding, without the prefix byte]
+///
+/// Varints are little endian base 128, not the wire compact size.
+struct KD_API utxo_record {
+    static constexpr size_t special_scripts = 5;
+
+    // Deserialization.
+    //-------------------------------------------------------------------------
+
+    static
+    expect<utxo_record> from_data(byte_reader& reader);
+
+    // Serialization.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    data_chunk to_data() const;
+
+    /// Appends the encoding.
+    void to_data(data_chunk& out) const;
+
+    [[nodiscard]]
+    size_t serialized_size() const;
+
+    // Utilities.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    utxo to_utxo(output_point const& point) const;
+
+    chain::output output;
+    uint32_t height = 0;
+    bool coinbase = false;
+};
+
+/// Fixed layout index entry of a utxo_table, 40 bytes, ordered by outpoint.
+/// The layout is native (little endian on supported hosts), so tables can be
+/// written out and memory mapped as is.
+struct utxo_key {
+    hash_digest hash;
+    uint32_t index;
+    uint32_t offset;
+};
+
+static_assert(sizeof(utxo_key) == 40);
+
+/// Read only lookups over the two flat arrays of a utxo_table, which may be
+/// owned by a table or mapped from storage. The memory is borrowed.
+class KD_API utxo_table_view {
+public:
+    utxo_table_view() = default;
+
+    /// The keys must be ordered, as left by utxo_table::sort.
+    utxo_table_view(std::span<utxo_key const> keys, byte_span records);
+
+    [[nodiscard]]
+    size_t size() const;
+
+    [[nodiscard]]
+    bool contains(output_point const& point) const;
+
+    /// The encoded record, up to the end of the records (records are self
+    /// delimiting), empty if not found.
+    [[nodiscard]]
+    byte_span find_data(output_point const& point) const;
+
+    [[nodiscard]]
+    std::optional<utxo_record> find(output_point const& point) const;
+
+private:
+    utxo_key const* lower_bound(output_point const& point) const;
+
+    std::span<utxo_key const> keys_;
+    byte_span records_;
+};
+
+/// A utxo set as two flat, pointer free arrays: fixed size keys and packed
+/// compressed records. Built by appending, then sorted once for lookups.
+/// Records are addressed with 32 bit offsets, larger sets must be sharded
+/// (for instance by the first byte of the outpoint hash).
+class KD_API utxo_table {
+public:
+    /// False, and nothing is added, if the records would exceed 4 GiB.
+    /// Outpoints must be unique.
+    bool insert(output_point const& point, utxo_record const& record);
+
+    /// Orders the keys, required before lookups after any insert.
+    void sort();
+
+    [[nodiscard]]
+    bool is_sorted() const;
+
+    [[nodiscard]]
+    size_t size() const;
+
+    [[nodiscard]]
+    std::span<utxo_key const> keys() const;
+
+    [[nodiscard]]
+    byte_span records() const;
+
+    [[nodiscard]]
+    utxo_table_view view() const;
+
+    [[nodiscard]]
+    std::optional<utxo_record> find(output_point const& point) const;
+
+private:
+    std::vector<utxo_key> keys_;
+    data_chunk records_;
+    bool sorted_ = true;
+};
+
+} // namespace kth::domain::chain
+
+#endif // KTH_DOMAIN_CHAIN_UTXO_RECORD_HPP
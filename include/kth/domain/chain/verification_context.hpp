@@ -0,0 +1,54 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_VERIFICATION_CONTEXT_HPP
+#define KTH_DOMAIN_CHAIN_VERIFICATION_CONTEXT_HPP
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include <kth/domain/chain/redeem_script_cache.hpp>
+#include <kth/domain/define.hpp>
+
+namespace kth::domain::chain {
+
+/// The reusable state of a thread verifying inputs one after another.
+/// The programs of an input (input, prevout and p2sh) allocate their stacks
+/// and large stack items from an arena owned by the context, which reset()
+/// rewinds for the next input, and p2sh redeem scripts are parsed once per
+/// context (see redeem_script_cache).
+/// Not thread safe, verify() keeps one per thread.
+class KD_API verification_context {
+public:
+    /// The arena starts with arena_size bytes, enough for the programs of
+    /// a typical input, and grows on demand until reset.
+    explicit
+    verification_context(size_t arena_size = default_arena_size, size_t redeem_scripts = 1024);
+
+    verification_context(verification_context const&) = delete;
+    verification_context& operator=(verification_context const&) = delete;
+
+    /// Rewinds the arena, the programs of the previous input must have been
+    /// destroyed.
+    void reset();
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    std::pmr::memory_resource* resource();
+    redeem_script_cache& redeem_scripts();
+
+private:
+    // The reserved stacks of three programs plus their items.
+    static constexpr size_t default_arena_size = 1024 * 1024;
+
+    std::vector<std::byte> buffer_;
+    std::pmr::monotonic_buffer_resource arena_;
+    redeem_script_cache redeem_scripts_;
+};
+
+} // namespace kth::domain::chain
+
+#endif // KTH_DOMAIN_CHAIN_VERIFICATION_CONTEXT_HPP
@@ -0,0 +1,121 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_CHAIN_VERIFICATION_POOL_HPP
+#define KTH_DOMAIN_CHAIN_VERIFICATION_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <kth/domain/chain/chain_state.hpp>
+#include <kth/domain/chain/sighash_context.hpp>
+#include <kth/domain/chain/transaction.hpp>
+#include <kth/domain/define.hpp>
+
+#include <kth/infrastructure/error.hpp>
+
+namespace kth::domain::chain {
+
+/// Verifies the input scripts of a transaction set across a fixed set of
+/// worker threads. Every (transaction, input) pair of the set is a job, each
+/// worker starts with a contiguous slice of the jobs and steals half of the
+/// largest remaining slice once its own is exhausted.
+/// The result is the code of the first failing input in serial order, so it
+/// is always the same code that the serial connect path returns.
+/// Transactions in the script cache are skipped, the others are added to it
+/// once the whole set verifies.
+/// Calls are serialized, the calling thread participates as a worker.
+class KD_API verification_pool {
+public:
+    /// Zero threads means one per hardware thread.
+    explicit
+    verification_pool(size_t threads = 0);
+
+    ~verification_pool();
+
+    verification_pool(verification_pool const&) = delete;
+    verification_pool& operator=(verification_pool const&) = delete;
+
+    /// The number of workers, including the calling thread.
+    [[nodiscard]]
+    size_t size() const;
+
+    /// The number of jobs (inputs) of the last connect, coinbase, validated
+    /// and cached transactions have none.
+    [[nodiscard]]
+    size_t jobs() const;
+
+    /// True if the jobs of the last connect ran on the workers, false if they
+    /// ran serially on the calling thread.
+    [[nodiscard]]
+    bool parallel() const;
+
+    /// Verify all inputs of the transaction (coinbase returns success).
+    [[nodiscard]]
+    code connect(transaction const& tx, chain_state const& state);
+
+    /// Verify all inputs of all transactions not marked as validated.
+    [[nodiscard]]
+    code connect(transaction::list const& txs, chain_state const& state);
+
+private:
+    struct job {
+        transaction const* tx;
+        sighash_context const* context;
+        uint32_t index;
+    };
+
+    // A slice of the job list, front is consumed by the owner, back is stolen.
+    struct slice {
+        std::mutex mutex;
+        size_t begin{0};
+        size_t end{0};
+    };
+
+    void add_jobs(transaction const& tx, uint32_t forks);
+    code run(chain_state const& state);
+    code finish(code ec);
+    code run_serial(chain_state const& state) const;
+    void loop(size_t worker);
+    void work(size_t worker);
+    bool next(size_t worker, size_t& out_job);
+    bool steal(size_t worker);
+    void fail(size_t job, code ec);
+
+    std::vector<std::thread> threads_;
+    std::vector<std::unique_ptr<slice>> slices_;
+    std::vector<job> jobs_;
+    std::vector<sighash_context> contexts_;
+
+    // The script cache entries of the transactions with jobs.
+    std::vector<hash_digest> entries_;
+
+    // Serializes connect calls.
+    std::mutex run_mutex_;
+
+    // Published to the workers for the duration of a run.
+    chain_state const* state_{nullptr};
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    size_t generation_{0};
+    size_t pending_{0};
+    bool stopped_{false};
+    bool parallel_{false};
+
+    // First failing job in serial order and its code.
+    std::atomic<size_t> failed_job_{0};
+    std::mutex failure_mutex_;
+    code failure_;
+};
+
+} // namespace kth::domain::chain
+
+#endif // KTH_DOMAIN_CHAIN_VERIFICATION_POOL_HPP
@@ -13,6 +13,9 @@
 // #include <string>
 // #include <vector>
 
+#include <memory_resource>
+#include <vector>
+
 #include <nonstd/expected.hpp>
 
 
@@ -99,6 +102,35 @@ expect<std::vector<T>> read_collection(byte_reader& reader, Args&&... args) {
     return list;
 }
 
+/// As read_collection, into a std::pmr::vector allocated from the resource.
+/// The resource is also passed on, as the last argument of T::from_data, so
+/// the elements allocate their own members from it as well.
+template <typename T, typename ... Args>
+    requires has_from_data<T, Args..., std::pmr::memory_resource*>
+expect<std::pmr::vector<T>> read_pmr_collection(byte_reader& reader, std::pmr::memory_resource* resource, Args&&... args) {
+    auto const count_exp = reader.read_size_little_endian();
+    if ( ! count_exp) {
+        return make_unexpected(count_exp.error());
+    }
+    auto const count = *count_exp;
+    if (count > static_absolute_max_block_size()) {
+        return make_unexpected(error::invalid_size);
+    }
+
+    std::pmr::vector<T> list(resource);
+    list.reserve(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto res = T::from_data(reader, std::forward<Args>(args)..., resource);
+        if ( ! res) {
+            return make_unexpected(res.error());
+        }
+        list.emplace_back(std::move(*res));
+    }
+
+    return list;
+}
+
 
 } // namespace kth
 
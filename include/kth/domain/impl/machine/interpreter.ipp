@@ -15,9 +15,12 @@
 #include <kth/domain/machine/operation.hpp>
 #include <kth/domain/machine/program.hpp>
 #include <kth/domain/machine/rule_fork.hpp>
+#include <kth/domain/machine/script_number.hpp>
+#include <kth/domain/math/sha256.hpp>
 #include <kth/infrastructure/error.hpp>
 #include <kth/infrastructure/machine/number.hpp>
 #include <kth/infrastructure/math/elliptic_curve.hpp>
+#include <kth/infrastructure/math/hash.hpp>
 #include <kth/infrastructure/utility/assert.hpp>
 #include <kth/infrastructure/utility/data.hpp>
 
@@ -71,6 +74,17 @@ interpreter::result interpreter::op_push_size(program& program, operation const&
     return error::success;
 }
 
+inline
+interpreter::result interpreter::op_push_size(program& program, bytecode::view const& op) {
+    if (op.data().size() > op_75) {
+        return error::op_push_size;
+    }
+
+    program.push_move(op.data());
+    program.get_metrics().add_op_cost(program.top().size());
+    return error::success;
+}
+
 // TODO: std::move the data chunk to the program
 inline
 interpreter::result interpreter::op_push_data(program& program, data_chunk const& data, uint32_t size_limit) {
@@ -83,6 +97,17 @@ interpreter::result interpreter::op_push_data(program& program, data_chunk const
     return error::success;
 }
 
+inline
+interpreter::result interpreter::op_push_data(program& program, byte_span data, uint32_t size_limit) {
+    if (data.size() > size_limit) {
+        return error::op_push_data;
+    }
+
+    program.push_move(data);
+    program.get_metrics().add_op_cost(program.top().size());
+    return error::success;
+}
+
 // Operations (not shared).
 //-----------------------------------------------------------------------------
 // All index parameters are zero-based and relative to stack top.
@@ -298,7 +323,7 @@ interpreter::result interpreter::op_if_dup(program& program) {
 
 inline
 interpreter::result interpreter::op_depth(program& program) {
-    program.push_move(number(program.size()).data());
+    program.push_number(int64_t(program.size()));
     program.get_metrics().add_op_cost(program.top().size());
     return error::success;
 }
@@ -491,18 +516,18 @@ interpreter::result interpreter::op_split(program& program) {
     auto& pos = program.item(0);  // last item
     auto& data = program.item(1); // but last item
 
-    number position;
-    if ( ! position.set_data(pos, program.max_integer_size_legacy())) {
+    int64_t pos64;
+    if ( ! script_number::decode(pos64, byte_span(pos.data(), pos.size()), program.max_integer_size_legacy())) {
         return error::op_split;
     }
-    auto const pos64 = position.int64();
 
     if (pos64 < 0 || size_t(pos64) > data.size()) {
         return error::op_split;
     }
 
-    auto n1 = data_chunk(data.begin(), data.begin() + pos64);
-    auto n2 = data_chunk(data.begin() + pos64, data.end());
+    auto const split = size_t(pos64);
+    stack_element n1(byte_span(data.data(), split));
+    stack_element n2(byte_span(data.data() + split, data.size() - split));
     size_t const total_size = n1.size() + n2.size();
 
     data = std::move(n1);
@@ -570,17 +595,17 @@ interpreter::result interpreter::op_num2bin(program& program) {
         return error::op_num2bin;
     }
 
-    number size;
-    if ( ! program.top(size, program.max_integer_size_legacy())) {
+    auto const& top = program.top();
+    int64_t size64;
+    if ( ! script_number::decode(size64, byte_span(top.data(), top.size()), program.max_integer_size_legacy())) {
         return error::op_num2bin_invalid_size;
     }
-    auto const size64 = size.int64();
     if (size64 < 0 || size_t(size64) > program.max_script_element_size()) {
         return error::op_num2bin_size_exceeded;
     }
 
     auto& rawnum = program.item(1); // but last item
-    number::minimally_encode(rawnum);
+    script_number::minimally_encode(rawnum);
 
     // Check if the number can be adjusted to the desired size.
     if (rawnum.size() > size64) {
@@ -637,10 +662,11 @@ interpreter::result interpreter::op_bin2num(program& program) {
     }
 
     auto& n = program.top();
-    number::minimally_encode(n);
+    script_number::minimally_encode(n);
     program.get_metrics().add_op_cost(n.size());
 
-    if ( ! number::is_minimally_encoded(n, program.max_integer_size_legacy())) {
+    // Minimally encoded, so only the range remains to be checked.
+    if (n.size() > program.max_integer_size_legacy()) {
         return error::op_bin2num_invalid_number_range;
     }
 
@@ -657,7 +683,7 @@ interpreter::result interpreter::op_size(program& program) {
     auto top = program.pop();
     auto const size = top.size();
     program.push_move(std::move(top));
-    program.push_move(number(size).data());
+    program.push_number(int64_t(size));
     program.get_metrics().add_op_cost(size);
     return error::success;
 }
@@ -745,90 +771,84 @@ interpreter::result interpreter::op_equal_verify(program& program) {
 inline
 interpreter::result interpreter::op_add1(program& program) {
     constexpr auto push_cost_factor = 2;
-    number number;
-    if ( ! program.pop(number, program.max_integer_size_legacy())) {
+    int64_t value;
+    if ( ! program.pop(value)) {
         return error::op_add1;
     }
 
-    // number += 1;
-    bool const res = number.safe_add(1);
-    if ( ! res) {
+    auto const result = script_number::add(value, 1);
+    if ( ! result) {
         return error::op_add_overflow;
     }
-    program.get_metrics().add_op_cost(number.data().size() * push_cost_factor);
-    program.push_move(number.data());
+    program.get_metrics().add_op_cost(script_number::encoded_size(*result) * push_cost_factor);
+    program.push_number(*result);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_sub1(program& program) {
     constexpr auto push_cost_factor = 2;
-    number number;
-    if ( ! program.pop(number, program.max_integer_size_legacy())) {
+    int64_t value;
+    if ( ! program.pop(value)) {
         return error::op_sub1;
     }
 
-    // number -= 1;
-    bool const res = number.safe_sub(1);
-    if ( ! res) {
+    auto const result = script_number::sub(value, 1);
+    if ( ! result) {
         return error::op_sub_underflow;
     }
-    program.get_metrics().add_op_cost(number.data().size() * push_cost_factor);
-    program.push_move(number.data());
+    program.get_metrics().add_op_cost(script_number::encoded_size(*result) * push_cost_factor);
+    program.push_number(*result);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_negate(program& program) {
     constexpr auto push_cost_factor = 2;
-    number number;
-    if ( ! program.pop(number, program.max_integer_size_legacy())) {
+    int64_t value;
+    if ( ! program.pop(value)) {
         return error::op_negate;
     }
 
-    number = -number;
-    program.get_metrics().add_op_cost(number.data().size() * push_cost_factor);
-    program.push_move(number.data());
+    program.get_metrics().add_op_cost(script_number::encoded_size(-value) * push_cost_factor);
+    program.push_number(-value);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_abs(program& program) {
     constexpr auto push_cost_factor = 2;
-    number number;
-    if ( ! program.pop(number, program.max_integer_size_legacy())) {
+    int64_t value;
+    if ( ! program.pop(value)) {
         return error::op_abs;
     }
 
-    if (number < 0) {
-        number = -number;
-    }
-
-    program.get_metrics().add_op_cost(number.data().size() * push_cost_factor);
-    program.push_move(number.data());
+    auto const result = value < 0 ? -value : value;
+    program.get_metrics().add_op_cost(script_number::encoded_size(result) * push_cost_factor);
+    program.push_number(result);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_not(program& program) {
-    number number;
-    if ( ! program.pop(number, program.max_integer_size_legacy())) {
+    int64_t value;
+    if ( ! program.pop(value)) {
         return error::op_not;
     }
 
-    program.push(number.is_false());
+    program.push(value == 0);
     program.get_metrics().add_op_cost(program.top().size());
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_nonzero(program& program) {
-    number number;
-    if ( ! program.pop(number, program.max_integer_size_legacy())) {
+    int64_t value;
+    if ( ! program.pop(value)) {
         return error::op_nonzero;
     }
 
-    program.push(number.is_true());
+    program.push(value != 0);
     program.get_metrics().add_op_cost(program.top().size());
     return error::success;
 }
@@ -836,67 +856,64 @@ interpreter::result interpreter::op_nonzero(program& program) {
 inline
 interpreter::result interpreter::op_add(program& program) {
     constexpr auto push_cost_factor = 2;
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_add;
     }
 
-    // auto const result = first + second;
-    auto result = number::safe_add(first, second);
+    auto const result = script_number::add(first, second);
     if ( ! result) {
         return error::op_add_overflow;
     }
-    program.get_metrics().add_op_cost(result->data().size() * push_cost_factor);
-    program.push_move(result->data());
+    program.get_metrics().add_op_cost(script_number::encoded_size(*result) * push_cost_factor);
+    program.push_number(*result);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_sub(program& program) {
     constexpr auto push_cost_factor = 2;
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_sub;
     }
 
-    // auto const result = second - first;
-    auto result = number::safe_sub(second, first);
+    auto const result = script_number::sub(second, first);
     if ( ! result) {
         return error::op_sub_underflow;
     }
-    program.get_metrics().add_op_cost(result->data().size() * push_cost_factor);
-    program.push_move(result->data());
+    program.get_metrics().add_op_cost(script_number::encoded_size(*result) * push_cost_factor);
+    program.push_number(*result);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_mul(program& program) {
     constexpr auto push_cost_factor = 2;
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_mul;
     }
 
-    // auto const result = first * second;
-    auto result = number::safe_mul(first, second);
+    auto const result = script_number::mul(first, second);
     if ( ! result) {
         return error::op_mul_overflow;
     }
-    uint32_t const quadratic_op_cost = first.data().size() * second.data().size();
+    uint32_t const quadratic_op_cost = script_number::encoded_size(first) * script_number::encoded_size(second);
     program.get_metrics().add_op_cost(quadratic_op_cost);
-    program.get_metrics().add_op_cost(result->data().size() * push_cost_factor);
-    program.push_move(result->data());
+    program.get_metrics().add_op_cost(script_number::encoded_size(*result) * push_cost_factor);
+    program.push_number(*result);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_div(program& program) {
     constexpr auto push_cost_factor = 2;
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_div;
     }
@@ -905,19 +922,19 @@ interpreter::result interpreter::op_div(program& program) {
         return error::op_div_by_zero;
     }
 
-    auto result = second / first;
-    uint32_t const quadratic_op_cost = first.data().size() * second.data().size();
+    auto const result = second / first;
+    uint32_t const quadratic_op_cost = script_number::encoded_size(first) * script_number::encoded_size(second);
     program.get_metrics().add_op_cost(quadratic_op_cost);
-    program.push_move(result.data());
-    program.get_metrics().add_op_cost(result.data().size() * push_cost_factor);
+    program.push_number(result);
+    program.get_metrics().add_op_cost(script_number::encoded_size(result) * push_cost_factor);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_mod(program& program) {
     constexpr auto push_cost_factor = 2;
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_mod;
     }
@@ -926,44 +943,44 @@ interpreter::result interpreter::op_mod(program& program) {
         return error::op_mod_by_zero;
     }
 
-    auto result = second % first;
-    uint32_t const quadratic_op_cost = first.data().size() * second.data().size();
+    auto const result = second % first;
+    uint32_t const quadratic_op_cost = script_number::encoded_size(first) * script_number::encoded_size(second);
     program.get_metrics().add_op_cost(quadratic_op_cost);
-    program.push_move(result.data());
-    program.get_metrics().add_op_cost(result.data().size() * push_cost_factor);
+    program.push_number(result);
+    program.get_metrics().add_op_cost(script_number::encoded_size(result) * push_cost_factor);
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_bool_and(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_bool_and;
     }
 
-    program.push(first.is_true() && second.is_true());
+    program.push(first != 0 && second != 0);
     program.get_metrics().add_op_cost(program.top().size());
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_bool_or(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_bool_or;
     }
 
-    program.push(first.is_true() || second.is_true());
+    program.push(first != 0 || second != 0);
     program.get_metrics().add_op_cost(program.top().size());
     return error::success;
 }
 
 inline
 interpreter::result interpreter::op_num_equal(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_num_equal;
     }
@@ -975,8 +992,8 @@ interpreter::result interpreter::op_num_equal(program& program) {
 
 inline
 interpreter::result interpreter::op_num_equal_verify(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_num_equal_verify1;
     }
@@ -987,8 +1004,8 @@ interpreter::result interpreter::op_num_equal_verify(program& program) {
 
 inline
 interpreter::result interpreter::op_num_not_equal(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_num_not_equal;
     }
@@ -1000,8 +1017,8 @@ interpreter::result interpreter::op_num_not_equal(program& program) {
 
 inline
 interpreter::result interpreter::op_less_than(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_less_than;
     }
@@ -1013,8 +1030,8 @@ interpreter::result interpreter::op_less_than(program& program) {
 
 inline
 interpreter::result interpreter::op_greater_than(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_greater_than;
     }
@@ -1026,8 +1043,8 @@ interpreter::result interpreter::op_greater_than(program& program) {
 
 inline
 interpreter::result interpreter::op_less_than_or_equal(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_less_than_or_equal;
     }
@@ -1039,8 +1056,8 @@ interpreter::result interpreter::op_less_than_or_equal(program& program) {
 
 inline
 interpreter::result interpreter::op_greater_than_or_equal(program& program) {
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_greater_than_or_equal;
     }
@@ -1053,13 +1070,13 @@ interpreter::result interpreter::op_greater_than_or_equal(program& program) {
 inline
 interpreter::result interpreter::op_min(program& program) {
     constexpr auto push_cost_factor = 2;
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_min;
     }
 
-    program.push_move(second < first ? second.data() : first.data());
+    program.push_number(second < first ? second : first);
     program.get_metrics().add_op_cost(program.top().size() * push_cost_factor);
     return error::success;
 }
@@ -1067,13 +1084,13 @@ interpreter::result interpreter::op_min(program& program) {
 inline
 interpreter::result interpreter::op_max(program& program) {
     constexpr auto push_cost_factor = 2;
-    number first;
-    number second;
+    int64_t first;
+    int64_t second;
     if ( ! program.pop_binary(first, second)) {
         return error::op_max;
     }
 
-    program.push_move(second > first ? second.data() : first.data());
+    program.push_number(second > first ? second : first);
     program.get_metrics().add_op_cost(program.top().size() * push_cost_factor);
     return error::success;
 }
@@ -1081,9 +1098,9 @@ interpreter::result interpreter::op_max(program& program) {
 inline
 interpreter::result interpreter::op_within(program& program) {
     // (x min max -- out)
-    number first;
-    number second;
-    number third;
+    int64_t first;
+    int64_t second;
+    int64_t third;
     if ( ! program.pop_ternary(first, second, third)) {
         return error::op_within;
     }
@@ -1093,64 +1110,64 @@ interpreter::result interpreter::op_within(program& program) {
     return error::success;
 }
 
-inline
-interpreter::result interpreter::op_ripemd160(program& program) {
-    // (in -- hash)
+// The top item is hashed in place, its storage is reused for the digest.
+// sha256 runs on the kernels selected by sha256_context (SHA-NI, AVX2).
+template <typename Hash>
+interpreter::result hash_top(program& program, bool two_rounds, interpreter::result err, Hash hash) {
     if (program.empty()) {
-        return error::op_ripemd160;
+        return err;
     }
-    program.get_metrics().add_hash_iterations(program.top().size(), false);
-    program.push_move(ripemd160_hash_chunk(program.pop()));
-    program.get_metrics().add_op_cost(program.top().size());
+
+    auto& item = program.top();
+    program.get_metrics().add_hash_iterations(item.size(), two_rounds);
+    auto const digest = hash(item.data(), item.size());
+    item.assign(digest);
+    program.get_metrics().add_op_cost(item.size());
     return error::success;
 }
 
+inline
+hash_digest sha256_of(uint8_t const* data, size_t size) {
+    sha256_context context;
+    context.write(data, size);
+    return context.finalize();
+}
+
+inline
+interpreter::result interpreter::op_ripemd160(program& program) {
+    // (in -- hash)
+    return hash_top(program, false, error::op_ripemd160, [](uint8_t const* data, size_t size) {
+        return ripemd160_hash(data_slice(data, data + size));
+    });
+}
+
 inline
 interpreter::result interpreter::op_sha1(program& program) {
     // (in -- hash)
-    if (program.empty()) {
-        return error::op_sha1;
-    }
-    program.get_metrics().add_hash_iterations(program.top().size(), false);
-    program.push_move(sha1_hash_chunk(program.pop()));
-    program.get_metrics().add_op_cost(program.top().size());
-    return error::success;
+    return hash_top(program, false, error::op_sha1, [](uint8_t const* data, size_t size) {
+        return sha1_hash(data_slice(data, data + size));
+    });
 }
 
 inline
 interpreter::result interpreter::op_sha256(program& program) {
-    if (program.empty()) {
-        return error::op_sha256;
-    }
-
-    program.get_metrics().add_hash_iterations(program.top().size(), false);
-    program.push_move(sha256_hash_chunk(program.pop()));
-    program.get_metrics().add_op_cost(program.top().size());
-    return error::success;
+    return hash_top(program, false, error::op_sha256, sha256_of);
 }
 
 inline
 interpreter::result interpreter::op_hash160(program& program) {
-    if (program.empty()) {
-        return error::op_hash160;
-    }
-
-    program.get_metrics().add_hash_iterations(program.top().size(), true);
-    program.push_move(ripemd160_hash_chunk(sha256_hash(program.pop())));
-    program.get_metrics().add_op_cost(program.top().size());
-    return error::success;
+    return hash_top(program, true, error::op_hash160, [](uint8_t const* data, size_t size) {
+        return ripemd160_hash(sha256_of(data, size));
+    });
 }
 
 inline
 interpreter::result interpreter::op_hash256(program& program) {
-    if (program.empty()) {
-        return error::op_hash256;
-    }
-
-    program.get_metrics().add_hash_iterations(program.top().size(), true);
-    program.push_move(sha256_hash_chunk(sha256_hash(program.pop())));
-    program.get_metrics().add_op_cost(program.top().size());
-    return error::success;
+    return hash_top(program, true, error::op_hash256, [](uint8_t const* data, size_t size) {
+        sha256_context context;
+        context.write(data, size);
+        return context.finalize_double();
+    });
 }
 
 inline
@@ -1158,6 +1175,11 @@ interpreter::result interpreter::op_codeseparator(program& program, operation co
     return program.set_jump_register(op, +1) ? error::success : error::op_code_seperator;
 }
 
+inline
+interpreter::result interpreter::op_codeseparator(program& program, bytecode::view const& op) {
+    return program.set_jump_register(op.index(), +1) ? error::success : error::op_code_seperator;
+}
+
 inline
 std::pair<interpreter::result, size_t> op_check_sig_common(program& program, interpreter::result err) {
     //TODO: SCRIPT_VERIFY_NULLFAIL
@@ -1172,13 +1194,13 @@ std::pair<interpreter::result, size_t> op_check_sig_common(program& program, int
     auto const bip143 = false;
 
     auto const public_key = program.pop();
-    auto endorsement = program.pop();
+    auto const endorsement = program.pop();
 
     // Create a subscript with endorsements stripped (sort of).
-    chain::script script_code(program.subscript());
+    auto const script_code = program.script_code();
 
     // BIP62: An empty endorsement is not considered lax encoding.
-    if ( ! parse_endorsement(sighash, distinguished, std::move(endorsement))) {
+    if ( ! parse_endorsement(sighash, distinguished, endorsement.to_chunk())) {
         return {error::invalid_signature_encoding, 0};
     }
 
@@ -1204,7 +1226,8 @@ std::pair<interpreter::result, size_t> op_check_sig_common(program& program, int
 #if ! defined(KTH_CURRENCY_BCH)
         version,
 #endif // ! KTH_CURRENCY_BCH
-        program.value()
+        program.value(),
+        program.sighash_context()
     );
 
     return {res ? error::success : error::incorrect_signature, size};
@@ -1264,7 +1287,7 @@ interpreter::result interpreter::op_check_multisig_verify(program& program) {
         return error::op_check_multisig_verify2;
     }
 
-    data_stack public_keys;
+    element_stack public_keys;
     if ( ! program.pop(public_keys, key_count)) {
         return error::op_check_multisig_verify3;
     }
@@ -1278,7 +1301,7 @@ interpreter::result interpreter::op_check_multisig_verify(program& program) {
         return error::op_check_multisig_verify5;
     }
 
-    data_stack endorsements;
+    element_stack endorsements;
     if ( ! program.pop(endorsements, signature_count)) {
         return error::op_check_multisig_verify6;
     }
@@ -1307,14 +1330,14 @@ interpreter::result interpreter::op_check_multisig_verify(program& program) {
     auto bip143 = false;
 
     // Before looping create subscript with endorsements stripped (sort of).
-    chain::script script_code(program.subscript());
+    auto const script_code = program.script_code();
 
     // The exact number of signatures are required and must be in order.
     // One key can validate more than one script. So we always advance
     // until we exhaust either pubkeys (fail) or signatures (pass).
-    for (auto& endorsement : endorsements) {
+    for (auto const& endorsement : endorsements) {
         // BIP62: An empty endorsement is not considered lax encoding.
-        if ( ! parse_endorsement(sighash, distinguished, std::move(endorsement))) {
+        if ( ! parse_endorsement(sighash, distinguished, endorsement.to_chunk())) {
             return error::invalid_signature_encoding;
         }
 
@@ -1341,7 +1364,8 @@ interpreter::result interpreter::op_check_multisig_verify(program& program) {
 #if ! defined(KTH_CURRENCY_BCH)
                 version,
 #endif // ! KTH_CURRENCY_BCH
-                program.value()
+                program.value(),
+                program.sighash_context()
             );
 
             if (res) {
@@ -1575,10 +1599,10 @@ interpreter::result interpreter::op_output_token_amount(program& program) {
 
 
 // It is expected that the compiler will produce a very efficient jump table.
-inline
-interpreter::result interpreter::run_op(operation const& op, program& program) {
+template <typename Operation>
+interpreter::result interpreter::run_op(Operation const& op, program& program) {
     auto const code = op.code();
-    KTH_ASSERT(op.data().empty() || op.is_push());
+    KTH_ASSERT(op.data().empty() || operation::is_push(code));
 
     program.get_metrics().add_op_cost(kth::may2025::opcode_cost);
 
@@ -56,17 +56,17 @@ operation::operation(opcode code)
     : code_(code), valid_(true)
 {}
 
-// // protected
-// inline
-// operation::operation(opcode code, data_chunk&& data, bool valid)
-//     : code_(code), data_(std::move(data)), valid_(valid)
-// {}
+// protected
+inline
+operation::operation(opcode code, data_chunk&& data, bool valid)
+    : code_(code), data_(std::move(data)), valid_(valid)
+{}
 
-// // protected
-// inline
-// operation::operation(opcode code, data_chunk const& data, bool valid)
-//     : code_(code), data_(data), valid_(valid)
-// {}
+// protected
+inline
+operation::operation(opcode code, data_chunk const& data, bool valid)
+    : code_(code), data_(data), valid_(valid)
+{}
 
 // Operators.
 //-----------------------------------------------------------------------------
@@ -8,6 +8,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <limits>
 
 #include <kth/domain/chain/script.hpp>
 #include <kth/domain/chain/transaction.hpp>
@@ -42,7 +44,7 @@ metrics const& program::get_metrics() const {
 inline
 bool program::is_valid() const {
     // Invalid operations indicates a failure deserializing individual ops.
-    return script_.is_valid_operations() && !script_.is_unspendable();
+    return get_bytecode().is_valid() && !script_.is_unspendable();
 }
 
 inline
@@ -52,7 +54,13 @@ uint32_t program::forks() const {
 
 inline
 size_t program::max_script_element_size() const {
-    auto const galois_enabled = chain::script::is_enabled(forks(), rule_fork::bch_galois);
+    return max_script_element_size(forks());
+}
+
+// static
+inline
+size_t program::max_script_element_size(uint32_t forks) {
+    auto const galois_enabled = chain::script::is_enabled(forks, rule_fork::bch_galois);
     return galois_enabled ? ::kth::may2025::max_push_data_size : max_push_data_size_legacy;
 }
 
@@ -89,6 +97,11 @@ chain::transaction const& program::transaction() const {
     return transaction_;
 }
 
+inline
+chain::sighash_context const* program::sighash_context() const {
+    return sighash_context_;
+}
+
 // Program registers.
 //-----------------------------------------------------------------------------
 
@@ -99,7 +112,7 @@ program::op_iterator program::begin() const {
 
 inline
 program::op_iterator program::jump() const {
-    return jump_;
+    return script_.begin() + jump_;
 }
 
 inline
@@ -112,6 +125,11 @@ size_t program::operation_count() const {
     return operation_count_;
 }
 
+inline
+machine::bytecode const& program::get_bytecode() const {
+    return shared_bytecode_ == nullptr ? bytecode_ : *shared_bytecode_;
+}
+
 // Instructions.
 //-----------------------------------------------------------------------------
 
@@ -122,8 +140,13 @@ bool operation_overflow(size_t count) {
 
 inline
 bool program::increment_operation_count(operation const& op) {
+    return increment_operation_count(op.code());
+}
+
+inline
+bool program::increment_operation_count(opcode code) {
     // Addition is safe due to script size validation.
-    if (operation::is_counted(op.code())) {
+    if (operation::is_counted(code)) {
         ++operation_count_;
     }
 
@@ -144,6 +167,13 @@ bool program::increment_operation_count(int32_t public_keys) {
     return !operation_overflow(operation_count_);
 }
 
+inline
+bool program::add_operation_count(size_t counted) {
+    // Addition is safe due to script size validation.
+    operation_count_ += counted;
+    return !operation_overflow(operation_count_);
+}
+
 inline
 bool program::set_jump_register(operation const& op, int32_t offset) {
     if (script_.empty()) {
@@ -155,10 +185,19 @@ bool program::set_jump_register(operation const& op, int32_t offset) {
     };
 
     // This is not efficient but is simplifying and subscript is rarely used.
-    // Otherwise we must track the program counter through each evaluation.
-    jump_ = std::find_if(script_.begin(), script_.end(), finder);
+    // The bytecode run tracks the program counter instead (see below).
+    auto const it = std::find_if(script_.begin(), script_.end(), finder);
+
+    if (it == script_.end()) {
+        return false;
+    }
 
-    if (jump_ == script_.end()) {
+    return set_jump_register(size_t(std::distance(script_.begin(), it)), offset);
+}
+
+inline
+bool program::set_jump_register(size_t index, int32_t offset) {
+    if (index >= get_bytecode().size()) {
         return false;
     }
 
@@ -166,7 +205,7 @@ bool program::set_jump_register(operation const& op, int32_t offset) {
     // Even if the opcode is last in the sequnce the increment is valid (end).
     KTH_ASSERT_MSG(offset == 1, "unguarded jump offset");
 
-    jump_ += offset;
+    jump_ = index + offset;
     return true;
 }
 
@@ -191,41 +230,50 @@ void program::push_copy(value_type const& item) {
     primary_.push_back(item);
 }
 
+// The element is created with the resource of the stack.
+inline
+void program::push_number(int64_t value) {
+    script_number::encode(primary_.emplace_back(), value);
+}
+
 // Primary stack (pop).
 //-----------------------------------------------------------------------------
 
 // This must be guarded.
 inline
-data_chunk program::pop() {
+program::value_type program::pop() {
     KTH_ASSERT( ! empty());
     auto value = std::move(primary_.back());
     primary_.pop_back();
     return value;
 }
 
+// As number::int32, the value is clamped to the int32 domain.
 inline
 bool program::pop(int32_t& out_value) {
-    number value;
-    if ( ! pop(value, max_integer_size_legacy())) {
+    int64_t value;
+    if ( ! pop(value)) {
         return false;
     }
-    out_value = value.int32();
+    out_value = int32_t(std::clamp<int64_t>(value, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max()));
     return true;
 }
 
 inline
 bool program::pop(int64_t& out_value) {
-    number value;
-    if ( ! pop(value, max_integer_size_legacy())) {
+    if (empty()) {
         return false;
     }
-    out_value = value.int64();
-    return true;
+
+    auto const& item = primary_.back();
+    auto const decoded = script_number::decode(out_value, byte_span(item.data(), item.size()), max_integer_size_legacy());
+    primary_.pop_back();
+    return decoded;
 }
 
 inline
 bool program::pop(number& out_number, size_t maximum_size) {
-    return !empty() && out_number.set_data(pop(), maximum_size);
+    return !empty() && out_number.set_data(pop().to_chunk(), maximum_size);
 }
 
 inline
@@ -240,6 +288,18 @@ bool program::pop_ternary(number& first, number& second, number& third) {
     return pop(first, max_integer_size_legacy()) && pop(second, max_integer_size_legacy()) && pop(third, max_integer_size_legacy());
 }
 
+inline
+bool program::pop_binary(int64_t& first, int64_t& second) {
+    // The right hand side number is at the top of the stack.
+    return pop(first) && pop(second);
+}
+
+inline
+bool program::pop_ternary(int64_t& first, int64_t& second, int64_t& third) {
+    // The upper bound is at stack top, lower bound next, value next.
+    return pop(first) && pop(second) && pop(third);
+}
+
 // Determines if popped value is valid post-pop stack index and returns index.
 inline
 bool program::pop_position(stack_iterator& out_position) {
@@ -266,7 +326,7 @@ bool program::pop_position(stack_iterator& out_position) {
 
 // pop1/pop2/.../pop[count]
 inline
-bool program::pop(data_stack& section, size_t count) {
+bool program::pop(element_stack& section, size_t count) {
     if (size() < count) {
         return false;
     }
@@ -295,8 +355,8 @@ void program::swap(size_t index_left, size_t index_right) {
 
     // // TODO(legacy): refactor to allow DRY without const_cast here.
     // std::swap(
-    //     const_cast<data_stack::value_type&>(item(index_left)),
-    //     const_cast<data_stack::value_type&>(item(index_right)));
+    //     const_cast<value_type&>(item(index_left)),
+    //     const_cast<value_type&>(item(index_right)));
 }
 
 // pop1/pop2/.../pop[pos-1]/pop[pos]/push[pos-1]/.../push2/push1
@@ -365,31 +425,31 @@ bool program::if_(operation const& op) const {
 }
 
 inline
-data_stack::value_type const& program::item(size_t index) const {
+program::value_type const& program::item(size_t index) const {
     return *position(index);
 }
 
 inline
-data_stack::value_type& program::item(size_t index) {
+program::value_type& program::item(size_t index) {
     return *position(index);
 }
 
 // This must be guarded.
 inline
-data_chunk& program::top() {
+program::value_type& program::top() {
     KTH_ASSERT( ! empty());
     return primary_.back();
 }
 
 inline
-data_chunk const& program::top() const {
+program::value_type const& program::top() const {
     KTH_ASSERT( ! empty());
     return primary_.back();
 }
 
 inline
 bool program::top(number& out_number, size_t maximum_size) const {
-    return !empty() && out_number.set_data(item(0), maximum_size);
+    return !empty() && out_number.set_data(item(0).to_chunk(), maximum_size);
 }
 
 
@@ -424,6 +484,12 @@ operation::list program::subscript() const {
     return ops;
 }
 
+inline
+chain::script program::script_code() const {
+    auto const bytes = get_bytecode().script_from(jump_);
+    return chain::script(data_chunk(bytes.begin(), bytes.end()), false);
+}
+
 inline
 size_t program::size() const {
     return primary_.size();
@@ -452,7 +518,7 @@ void program::push_alternate(value_type&& value) {
 inline
 program::value_type program::pop_alternate() {
     KTH_ASSERT( ! alternate_.empty());
-    auto const value = alternate_.back();
+    auto value = std::move(alternate_.back());
     alternate_.pop_back();
     return value;
 }
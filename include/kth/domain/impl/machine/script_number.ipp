@@ -0,0 +1,163 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MACHINE_SCRIPT_NUMBER_IPP
+#define KTH_DOMAIN_MACHINE_SCRIPT_NUMBER_IPP
+
+#include <limits>
+
+#include <kth/infrastructure/utility/assert.hpp>
+
+namespace kth::domain::machine {
+
+// static
+inline
+bool script_number::decode(int64_t& out, byte_span data, size_t maximum_size) {
+    if (data.size() > maximum_size) {
+        return false;
+    }
+
+    KTH_ASSERT(data.size() <= sizeof(int64_t));
+    uint64_t magnitude = 0;
+
+    for (size_t index = 0; index < data.size(); ++index) {
+        magnitude |= uint64_t(data[index]) << (8 * index);
+    }
+
+    // The sign is the high bit of the last byte.
+    if ( ! data.empty() && (data.back() & 0x80) != 0) {
+        magnitude &= ~(uint64_t(0x80) << (8 * (data.size() - 1)));
+        out = -int64_t(magnitude);
+        return true;
+    }
+
+    out = int64_t(magnitude);
+    return true;
+}
+
+// static
+inline
+void script_number::encode(stack_element& out, int64_t value) {
+    uint8_t bytes[max_encoded_size];
+    size_t size = 0;
+
+    auto const negative = value < 0;
+    auto magnitude = negative ? uint64_t(0) - uint64_t(value) : uint64_t(value);
+
+    while (magnitude != 0) {
+        bytes[size++] = uint8_t(magnitude);
+        magnitude >>= 8;
+    }
+
+    // The sign takes an extra byte if the high bit is in use.
+    if (size != 0) {
+        if ((bytes[size - 1] & 0x80) != 0) {
+            bytes[size++] = negative ? 0x80 : 0x00;
+        } else if (negative) {
+            bytes[size - 1] |= 0x80;
+        }
+    }
+
+    out.assign(byte_span(bytes, size));
+}
+
+// static
+inline
+size_t script_number::encoded_size(int64_t value) {
+    auto magnitude = value < 0 ? uint64_t(0) - uint64_t(value) : uint64_t(value);
+    size_t size = 0;
+    uint8_t last = 0;
+
+    while (magnitude != 0) {
+        last = uint8_t(magnitude);
+        magnitude >>= 8;
+        ++size;
+    }
+
+    return size + ((last & 0x80) != 0 ? 1 : 0);
+}
+
+// static
+inline
+void script_number::minimally_encode(stack_element& data) {
+    if (data.empty()) {
+        return;
+    }
+
+    // A last byte other than 0x00 or 0x80 carries magnitude.
+    auto const last = data.back();
+    if ((last & 0x7f) != 0) {
+        return;
+    }
+
+    // A single sign byte is zero.
+    if (data.size() == 1) {
+        data.clear();
+        return;
+    }
+
+    // The last byte is needed if the sign bit of the previous one is set.
+    if ((data[data.size() - 2] & 0x80) != 0) {
+        return;
+    }
+
+    // Move the sign next to the most significant non zero byte.
+    for (auto index = data.size() - 1; index > 0; --index) {
+        if (data[index - 1] != 0) {
+            if ((data[index - 1] & 0x80) != 0) {
+                data[index++] = last;
+            } else {
+                data[index - 1] |= last;
+            }
+
+            data.resize(index);
+            return;
+        }
+    }
+
+    data.clear();
+}
+
+// The minimum is excluded, as its magnitude does not fit 8 bytes.
+constexpr int64_t script_number_max = std::numeric_limits<int64_t>::max();
+constexpr int64_t script_number_min = -script_number_max;
+
+// static
+inline
+std::optional<int64_t> script_number::add(int64_t left, int64_t right) {
+    if (right > 0 ? left > script_number_max - right : left < script_number_min - right) {
+        return std::nullopt;
+    }
+    return left + right;
+}
+
+// static
+inline
+std::optional<int64_t> script_number::sub(int64_t left, int64_t right) {
+    if (right > 0 ? left < script_number_min + right : left > script_number_max + right) {
+        return std::nullopt;
+    }
+    return left - right;
+}
+
+// static
+inline
+std::optional<int64_t> script_number::mul(int64_t left, int64_t right) {
+    if (left == 0 || right == 0) {
+        return int64_t(0);
+    }
+
+    // Both operands are in range, so their magnitudes fit an int64_t.
+    auto const left_magnitude = left < 0 ? -left : left;
+    auto const right_magnitude = right < 0 ? -right : right;
+
+    if (left_magnitude > script_number_max / right_magnitude) {
+        return std::nullopt;
+    }
+    return left * right;
+}
+
+} // namespace kth::domain::machine
+
+#endif // KTH_DOMAIN_MACHINE_SCRIPT_NUMBER_IPP
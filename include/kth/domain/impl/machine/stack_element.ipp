@@ -0,0 +1,308 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MACHINE_STACK_ELEMENT_IPP
+#define KTH_DOMAIN_MACHINE_STACK_ELEMENT_IPP
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <kth/infrastructure/utility/assert.hpp>
+
+namespace kth::domain::machine {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+inline
+stack_element::stack_element(allocator_type allocator)
+    : allocator_(allocator)
+{}
+
+inline
+stack_element::stack_element(std::initializer_list<uint8_t> values, allocator_type allocator)
+    : allocator_(allocator)
+{
+    assign(byte_span(values.begin(), values.size()));
+}
+
+inline
+stack_element::stack_element(byte_span data, allocator_type allocator)
+    : allocator_(allocator)
+{
+    assign(data);
+}
+
+inline
+stack_element::stack_element(data_chunk const& data, allocator_type allocator)
+    : allocator_(allocator)
+{
+    assign(data);
+}
+
+// As the pmr containers, a copy uses the default resource.
+inline
+stack_element::stack_element(stack_element const& x)
+    : stack_element(x, allocator_type{})
+{}
+
+inline
+stack_element::stack_element(stack_element const& x, allocator_type allocator)
+    : allocator_(allocator)
+{
+    assign(byte_span(x.data(), x.size()));
+}
+
+inline
+stack_element::stack_element(stack_element&& x) noexcept
+    : allocator_(x.allocator_)
+{
+    if (x.heap_ == nullptr) {
+        std::memcpy(inline_, x.inline_, x.size_);
+        size_ = x.size_;
+        x.size_ = 0;
+        return;
+    }
+
+    heap_ = std::exchange(x.heap_, nullptr);
+    size_ = std::exchange(x.size_, 0);
+    capacity_ = std::exchange(x.capacity_, uint32_t(inline_capacity));
+}
+
+inline
+stack_element::stack_element(stack_element&& x, allocator_type allocator)
+    : allocator_(allocator)
+{
+    *this = std::move(x);
+}
+
+inline
+stack_element::~stack_element() {
+    release();
+}
+
+// Operators.
+//-----------------------------------------------------------------------------
+
+inline
+stack_element& stack_element::operator=(stack_element const& x) {
+    if (this != &x) {
+        assign(byte_span(x.data(), x.size()));
+    }
+
+    return *this;
+}
+
+// The resource is not propagated, the buffer is taken only if it is shared.
+inline
+stack_element& stack_element::operator=(stack_element&& x) {
+    if (this == &x) {
+        return *this;
+    }
+
+    if (x.heap_ == nullptr || allocator_ != x.allocator_) {
+        assign(byte_span(x.data(), x.size()));
+        x.clear();
+        return *this;
+    }
+
+    release();
+    heap_ = std::exchange(x.heap_, nullptr);
+    size_ = std::exchange(x.size_, 0);
+    capacity_ = std::exchange(x.capacity_, uint32_t(inline_capacity));
+    return *this;
+}
+
+inline
+bool operator==(stack_element const& x, stack_element const& y) {
+    return x.size() == y.size() && std::equal(x.begin(), x.end(), y.begin());
+}
+
+inline
+uint8_t& stack_element::operator[](size_t index) {
+    KTH_ASSERT(index < size_);
+    return data()[index];
+}
+
+inline
+uint8_t stack_element::operator[](size_t index) const {
+    KTH_ASSERT(index < size_);
+    return data()[index];
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+inline
+stack_element::allocator_type stack_element::get_allocator() const {
+    return allocator_;
+}
+
+inline
+bool stack_element::empty() const {
+    return size_ == 0;
+}
+
+inline
+size_t stack_element::size() const {
+    return size_;
+}
+
+inline
+size_t stack_element::capacity() const {
+    return capacity_;
+}
+
+inline
+bool stack_element::is_inline() const {
+    return heap_ == nullptr;
+}
+
+inline
+uint8_t* stack_element::data() {
+    return heap_ == nullptr ? inline_ : heap_;
+}
+
+inline
+uint8_t const* stack_element::data() const {
+    return heap_ == nullptr ? inline_ : heap_;
+}
+
+inline
+stack_element::iterator stack_element::begin() {
+    return data();
+}
+
+inline
+stack_element::iterator stack_element::end() {
+    return data() + size_;
+}
+
+inline
+stack_element::const_iterator stack_element::begin() const {
+    return data();
+}
+
+inline
+stack_element::const_iterator stack_element::end() const {
+    return data() + size_;
+}
+
+inline
+uint8_t& stack_element::back() {
+    KTH_ASSERT( ! empty());
+    return data()[size_ - 1];
+}
+
+inline
+uint8_t stack_element::back() const {
+    KTH_ASSERT( ! empty());
+    return data()[size_ - 1];
+}
+
+inline
+data_chunk stack_element::to_chunk() const {
+    return data_chunk(begin(), end());
+}
+
+// Modifiers.
+//-----------------------------------------------------------------------------
+
+inline
+void stack_element::assign(byte_span data) {
+    // The data must not be part of this element.
+    reserve(data.size());
+
+    if ( ! data.empty()) {
+        std::memcpy(this->data(), data.data(), data.size());
+    }
+
+    size_ = uint32_t(data.size());
+}
+
+inline
+void stack_element::reserve(size_t size) {
+    if (size > capacity_) {
+        grow(size);
+    }
+}
+
+inline
+void stack_element::resize(size_t size) {
+    reserve(size);
+
+    if (size > size_) {
+        std::memset(data() + size_, 0, size - size_);
+    }
+
+    size_ = uint32_t(size);
+}
+
+inline
+void stack_element::clear() {
+    size_ = 0;
+}
+
+inline
+void stack_element::push_back(uint8_t value) {
+    if (size_ == capacity_) {
+        grow(size_t(capacity_) * 2);
+    }
+
+    data()[size_++] = value;
+}
+
+inline
+stack_element::iterator stack_element::insert(const_iterator position, const_iterator first, const_iterator last) {
+    KTH_ASSERT(position >= begin() && position <= end());
+    auto const offset = size_t(position - begin());
+    auto const count = size_t(last - first);
+
+    if (count == 0) {
+        return begin() + offset;
+    }
+
+    // A range of this element is copied before the buffer can move.
+    if (first >= begin() && first < end()) {
+        stack_element const copy(byte_span(first, count));
+        return insert(begin() + offset, copy.begin(), copy.end());
+    }
+
+    reserve(size_ + count);
+    auto const target = begin() + offset;
+    std::memmove(target + count, target, size_ - offset);
+    std::memcpy(target, first, count);
+    size_ += uint32_t(count);
+    return target;
+}
+
+// private
+inline
+void stack_element::grow(size_t capacity) {
+    KTH_ASSERT(capacity > capacity_);
+    auto* const buffer = allocator_.allocate(capacity);
+
+    if (size_ != 0) {
+        std::memcpy(buffer, data(), size_);
+    }
+
+    release();
+    heap_ = buffer;
+    capacity_ = uint32_t(capacity);
+}
+
+// private
+inline
+void stack_element::release() {
+    if (heap_ != nullptr) {
+        allocator_.deallocate(heap_, capacity_);
+        heap_ = nullptr;
+        capacity_ = inline_capacity;
+    }
+}
+
+} // namespace kth::domain::machine
+
+#endif // KTH_DOMAIN_MACHINE_STACK_ELEMENT_IPP
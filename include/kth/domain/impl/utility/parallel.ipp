@@ -0,0 +1,89 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_UTILITY_PARALLEL_IPP
+#define KTH_DOMAIN_UTILITY_PARALLEL_IPP
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include <kth/domain/math/sha256.hpp>
+#include <kth/infrastructure/hash_define.hpp>
+#include <kth/infrastructure/utility/assert.hpp>
+#include <kth/infrastructure/utility/container_sink.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+#include <kth/infrastructure/utility/ostream_writer.hpp>
+
+namespace kth::domain {
+
+template <typename Function>
+void parallel_ranges(size_t count, size_t threads, size_t minimum, Function const& function) {
+    if (threads <= 1 || count < threads * minimum) {
+        function(size_t(0), count);
+        return;
+    }
+
+    auto const chunk = (count + threads - 1) / threads;
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+
+    for (auto first = chunk; first < count; first += chunk) {
+        workers.emplace_back(function, first, std::min(first + chunk, count));
+    }
+
+    function(size_t(0), std::min(chunk, count));
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+template <typename Entity>
+void cache_hashes(std::vector<Entity const*> const& entities, size_t threads, size_t minimum) {
+    auto const hash_range = [&entities](size_t first, size_t last) {
+        std::vector<size_t> sizes;
+        sizes.reserve(last - first);
+        size_t total = 0;
+
+        for (auto index = first; index < last; ++index) {
+            sizes.push_back(entities[index]->serialized_size(true));
+            total += sizes.back();
+        }
+
+        data_chunk arena;
+        arena.reserve(total);
+        data_sink ostream(arena);
+        ostream_writer sink_w(ostream);
+
+        for (auto index = first; index < last; ++index) {
+            entities[index]->to_data(sink_w, true);
+        }
+
+        ostream.flush();
+        KTH_ASSERT(arena.size() == total);
+
+        std::vector<data_slice> messages;
+        messages.reserve(sizes.size());
+        auto const* begin = arena.data();
+
+        for (auto const size : sizes) {
+            messages.emplace_back(begin, begin + size);
+            begin += size;
+        }
+
+        hash_list hashes(messages.size());
+        double_sha256(hashes.data(), messages.data(), messages.size());
+
+        for (auto index = first; index < last; ++index) {
+            entities[index]->cache_hash(hashes[index - first]);
+        }
+    };
+
+    parallel_ranges(entities.size(), threads, minimum, hash_range);
+}
+
+} // namespace kth::domain
+
+#endif // KTH_DOMAIN_UTILITY_PARALLEL_IPP
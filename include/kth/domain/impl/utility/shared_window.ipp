@@ -0,0 +1,205 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_UTILITY_SHARED_WINDOW_IPP
+#define KTH_DOMAIN_UTILITY_SHARED_WINDOW_IPP
+
+#include <algorithm>
+#include <utility>
+
+#include <kth/infrastructure/utility/assert.hpp>
+
+namespace kth::domain {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+template <typename T>
+shared_window<T>::buffer::buffer(size_t size)
+    : values(std::make_unique<T[]>(size))
+    , capacity(size)
+{}
+
+template <typename T>
+shared_window<T>::shared_window(std::initializer_list<T> values) {
+    reallocate(values.size());
+    std::copy(values.begin(), values.end(), buffer_->values.get());
+    size_ = values.size();
+    buffer_->used.store(size_, std::memory_order_relaxed);
+}
+
+// Operators.
+//-----------------------------------------------------------------------------
+
+template <typename T>
+bool operator==(shared_window<T> const& x, shared_window<T> const& y) {
+    return std::equal(x.begin(), x.end(), y.begin(), y.end());
+}
+
+template <typename T>
+T& shared_window<T>::operator[](size_t index) {
+    KTH_ASSERT(index < size_);
+    detach();
+    return buffer_->values[first_ + index];
+}
+
+template <typename T>
+T const& shared_window<T>::operator[](size_t index) const {
+    KTH_ASSERT(index < size_);
+    return buffer_->values[first_ + index];
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+template <typename T>
+bool shared_window<T>::empty() const {
+    return size_ == 0;
+}
+
+template <typename T>
+size_t shared_window<T>::size() const {
+    return size_;
+}
+
+template <typename T>
+bool shared_window<T>::is_shared() const {
+    return buffer_ != nullptr && buffer_.use_count() > 1;
+}
+
+template <typename T>
+T const& shared_window<T>::front() const {
+    KTH_ASSERT( ! empty());
+    return (*this)[0];
+}
+
+template <typename T>
+T const& shared_window<T>::back() const {
+    KTH_ASSERT( ! empty());
+    return (*this)[size_ - 1];
+}
+
+template <typename T>
+typename shared_window<T>::iterator shared_window<T>::begin() {
+    detach();
+    return buffer_ == nullptr ? nullptr : buffer_->values.get() + first_;
+}
+
+template <typename T>
+typename shared_window<T>::iterator shared_window<T>::end() {
+    return begin() + size_;
+}
+
+template <typename T>
+typename shared_window<T>::const_iterator shared_window<T>::begin() const {
+    return buffer_ == nullptr ? nullptr : buffer_->values.get() + first_;
+}
+
+template <typename T>
+typename shared_window<T>::const_iterator shared_window<T>::end() const {
+    return begin() + size_;
+}
+
+template <typename T>
+typename shared_window<T>::reverse_iterator shared_window<T>::rbegin() {
+    return reverse_iterator(end());
+}
+
+template <typename T>
+typename shared_window<T>::reverse_iterator shared_window<T>::rend() {
+    return reverse_iterator(begin());
+}
+
+template <typename T>
+typename shared_window<T>::const_reverse_iterator shared_window<T>::rbegin() const {
+    return const_reverse_iterator(end());
+}
+
+template <typename T>
+typename shared_window<T>::const_reverse_iterator shared_window<T>::rend() const {
+    return const_reverse_iterator(begin());
+}
+
+// Modifiers.
+//-----------------------------------------------------------------------------
+
+template <typename T>
+void shared_window<T>::push_back(T value) {
+    auto end = first_ + size_;
+
+    // Positions claimed by windows that no longer exist can be reused, the
+    // fence orders their writes before ours.
+    if (buffer_ != nullptr && buffer_.use_count() == 1) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        buffer_->used.store(end, std::memory_order_relaxed);
+    }
+
+    // The position after this window is taken by the first to claim it.
+    if (buffer_ == nullptr || end == buffer_->capacity ||
+        ! buffer_->used.compare_exchange_strong(end, end + 1, std::memory_order_relaxed)) {
+        reallocate(std::max(2 * (size_ + 1), minimum_capacity));
+        end = size_;
+        buffer_->used.store(end + 1, std::memory_order_relaxed);
+    }
+
+    buffer_->values[end] = std::move(value);
+    ++size_;
+}
+
+template <typename T>
+void shared_window<T>::pop_front() {
+    KTH_ASSERT( ! empty());
+    ++first_;
+    --size_;
+}
+
+template <typename T>
+void shared_window<T>::resize(size_t size) {
+    if (size == size_) {
+        return;
+    }
+
+    auto const kept = std::min(size, size_);
+    auto replacement = std::make_shared<buffer>(std::max(size, minimum_capacity));
+    if (kept != 0) {
+        std::copy_n(buffer_->values.get() + first_, kept, replacement->values.get());
+    }
+
+    replacement->used.store(size, std::memory_order_relaxed);
+    buffer_ = std::move(replacement);
+    first_ = 0;
+    size_ = size;
+}
+
+template <typename T>
+void shared_window<T>::clear() {
+    buffer_.reset();
+    first_ = 0;
+    size_ = 0;
+}
+
+// private
+template <typename T>
+void shared_window<T>::reallocate(size_t capacity) {
+    auto replacement = std::make_shared<buffer>(std::max(capacity, size_));
+    if (size_ != 0) {
+        std::copy_n(buffer_->values.get() + first_, size_, replacement->values.get());
+    }
+
+    replacement->used.store(size_, std::memory_order_relaxed);
+    buffer_ = std::move(replacement);
+    first_ = 0;
+}
+
+// private
+template <typename T>
+void shared_window<T>::detach() {
+    if (is_shared()) {
+        reallocate(buffer_->capacity - first_);
+    }
+}
+
+} // namespace kth::domain
+
+#endif // KTH_DOMAIN_UTILITY_SHARED_WINDOW_IPP
@@ -0,0 +1,123 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MACHINE_BYTECODE_HPP
+#define KTH_DOMAIN_MACHINE_BYTECODE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <kth/domain/define.hpp>
+#include <kth/domain/machine/opcode.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain::machine {
+
+/// A script decoded once into a flat array of instructions for the
+/// interpreter. Push data is borrowed from the script bytes, which must
+/// outlive the bytecode. The fork dependent checks (disabled opcodes and
+/// oversized pushes) are resolved when compiling, and each instruction knows
+/// how far execution may skip while its branch is not taken.
+class KD_API bytecode {
+public:
+    struct instruction {
+        static constexpr uint8_t counted = 1 << 0;
+        static constexpr uint8_t conditional = 1 << 1;
+        static constexpr uint8_t oversized = 1 << 2;
+        static constexpr uint8_t disabled = 1 << 3;
+
+        opcode code;
+        uint8_t flags;
+
+        /// Of the opcode in the script.
+        uint32_t offset;
+
+        /// Of the push data in the script.
+        uint32_t data_offset;
+        uint32_t data_size;
+
+        /// Counted instructions before this one.
+        uint32_t counted_before;
+
+        /// The next conditional instruction (or the end), if the instructions
+        /// in between only need counting when not executed, otherwise the
+        /// next instruction.
+        uint32_t skip;
+    };
+
+    /// An instruction with its data, as run by the interpreter.
+    class view {
+    public:
+        view(opcode code, byte_span data, size_t index)
+            : code_(code), data_(data), index_(index)
+        {}
+
+        [[nodiscard]]
+        opcode code() const {
+            return code_;
+        }
+
+        [[nodiscard]]
+        byte_span data() const {
+            return data_;
+        }
+
+        [[nodiscard]]
+        size_t index() const {
+            return index_;
+        }
+
+    private:
+        opcode code_;
+        byte_span data_;
+        size_t index_;
+    };
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    bytecode() = default;
+
+    /// Pushes larger than max_push_size are flagged oversized.
+    bytecode(byte_span script, uint32_t active_forks, size_t max_push_size);
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    /// False if the script ends in a truncated push, which then decodes as
+    /// a last invalid instruction (as with script::operations).
+    [[nodiscard]]
+    bool is_valid() const;
+
+    [[nodiscard]]
+    bool empty() const;
+
+    [[nodiscard]]
+    size_t size() const;
+
+    [[nodiscard]]
+    instruction const& operator[](size_t index) const;
+
+    [[nodiscard]]
+    view at(size_t index) const;
+
+    /// Counted instructions in [first, last).
+    [[nodiscard]]
+    size_t counted(size_t first, size_t last) const;
+
+    /// The script bytes from the instruction at index (or none at the end).
+    [[nodiscard]]
+    byte_span script_from(size_t index) const;
+
+private:
+    byte_span script_;
+    std::vector<instruction> instructions_;
+    uint32_t counted_{0};
+    bool valid_{true};
+};
+
+} // namespace kth::domain::machine
+
+#endif // KTH_DOMAIN_MACHINE_BYTECODE_HPP
@@ -5,9 +5,13 @@
 #ifndef KTH_DOMAIN_MACHINE_INTERPRETER_HPP
 #define KTH_DOMAIN_MACHINE_INTERPRETER_HPP
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 
 #include <kth/domain/define.hpp>
+#include <kth/domain/machine/bytecode.hpp>
 #include <kth/domain/machine/opcode.hpp>
 #include <kth/domain/machine/operation.hpp>
 #include <kth/domain/machine/program.hpp>
@@ -20,6 +24,15 @@ class KD_API interpreter {
 public:
     using result = error::error_code_t;
 
+    /// The dispatch of the script instructions. The switch over the opcode is
+    /// the reference, the threaded dispatch calls a handler specialized for
+    /// each opcode through a table (the hottest ones with fast paths).
+    /// run(program) uses the dispatch the library was built with.
+    enum class dispatch {
+        switched,
+        threaded
+    };
+
     // Operations (shared).
     //-----------------------------------------------------------------------------
 
@@ -38,9 +51,15 @@ public:
     static
     result op_push_size(program& program, operation const& op);
 
+    static
+    result op_push_size(program& program, bytecode::view const& op);
+
     static
     result op_push_data(program& program, data_chunk const& data, uint32_t size_limit);
 
+    static
+    result op_push_data(program& program, byte_span data, uint32_t size_limit);
+
     // Operations (not shared).
     //-----------------------------------------------------------------------------
 
@@ -239,6 +258,9 @@ public:
     static
     result op_codeseparator(program& program, operation const& op);
 
+    static
+    result op_codeseparator(program& program, bytecode::view const& op);
+
     static
     result op_check_sig(program& program);
 
@@ -327,6 +349,10 @@ public:
     static
     code run(program& program);
 
+    /// Run program script with the given dispatch, for comparison.
+    static
+    code run(program& program, dispatch mode);
+
     /// Run individual operations (idependent of the script).
     /// For best performance use script runner for a sequence of operations.
     static
@@ -348,8 +374,25 @@ public:
     code debug_end(program const& program);
 
 private:
+    using handler = result (*)(bytecode::view const& op, program& program);
+
+    template <dispatch Mode>
+    static
+    code run_script(program& program);
+
+    /// Operation is an operation or a bytecode::view.
+    template <typename Operation>
+    static
+    result run_op(Operation const& op, program& program);
+
+    /// run_op of a constant opcode, the switch folds to its case.
+    template <opcode Code>
+    static
+    result run_fixed(bytecode::view const& op, program& program);
+
+    template <size_t... Codes>
     static
-    result run_op(operation const& op, program& program);
+    std::array<handler, sizeof...(Codes)> make_handlers(std::index_sequence<Codes...> codes);
 };
 
 } // namespace kth::domain::machine
@@ -0,0 +1,90 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MACHINE_OPCODE_PROFILE_HPP
+#define KTH_DOMAIN_MACHINE_OPCODE_PROFILE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include <kth/domain/define.hpp>
+#include <kth/domain/machine/opcode.hpp>
+
+namespace kth::domain::machine {
+
+/// Per opcode execution counts, cycles and bytes touched (the size of the
+/// pushed data or of the top stack item before the operation).
+/// The interpreter records into the profile of the running thread when built
+/// with WITH_OPCODE_PROFILER (KTH_OPCODE_PROFILER), otherwise nothing is
+/// recorded and the profiles stay empty.
+/// Only the owning thread records into a profile, any thread can read it.
+class KD_API opcode_profile {
+public:
+    struct entry {
+        uint64_t count{0};
+        uint64_t cycles{0};
+        uint64_t bytes{0};
+    };
+
+    opcode_profile() = default;
+    opcode_profile(opcode_profile const& x);
+    opcode_profile& operator=(opcode_profile const& x);
+
+    /// The profile of the calling thread.
+    static
+    opcode_profile& local();
+
+    /// The sum of the profiles of all threads, including those that ended.
+    static
+    opcode_profile collect();
+
+    /// Clears the profiles of all threads, also while they record.
+    static
+    void reset_all();
+
+    /// A timestamp in cycles (rdtsc), nanoseconds where not available.
+    static
+    uint64_t now();
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    entry get(opcode code) const;
+
+    [[nodiscard]]
+    uint64_t total_count() const;
+
+    [[nodiscard]]
+    uint64_t total_cycles() const;
+
+    // Recording.
+    //-------------------------------------------------------------------------
+
+    /// Owning thread only.
+    void record(opcode code, uint64_t cycles, size_t bytes);
+
+    void merge(opcode_profile const& other);
+    void reset();
+
+    /// Folded stacks ("script;<opcode> <cycles>" lines) for flame graph
+    /// tools, the opcodes without executions are omitted.
+    void dump(std::ostream& out) const;
+
+private:
+    struct counters {
+        std::atomic<uint64_t> count{0};
+        std::atomic<uint64_t> cycles{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    std::array<counters, 256> counters_;
+};
+
+} // namespace kth::domain::machine
+
+#endif // KTH_DOMAIN_MACHINE_OPCODE_PROFILE_HPP
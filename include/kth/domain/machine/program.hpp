@@ -6,14 +6,19 @@
 #define KTH_DOMAIN_MACHINE_PROGRAM_HPP
 
 #include <cstdint>
+#include <memory_resource>
 
 #include <kth/domain/chain/script.hpp>
+#include <kth/domain/chain/sighash_context.hpp>
 #include <kth/domain/chain/transaction.hpp>
 #include <kth/domain/constants.hpp>
 #include <kth/domain/define.hpp>
+#include <kth/domain/machine/bytecode.hpp>
 #include <kth/domain/machine/metrics.hpp>
 #include <kth/domain/machine/opcode.hpp>
 #include <kth/domain/machine/operation.hpp>
+#include <kth/domain/machine/script_number.hpp>
+#include <kth/domain/machine/stack_element.hpp>
 #include <kth/infrastructure/machine/number.hpp>
 #include <kth/infrastructure/machine/script_version.hpp>
 #include <kth/infrastructure/utility/data.hpp>
@@ -30,11 +35,11 @@ using number = ::kth::infrastructure::machine::number;
 
 class KD_API program {
 public:
-    using value_type = data_stack::value_type;
+    using value_type = stack_element;
     using op_iterator = operation::iterator;
 
-    using stack_iterator = data_stack::const_iterator;
-    using stack_mutable_iterator = data_stack::iterator;
+    using stack_iterator = element_stack::const_iterator;
+    using stack_mutable_iterator = element_stack::iterator;
 
     /// Create an instance that does not expect to verify signatures.
     /// This is useful for script utilities but not with input validation.
@@ -47,7 +52,10 @@ public:
     program(chain::script const& script);
 
     /// Create an instance with empty stacks, value unused/max (input run).
-    program(chain::script const& script, chain::transaction const& transaction, uint32_t input_index, uint32_t forks);
+    /// The optional sighash context must be built from the same transaction.
+    /// The stacks and their large items are allocated from the resource,
+    /// which the programs created from this one share.
+    program(chain::script const& script, chain::transaction const& transaction, uint32_t input_index, uint32_t forks, chain::sighash_context const* context = nullptr, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
     /// Create an instance with initialized stack (witness run, v0 by default).
     program(
@@ -68,6 +76,14 @@ public:
     /// Create using copied tx, input, forks, value and moved stack (p2sh run).
     program(chain::script const& script, program&& x, bool move);
 
+    /// As the p2sh run, with the script compiled by compile(script, x.forks()).
+    /// The bytecode (and so the script) must outlive the program.
+    program(chain::script const& script, machine::bytecode const& compiled, program&& x);
+
+    /// The bytecode run by evaluate() for the script and forks.
+    static
+    machine::bytecode compile(chain::script const& script, uint32_t forks);
+
     metrics& get_metrics();
     metrics const& get_metrics() const;
 
@@ -81,6 +97,9 @@ public:
     [[nodiscard]]
     size_t max_script_element_size() const;
 
+    static
+    size_t max_script_element_size(uint32_t forks);
+
     [[nodiscard]]
     size_t max_integer_size_legacy() const;
 
@@ -101,6 +120,10 @@ public:
     [[nodiscard]]
     chain::transaction const& transaction() const;
 
+    /// Shared signature hash components of the transaction, may be null.
+    [[nodiscard]]
+    chain::sighash_context const* sighash_context() const;
+
     /// Program registers.
     [[nodiscard]]
     op_iterator begin() const;
@@ -114,13 +137,25 @@ public:
     [[nodiscard]]
     size_t operation_count() const;
 
+    /// The script compiled for the active forks, as run by evaluate().
+    [[nodiscard]]
+    machine::bytecode const& get_bytecode() const;
+
     /// Instructions.
     code evaluate();
     code evaluate(operation const& op);
     bool increment_operation_count(operation const& op);
+    bool increment_operation_count(opcode code);
     bool increment_operation_count(int32_t public_keys);
+
+    /// Counts the given number of counted operations at once.
+    bool add_operation_count(size_t counted);
+
     bool set_jump_register(operation const& op, int32_t offset);
 
+    /// The jump register as the bytecode instruction index.
+    bool set_jump_register(size_t index, int32_t offset);
+
     // Primary stack.
     //-------------------------------------------------------------------------
 
@@ -129,15 +164,22 @@ public:
     void push_move(value_type&& item);
     void push_copy(value_type const& item);
 
+    /// Push the minimal script number encoding of the value.
+    void push_number(int64_t value);
+
     /// Primary pop.
-    data_chunk pop();
+    value_type pop();
     bool pop(int32_t& out_value);
     bool pop(int64_t& out_value);
     bool pop(number& out_number, size_t maximum_size);
     bool pop_binary(number& first, number& second);
     bool pop_ternary(number& first, number& second, number& third);
+
+    /// Script numbers of max_integer_size_legacy bytes, read in place.
+    bool pop_binary(int64_t& first, int64_t& second);
+    bool pop_ternary(int64_t& first, int64_t& second, int64_t& third);
     bool pop_position(stack_iterator& out_position);
-    bool pop(data_stack& section, size_t count);
+    bool pop(element_stack& section, size_t count);
 
     /// Primary push/pop optimizations (active).
     void duplicate(size_t index);
@@ -169,8 +211,8 @@ public:
 
     value_type& item(size_t index);
 
-    data_chunk const& top() const;
-    data_chunk& top();
+    value_type const& top() const;
+    value_type& top();
     bool top(number& out_number, size_t maximum_size) const;
 
     [[nodiscard]]
@@ -184,6 +226,10 @@ public:
     [[nodiscard]]
     operation::list subscript() const;
 
+    /// The script from the jump register, sliced from the script bytes.
+    [[nodiscard]]
+    chain::script script_code() const;
+
     [[nodiscard]]
     size_t size() const;
 
@@ -229,6 +275,7 @@ private:
 
     chain::script const& script_;
     chain::transaction const& transaction_;
+    chain::sighash_context const* sighash_context_{nullptr};
     uint32_t const input_index_{0};
     uint32_t const forks_{0};
     uint64_t const value_{0};
@@ -237,11 +284,13 @@ private:
     script_version version_{script_version::unversioned};
 #endif // ! KTH_CURRENCY_BCH
 
+    machine::bytecode bytecode_;
+    machine::bytecode const* shared_bytecode_{nullptr};
     size_t negative_count_{0};
     size_t operation_count_{0};
-    op_iterator jump_;
-    data_stack primary_;
-    data_stack alternate_;
+    size_t jump_{0};
+    element_stack primary_;
+    element_stack alternate_;
     bool_stack condition_;
 
     metrics metrics_;
@@ -0,0 +1,62 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MACHINE_SCRIPT_NUMBER_HPP
+#define KTH_DOMAIN_MACHINE_SCRIPT_NUMBER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <kth/domain/machine/stack_element.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain::machine {
+
+/// Script number arithmetic on the bytes of stack elements.
+/// Operands are at most max_number_size_64_bits bytes, so the values fit an
+/// int64_t: decoding reads the bytes in place and encoding writes into the
+/// inline storage of a stack element, neither allocates.
+/// The encoding matches infrastructure::machine::number (little endian sign
+/// and magnitude, minimal on output), the checked operations match its
+/// safe_add, safe_sub and safe_mul (int64 minimum is out of range).
+class script_number {
+public:
+    /// A 64 bit magnitude plus the sign byte.
+    static constexpr size_t max_encoded_size = 9;
+
+    /// False if the data exceeds maximum_size bytes.
+    [[nodiscard]]
+    static
+    bool decode(int64_t& out, byte_span data, size_t maximum_size);
+
+    static
+    void encode(stack_element& out, int64_t value);
+
+    [[nodiscard]]
+    static
+    size_t encoded_size(int64_t value);
+
+    /// Trims the bytes to the minimal encoding of their value, in place.
+    static
+    void minimally_encode(stack_element& data);
+
+    [[nodiscard]]
+    static
+    std::optional<int64_t> add(int64_t left, int64_t right);
+
+    [[nodiscard]]
+    static
+    std::optional<int64_t> sub(int64_t left, int64_t right);
+
+    [[nodiscard]]
+    static
+    std::optional<int64_t> mul(int64_t left, int64_t right);
+};
+
+} // namespace kth::domain::machine
+
+#include <kth/domain/impl/machine/script_number.ipp>
+
+#endif // KTH_DOMAIN_MACHINE_SCRIPT_NUMBER_HPP
@@ -0,0 +1,47 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MACHINE_SIGNATURE_CACHE_HPP
+#define KTH_DOMAIN_MACHINE_SIGNATURE_CACHE_HPP
+
+#include <cstddef>
+
+#include <kth/domain/define.hpp>
+#include <kth/domain/math/sha256.hpp>
+#include <kth/domain/utility/cuckoo_cache.hpp>
+
+#include <kth/infrastructure/hash_define.hpp>
+#include <kth/infrastructure/math/elliptic_curve.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain::machine {
+
+/// The set of valid (signature hash, public key, signature) triples, so that
+/// the signatures of transactions accepted to the mempool are not verified
+/// again when their block is connected.
+/// Entries are salted sha256 digests of the triple, the salt is random per
+/// cache so the slots cannot be targeted.
+/// Thread safe.
+class KD_API signature_cache : public cuckoo_cache {
+public:
+    static constexpr size_t default_memory = 32 * 1024 * 1024;
+
+    explicit
+    signature_cache(size_t memory = default_memory, size_t shards = 16);
+
+    /// The cache consulted by script::check_signature.
+    static
+    signature_cache& global();
+
+    /// The salted entry of the triple.
+    [[nodiscard]]
+    hash_digest entry(hash_digest const& sighash, byte_span public_key, ec_signature const& signature) const;
+
+private:
+    sha256_context salted_;
+};
+
+} // namespace kth::domain::machine
+
+#endif // KTH_DOMAIN_MACHINE_SIGNATURE_CACHE_HPP
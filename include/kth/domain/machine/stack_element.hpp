@@ -0,0 +1,132 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MACHINE_STACK_ELEMENT_HPP
+#define KTH_DOMAIN_MACHINE_STACK_ELEMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory_resource>
+#include <vector>
+
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain::machine {
+
+/// A script stack item. Items up to inline_capacity bytes (public keys,
+/// signatures, hashes, numbers) are stored in place, larger items are
+/// allocated from the memory resource of the item, which is the resource of
+/// the stack that holds it (see element_stack).
+class stack_element {
+public:
+    using value_type = uint8_t;
+    using size_type = size_t;
+    using iterator = uint8_t*;
+    using const_iterator = uint8_t const*;
+    using allocator_type = std::pmr::polymorphic_allocator<uint8_t>;
+
+    static constexpr size_t inline_capacity = 80;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    stack_element() = default;
+    explicit
+    stack_element(allocator_type allocator);
+
+    stack_element(std::initializer_list<uint8_t> values, allocator_type allocator = {});
+    stack_element(byte_span data, allocator_type allocator = {});
+    stack_element(data_chunk const& data, allocator_type allocator = {});
+
+    stack_element(stack_element const& x);
+    stack_element(stack_element const& x, allocator_type allocator);
+    stack_element(stack_element&& x) noexcept;
+    stack_element(stack_element&& x, allocator_type allocator);
+
+    ~stack_element();
+
+    // Operators.
+    //-------------------------------------------------------------------------
+
+    stack_element& operator=(stack_element const& x);
+    stack_element& operator=(stack_element&& x);
+
+    friend
+    bool operator==(stack_element const& x, stack_element const& y);
+
+    uint8_t& operator[](size_t index);
+    uint8_t operator[](size_t index) const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    allocator_type get_allocator() const;
+
+    [[nodiscard]]
+    bool empty() const;
+
+    [[nodiscard]]
+    size_t size() const;
+
+    [[nodiscard]]
+    size_t capacity() const;
+
+    /// True if the bytes are stored in place.
+    [[nodiscard]]
+    bool is_inline() const;
+
+    uint8_t* data();
+
+    [[nodiscard]]
+    uint8_t const* data() const;
+
+    iterator begin();
+    iterator end();
+
+    [[nodiscard]]
+    const_iterator begin() const;
+
+    [[nodiscard]]
+    const_iterator end() const;
+
+    uint8_t& back();
+
+    [[nodiscard]]
+    uint8_t back() const;
+
+    /// A copy of the bytes, for the interfaces that take a data_chunk.
+    [[nodiscard]]
+    data_chunk to_chunk() const;
+
+    // Modifiers.
+    //-------------------------------------------------------------------------
+
+    void assign(byte_span data);
+    void reserve(size_t size);
+    void resize(size_t size);
+    void clear();
+    void push_back(uint8_t value);
+    iterator insert(const_iterator position, const_iterator first, const_iterator last);
+
+private:
+    void grow(size_t capacity);
+    void release();
+
+    allocator_type allocator_{};
+    uint8_t* heap_{nullptr};
+    uint32_t size_{0};
+    uint32_t capacity_{inline_capacity};
+    uint8_t inline_[inline_capacity];
+};
+
+/// The items of an element_stack share its memory resource.
+using element_stack = std::pmr::vector<stack_element>;
+
+} // namespace kth::domain::machine
+
+#include <kth/domain/impl/machine/stack_element.ipp>
+
+#endif // KTH_DOMAIN_MACHINE_STACK_ELEMENT_HPP
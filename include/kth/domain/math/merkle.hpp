@@ -0,0 +1,27 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MATH_MERKLE_HPP
+#define KTH_DOMAIN_MATH_MERKLE_HPP
+
+#include <cstddef>
+
+#include <kth/domain/define.hpp>
+
+#include <kth/infrastructure/math/hash.hpp>
+
+namespace kth::domain {
+
+/// The merkle root of the leaves, an odd last node is paired with itself.
+/// Returns null_hash if there are no leaves.
+/// Every level is hashed in place over the leaves buffer, pairs of nodes are
+/// hashed together by the multi-buffer double_sha256_64 kernels.
+/// With threads > 1 and a large enough tree the lower levels are split in
+/// independent subtrees, hashed concurrently.
+KD_API
+hash_digest merkle_root(hash_list leaves, size_t threads = 1);
+
+} // namespace kth::domain
+
+#endif // KTH_DOMAIN_MATH_MERKLE_HPP
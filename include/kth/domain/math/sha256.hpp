@@ -0,0 +1,120 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MATH_SHA256_HPP
+#define KTH_DOMAIN_MATH_SHA256_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <kth/domain/define.hpp>
+
+#include <kth/infrastructure/hash_define.hpp>
+#include <kth/infrastructure/utility/data.hpp>
+
+namespace kth::domain {
+
+/// Incremental SHA-256.
+/// The context is a plain value: a copy taken after writing a common prefix
+/// is a midstate that can be resumed any number of times.
+/// It also models the writer used by the to_data(W&) templates, so entities
+/// can be hashed directly, without an intermediate serialization.
+class KD_API sha256_context {
+public:
+    static constexpr size_t block_size = 64;
+    using state_type = std::array<uint32_t, 8>;
+    using block_type = std::array<uint8_t, block_size>;
+
+    sha256_context();
+
+    /// Compress whole 64 byte blocks into the state.
+    static
+    void transform(state_type& state, uint8_t const* blocks, size_t count);
+
+    // Hashing.
+    //-------------------------------------------------------------------------
+
+    void write(uint8_t const* data, size_t size);
+
+    /// The number of bytes written.
+    [[nodiscard]]
+    uint64_t size() const;
+
+    /// sha256 of the bytes written, the context is not modified.
+    [[nodiscard]]
+    hash_digest finalize() const;
+
+    /// sha256(sha256) of the bytes written, the context is not modified.
+    [[nodiscard]]
+    hash_digest finalize_double() const;
+
+    // Writer.
+    //-------------------------------------------------------------------------
+
+    void write_bytes(data_slice data);
+    void write_bytes(uint8_t const* data, size_t size);
+    void write_byte(uint8_t value);
+    void write_hash(hash_digest const& value);
+    void write_2_bytes_little_endian(uint16_t value);
+    void write_4_bytes_little_endian(uint32_t value);
+    void write_8_bytes_little_endian(uint64_t value);
+    void write_variable_little_endian(uint64_t value);
+    void write_size_little_endian(uint64_t value);
+    void write_string(std::string const& value);
+
+    template <typename Integer>
+    void write_little_endian(Integer value) {
+        static_assert(std::is_integral_v<Integer>);
+        uint8_t bytes[sizeof(Integer)];
+        for (size_t i = 0; i < sizeof(Integer); ++i) {
+            bytes[i] = uint8_t(uint64_t(value) >> (8 * i));
+        }
+        write(bytes, sizeof(Integer));
+    }
+
+private:
+    void finalize(hash_digest& out) const;
+
+    state_type state_;
+    block_type buffer_;
+    uint64_t size_{0};
+};
+
+/// sha256(sha256) of count consecutive 64 byte messages (such as pairs of
+/// merkle nodes) into count consecutive 32 byte digests.
+/// Independent messages are hashed in parallel by the widest multi-buffer
+/// kernel the cpu supports (AVX-512, AVX2, SSE4.1), with a SHA-NI or portable
+/// kernel for the remainder. The kernels are selected once, at first use.
+/// out may be in, each digest only overwrites already consumed input.
+KD_API
+void double_sha256_64(uint8_t* out, uint8_t const* in, size_t count);
+
+/// sha256(sha256) of count independent messages of any size, such as the
+/// serialized transactions of a block. Messages are interleaved over the
+/// lanes of the multi-buffer kernels, a lane moves on to the next message as
+/// soon as it completes one.
+KD_API
+void double_sha256(hash_digest* out, data_slice const* messages, size_t count);
+
+/// The name of the selected kernels, for diagnostics.
+KD_API
+char const* sha256_implementation();
+
+/// The names of the kernels the cpu supports, the selected ones first, then
+/// each kernel on its own, for testing and benchmarking them.
+KD_API
+std::vector<char const*> sha256_implementations();
+
+/// Selects kernels by name (see sha256_implementations), false if the cpu
+/// does not support them. Not safe while other threads are hashing.
+KD_API
+bool select_sha256_implementation(char const* name);
+
+} // namespace kth::domain
+
+#endif // KTH_DOMAIN_MATH_SHA256_HPP
@@ -0,0 +1,40 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MATH_SIP_HASH_HPP
+#define KTH_DOMAIN_MATH_SIP_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <kth/domain/define.hpp>
+#include <kth/infrastructure/hash_define.hpp>
+
+namespace kth::domain {
+
+/// SipHash-2-4 with the key (k0, k1) of count 32 byte values (transaction
+/// hashes, as for compact block short ids) into out, the same as count calls
+/// to sip_hash_uint256. Values are hashed in parallel by the widest kernel
+/// the cpu supports (AVX-512, AVX2), with a portable kernel for the remainder.
+KD_API
+void sip_hash_uint256_batch(uint64_t* out, uint64_t k0, uint64_t k1, hash_digest const* values, size_t count);
+
+/// The name of the selected kernel, for diagnostics.
+KD_API
+char const* sip_hash_implementation();
+
+/// The names of the kernels the cpu supports, the selected one first, for
+/// testing and benchmarking them.
+KD_API
+std::vector<char const*> sip_hash_implementations();
+
+/// Selects a kernel by name (see sip_hash_implementations), false if the cpu
+/// does not support it. Not safe while other threads are hashing.
+KD_API
+bool select_sip_hash_implementation(char const* name);
+
+} // namespace kth::domain
+
+#endif // KTH_DOMAIN_MATH_SIP_HASH_HPP
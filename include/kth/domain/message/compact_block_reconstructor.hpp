@@ -0,0 +1,128 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_MESSAGE_COMPACT_BLOCK_RECONSTRUCTOR_HPP
+#define KTH_DOMAIN_MESSAGE_COMPACT_BLOCK_RECONSTRUCTOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <kth/domain/chain/block.hpp>
+#include <kth/domain/chain/transaction.hpp>
+#include <kth/domain/define.hpp>
+#include <kth/domain/message/block_transactions.hpp>
+#include <kth/domain/message/compact_block.hpp>
+#include <kth/domain/message/get_block_transactions.hpp>
+#include <kth/infrastructure/error.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+
+#include <kth/domain/concepts.hpp>
+
+namespace kth::domain::message {
+
+/// Rebuilds a block announced by a compact_block (BIP152) from the
+/// transactions the node already has, usually a mempool snapshot.
+/// The short ids of the block are indexed once, then each pool transaction
+/// is looked up by its short id. The transactions not found (or ambiguous) are
+/// requested with get_block_transactions and completed with the
+/// block_transactions answer.
+/// As on the wire, the prefilled and the requested indexes are differentially
+/// encoded (each one is the distance to the previous index plus one).
+class KD_API compact_block_reconstructor {
+public:
+    using short_id = compact_block::short_id;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    /// Computes the SipHash keys and places the prefilled transactions.
+    explicit
+    compact_block_reconstructor(compact_block const& block);
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    /// False if the indexes do not fit the block or two short ids repeat, the
+    /// full block must be requested instead.
+    [[nodiscard]]
+    bool is_valid() const;
+
+    [[nodiscard]]
+    hash_digest const& block_hash() const;
+
+    /// The number of transactions of the block.
+    [[nodiscard]]
+    size_t size() const;
+
+    /// The number of transactions still unknown.
+    [[nodiscard]]
+    size_t missing() const;
+
+    /// The number of slots matched by two different pool transactions.
+    [[nodiscard]]
+    size_t collisions() const;
+
+    /// The short id of a transaction hash with the keys of this block.
+    [[nodiscard]]
+    short_id to_short_id(hash_digest const& hash) const;
+
+    // Reconstruction.
+    //-------------------------------------------------------------------------
+
+    /// Matches the pool transactions against the short ids, it can be called
+    /// with several pools. A slot matched by two different transactions is
+    /// left unknown, so it is requested.
+    void fill(std::span<chain::transaction const> pool);
+
+    /// As fill(pool), with the short ids of the pool transactions (in pool
+    /// order) computed by the caller.
+    void fill(std::span<chain::transaction const> pool, std::span<short_id const> ids);
+
+    /// The request for the unknown transactions.
+    [[nodiscard]]
+    get_block_transactions request() const;
+
+    /// Completes the block with the requested transactions, in request order.
+    /// Fails with error::invalid_compact_block if the answer does not fit the
+    /// request and with error::merkle_mismatch if a short id matched a wrong
+    /// transaction; in both cases the full block must be requested.
+    expect<chain::block> complete(block_transactions const& response) const;
+
+    /// The block, if no transaction is missing.
+    expect<chain::block> complete() const;
+
+private:
+    // The slot of a short id, open addressing over the (uniform) short ids.
+    struct entry {
+        short_id id;
+        uint32_t slot;
+    };
+
+    // A slot is known, ambiguous (two matches) or unknown.
+    enum class state : uint8_t { unknown, known, ambiguous };
+
+    static constexpr short_id empty_id = max_uint64;
+    static constexpr short_id short_id_mask = 0xffffffffffff;
+    static constexpr size_t fill_chunk = 256;
+
+    bool index(compact_block const& block);
+    [[nodiscard]]
+    entry const* find(short_id id) const;
+
+    chain::header header_;
+    hash_digest block_hash_;
+    uint64_t k0_{0};
+    uint64_t k1_{0};
+    bool valid_{false};
+    size_t collisions_{0};
+    std::vector<entry> table_;
+    std::vector<state> states_;
+    chain::transaction::list transactions_;
+};
+
+} // namespace kth::domain::message
+
+#endif // KTH_DOMAIN_MESSAGE_COMPACT_BLOCK_RECONSTRUCTOR_HPP
@@ -52,6 +52,26 @@ public:
     [[nodiscard]]
     bool is_sequential() const;
 
+    /// Computes and caches the hash of every header not yet hashed. Headers
+    /// are hashed in multi-buffer batches, split across threads for large
+    /// messages.
+    void hash_elements(size_t threads = 1) const;
+
+    /// The context free checks of all headers in one pass over their batch
+    /// computed hashes: each header links to the previous one
+    /// (error::orphan_block) and passes header::check.
+    [[nodiscard]]
+    code check(bool retarget = false, size_t threads = 1) const;
+
+    /// The contextual checks of all headers (header::accept), starting from
+    /// the memory pool state at the height of the first one. The state of
+    /// each next height is promoted from the previous one in memory (see
+    /// chain_state::from_top_ptr), without an ABLA state as headers do not
+    /// depend on it. error::operation_failed if a state cannot be promoted,
+    /// then the states must be populated from the store.
+    [[nodiscard]]
+    code accept(chain::chain_state const& pool) const;
+
     void to_hashes(hash_list& out) const;
     void to_inventory(inventory_vector::list& out, inventory::type_id type) const;
 
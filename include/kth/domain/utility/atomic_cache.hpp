@@ -0,0 +1,118 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_UTILITY_ATOMIC_CACHE_HPP
+#define KTH_DOMAIN_UTILITY_ATOMIC_CACHE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace kth::domain {
+
+/// A lazily computed value, published once with release/acquire ordering.
+/// Readers never lock or allocate. Threads that miss the cache concurrently
+/// compute the value independently, the first one to finish publishes it.
+/// Copies carry the published value, if any.
+/// store and reset are not safe concurrently with readers, as with any other
+/// mutation of the owning object.
+template <typename T>
+class atomic_cache {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    atomic_cache() = default;
+
+    explicit
+    atomic_cache(T const& value)
+        : value_(value)
+        , state_(ready)
+    {}
+
+    atomic_cache(atomic_cache const& x) {
+        copy(x);
+    }
+
+    atomic_cache(atomic_cache&& x) noexcept {
+        copy(x);
+    }
+
+    atomic_cache& operator=(atomic_cache const& x) {
+        copy(x);
+        return *this;
+    }
+
+    atomic_cache& operator=(atomic_cache&& x) noexcept {
+        copy(x);
+        return *this;
+    }
+
+    /// The cached value, computing and publishing it if not yet published.
+    template <typename Compute>
+    T get(Compute&& compute) const {
+        if (state_.load(std::memory_order_acquire) == ready) {
+            return value_;
+        }
+
+        auto const value = std::forward<Compute>(compute)();
+        publish(value);
+        return value;
+    }
+
+    /// Publishes a value computed elsewhere, unless one is already published.
+    /// Safe concurrently with readers.
+    void publish(T const& value) const {
+        auto expected = empty;
+
+        if (state_.compare_exchange_strong(expected, busy, std::memory_order_acquire, std::memory_order_relaxed)) {
+            value_ = value;
+            state_.store(ready, std::memory_order_release);
+        }
+    }
+
+    [[nodiscard]]
+    std::optional<T> load() const {
+        if (state_.load(std::memory_order_acquire) == ready) {
+            return value_;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]]
+    bool has_value() const {
+        return state_.load(std::memory_order_acquire) == ready;
+    }
+
+    void store(T const& value) {
+        value_ = value;
+        state_.store(ready, std::memory_order_release);
+    }
+
+    void reset() {
+        state_.store(empty, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint8_t empty = 0;
+    static constexpr uint8_t busy = 1;
+    static constexpr uint8_t ready = 2;
+
+    void copy(atomic_cache const& x) {
+        if (x.state_.load(std::memory_order_acquire) == ready) {
+            value_ = x.value_;
+            state_.store(ready, std::memory_order_relaxed);
+        } else {
+            state_.store(empty, std::memory_order_relaxed);
+        }
+    }
+
+    mutable T value_{};
+    mutable std::atomic<uint8_t> state_{empty};
+};
+
+} // namespace kth::domain
+
+#endif // KTH_DOMAIN_UTILITY_ATOMIC_CACHE_HPP
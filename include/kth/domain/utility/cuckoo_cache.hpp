@@ -0,0 +1,83 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_UTILITY_CUCKOO_CACHE_HPP
+#define KTH_DOMAIN_UTILITY_CUCKOO_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#include <kth/domain/define.hpp>
+
+#include <kth/infrastructure/hash_define.hpp>
+
+namespace kth::domain {
+
+/// A bounded set of digests, as the entries of the validation caches.
+/// The entries must be uniformly distributed (salted hashes), their bytes
+/// select the shard and the two candidate slots of the entry. Each shard is
+/// a cuckoo table under its own lock. Inserting into a full table evicts an
+/// entry, so the set never grows past its memory budget.
+/// Thread safe.
+class KD_API cuckoo_cache {
+public:
+    explicit
+    cuckoo_cache(size_t memory, size_t shards = 16);
+
+    cuckoo_cache(cuckoo_cache const&) = delete;
+    cuckoo_cache& operator=(cuckoo_cache const&) = delete;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    /// The number of entries that fit the memory budget.
+    [[nodiscard]]
+    size_t capacity() const;
+
+    [[nodiscard]]
+    uint64_t hits() const;
+
+    [[nodiscard]]
+    uint64_t misses() const;
+
+    // Cache.
+    //-------------------------------------------------------------------------
+
+    /// Counts a hit or a miss.
+    [[nodiscard]]
+    bool contains(hash_digest const& entry) const;
+
+    void insert(hash_digest const& entry);
+
+    /// Drops all entries and clears the counters, the memory is kept.
+    void clear();
+
+    /// Replaces the table with an empty one of the given memory budget.
+    void resize(size_t memory);
+
+private:
+    struct shard {
+        mutable std::shared_mutex mutex;
+        std::vector<hash_digest> slots;
+    };
+
+    [[nodiscard]]
+    shard& shard_of(hash_digest const& entry) const;
+
+    static
+    std::pair<size_t, size_t> slots_of(hash_digest const& entry, size_t size);
+
+    std::vector<std::unique_ptr<shard>> shards_;
+    mutable std::atomic<uint64_t> hits_{0};
+    mutable std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace kth::domain
+
+#endif // KTH_DOMAIN_UTILITY_CUCKOO_CACHE_HPP
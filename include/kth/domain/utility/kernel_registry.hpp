@@ -0,0 +1,81 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_UTILITY_KERNEL_REGISTRY_HPP
+#define KTH_DOMAIN_UTILITY_KERNEL_REGISTRY_HPP
+
+#include <atomic>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace kth::domain {
+
+/// The named kernels of an algorithm that the cpu supports and the one in
+/// use, which any thread can change (to compare or test each kernel).
+/// Kernel is an aggregate with a char const* name.
+template <typename Kernel>
+class kernel_registry {
+public:
+    /// The first kernel is the default, the later ones with its name (the
+    /// same kernel listed again on its own) are dropped.
+    explicit
+    kernel_registry(std::vector<Kernel> kernels)
+        : available_(unique(std::move(kernels)))
+        , selected_(&available_.front())
+    {}
+
+    kernel_registry(kernel_registry const&) = delete;
+    kernel_registry& operator=(kernel_registry const&) = delete;
+
+    [[nodiscard]]
+    Kernel const& selected() const {
+        return *selected_.load(std::memory_order_acquire);
+    }
+
+    /// The names of the kernels, the default first.
+    [[nodiscard]]
+    std::vector<char const*> names() const {
+        std::vector<char const*> result;
+        result.reserve(available_.size());
+        for (auto const& kernel : available_) {
+            result.push_back(kernel.name);
+        }
+
+        return result;
+    }
+
+    /// False if there is no kernel with the name.
+    bool select(char const* name) {
+        for (auto const& kernel : available_) {
+            if (std::string_view(kernel.name) == name) {
+                selected_.store(&kernel, std::memory_order_release);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    static
+    std::vector<Kernel> unique(std::vector<Kernel> kernels) {
+        std::vector<Kernel> result;
+        result.reserve(kernels.size());
+        for (auto& kernel : kernels) {
+            if (result.empty() || std::string_view(kernel.name) != result.front().name) {
+                result.push_back(std::move(kernel));
+            }
+        }
+
+        return result;
+    }
+
+    std::vector<Kernel> const available_;
+    std::atomic<Kernel const*> selected_;
+};
+
+} // namespace kth::domain
+
+#endif // KTH_DOMAIN_UTILITY_KERNEL_REGISTRY_HPP
@@ -0,0 +1,37 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_UTILITY_PARALLEL_HPP
+#define KTH_DOMAIN_UTILITY_PARALLEL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <kth/domain/define.hpp>
+
+namespace kth::domain {
+
+/// The number of threads to use for a requested number, zero means one per
+/// hardware thread. Always one where threads are not available.
+KD_API
+size_t thread_count(size_t threads);
+
+/// Runs function(first, last) over contiguous ranges that split [0, count),
+/// one range per thread (the calling thread runs the first one). Below the
+/// minimum items per thread the threads cost more than they save, so the
+/// items are then run as a single range on the calling thread.
+template <typename Function>
+void parallel_ranges(size_t count, size_t threads, size_t minimum, Function const& function);
+
+/// Double SHA-256 hashes the wire serialization of the entities and caches
+/// the hashes on them. Each range of parallel_ranges is serialized once into
+/// its own arena and hashed in a batch.
+template <typename Entity>
+void cache_hashes(std::vector<Entity const*> const& entities, size_t threads, size_t minimum);
+
+} // namespace kth::domain
+
+#include <kth/domain/impl/utility/parallel.ipp>
+
+#endif // KTH_DOMAIN_UTILITY_PARALLEL_HPP
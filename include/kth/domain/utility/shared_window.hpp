@@ -0,0 +1,125 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef KTH_DOMAIN_UTILITY_SHARED_WINDOW_HPP
+#define KTH_DOMAIN_UTILITY_SHARED_WINDOW_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+
+namespace kth::domain {
+
+/// A sliding window of values (push_back, pop_front) whose copies share their
+/// storage. A copy is a reference count increment, and a window that appends
+/// at the end of the storage it shares keeps sharing it, so a chain of
+/// windows each one value ahead of the previous (the chain state histories of
+/// consecutive heights) lives in a single buffer. The values are moved to a
+/// new buffer, about twice the window size, when the buffer is full or when
+/// another window already appended at that position.
+/// Copies may be used from different threads, a window may not.
+template <typename T>
+class shared_window {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using iterator = T*;
+    using const_iterator = T const*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    // Constructors.
+    //-------------------------------------------------------------------------
+
+    shared_window() = default;
+    shared_window(std::initializer_list<T> values);
+
+    // Operators.
+    //-------------------------------------------------------------------------
+
+    template <typename U>
+    friend
+    bool operator==(shared_window<U> const& x, shared_window<U> const& y);
+
+    /// The mutable accessors unshare the storage.
+    T& operator[](size_t index);
+    T const& operator[](size_t index) const;
+
+    // Properties.
+    //-------------------------------------------------------------------------
+
+    [[nodiscard]]
+    bool empty() const;
+
+    [[nodiscard]]
+    size_t size() const;
+
+    /// True if the storage is shared with another window.
+    [[nodiscard]]
+    bool is_shared() const;
+
+    [[nodiscard]]
+    T const& front() const;
+
+    [[nodiscard]]
+    T const& back() const;
+
+    iterator begin();
+    iterator end();
+
+    [[nodiscard]]
+    const_iterator begin() const;
+
+    [[nodiscard]]
+    const_iterator end() const;
+
+    reverse_iterator rbegin();
+    reverse_iterator rend();
+
+    [[nodiscard]]
+    const_reverse_iterator rbegin() const;
+
+    [[nodiscard]]
+    const_reverse_iterator rend() const;
+
+    // Modifiers.
+    //-------------------------------------------------------------------------
+
+    void push_back(T value);
+    void pop_front();
+
+    /// New values are value initialized.
+    void resize(size_t size);
+    void clear();
+
+private:
+    static constexpr size_t minimum_capacity = 16;
+
+    struct buffer {
+        explicit
+        buffer(size_t size);
+
+        std::unique_ptr<T[]> values;
+        size_t const capacity;
+
+        // The positions in use by any window, a position is claimed once.
+        std::atomic<size_t> used{0};
+    };
+
+    // Moves the window to a new buffer of at least capacity values.
+    void reallocate(size_t capacity);
+    void detach();
+
+    std::shared_ptr<buffer> buffer_;
+    size_t first_{0};
+    size_t size_{0};
+};
+
+} // namespace kth::domain
+
+#include <kth/domain/impl/utility/shared_window.ipp>
+
+#endif // KTH_DOMAIN_UTILITY_SHARED_WINDOW_HPP
@@ -0,0 +1,267 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/abla_schedule.hpp>
+
+#include <array>
+#include <utility>
+
+#include <kth/infrastructure/utility/assert.hpp>
+#include <kth/infrastructure/utility/endian.hpp>
+
+namespace kth::domain::chain::abla {
+
+namespace {
+
+// The config fields, the interval, the anchor height and the block count.
+constexpr size_t fixed_fields = 12;
+constexpr size_t state_fields = 3;
+
+void write_8_bytes(data_chunk& out, uint64_t value) {
+    extend_data(out, to_little_endian(value));
+}
+
+void write_state(data_chunk& out, state const& value) {
+    write_8_bytes(out, value.block_size);
+    write_8_bytes(out, value.control_block_size);
+    write_8_bytes(out, value.elastic_buffer_size);
+}
+
+template <size_t Size>
+expect<std::array<uint64_t, Size>> read_fields(byte_reader& reader) {
+    std::array<uint64_t, Size> fields;
+
+    for (auto& field : fields) {
+        auto const value = reader.read_little_endian<uint64_t>();
+        if ( ! value) {
+            return make_unexpected(value.error());
+        }
+        field = *value;
+    }
+
+    return fields;
+}
+
+} // namespace
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+schedule::schedule(config const& cfg, size_t anchor_height, state const& anchor_state, size_t interval)
+    : config_(cfg)
+    , interval_(interval)
+    , anchor_height_(anchor_height)
+    , top_(anchor_state)
+    , snapshots_{anchor_state}
+{
+    KTH_ASSERT(interval != 0);
+}
+
+// Deserialization.
+//-----------------------------------------------------------------------------
+
+expect<schedule> schedule::from_data(byte_reader& reader) {
+    auto const fixed = read_fields<fixed_fields>(reader);
+    if ( ! fixed) {
+        return make_unexpected(fixed.error());
+    }
+
+    auto const& fields = *fixed;
+    config const cfg {fields[0], fields[1], fields[2], fields[3], fields[4], fields[5], fields[6], fields[7], fields[8]};
+    auto const interval = fields[9];
+    auto const anchor_height = fields[10];
+    auto const count = fields[11];
+
+    // A zero divisor in next() or a zero interval would not replay.
+    if (validate(cfg) != config_validity::valid || interval == 0) {
+        return make_unexpected(error::invalid_size);
+    }
+
+    // The count is not trusted to reserve, a short encoding fails to read.
+    std::vector<uint64_t> block_sizes;
+    for (uint64_t index = 0; index < count; ++index) {
+        auto const block_size = reader.read_little_endian<uint64_t>();
+        if ( ! block_size) {
+            return make_unexpected(block_size.error());
+        }
+        block_sizes.push_back(*block_size);
+    }
+
+    std::vector<state> snapshots;
+    snapshots.reserve(count / interval + 1);
+    for (uint64_t index = 0; index <= count / interval; ++index) {
+        auto const values = read_fields<state_fields>(reader);
+        if ( ! values) {
+            return make_unexpected(values.error());
+        }
+
+        state snapshot;
+        snapshot.block_size = (*values)[0];
+        snapshot.control_block_size = (*values)[1];
+        snapshot.elastic_buffer_size = (*values)[2];
+        if (validate(snapshot, cfg) != state_validity::valid) {
+            return make_unexpected(error::invalid_size);
+        }
+        snapshots.push_back(snapshot);
+    }
+
+    // The block sizes are replayed from the anchor, each snapshot must be the
+    // replayed state, so a corrupt or stale encoding is not loaded.
+    auto top = snapshots.front();
+    for (uint64_t index = 0; index < count; ++index) {
+        auto const following = next(top, cfg, block_sizes[index]);
+        if ( ! following) {
+            return make_unexpected(error::invalid_size);
+        }
+        top = *following;
+
+        if ((index + 1) % interval == 0) {
+            auto const& snapshot = snapshots[(index + 1) / interval];
+            if (snapshot.block_size != top.block_size ||
+                snapshot.control_block_size != top.control_block_size ||
+                snapshot.elastic_buffer_size != top.elastic_buffer_size) {
+                return make_unexpected(error::invalid_size);
+            }
+        }
+    }
+
+    schedule result(cfg, anchor_height, snapshots.front(), interval);
+    result.top_ = top;
+    result.block_sizes_ = std::move(block_sizes);
+    result.snapshots_ = std::move(snapshots);
+    return result;
+}
+
+// Serialization.
+//-----------------------------------------------------------------------------
+
+data_chunk schedule::to_data() const {
+    data_chunk data;
+    auto const size = serialized_size();
+    data.reserve(size);
+    to_data(data);
+    KTH_ASSERT(data.size() == size);
+    return data;
+}
+
+void schedule::to_data(data_chunk& out) const {
+    write_8_bytes(out, config_.epsilon0);
+    write_8_bytes(out, config_.beta0);
+    write_8_bytes(out, config_.n0);
+    write_8_bytes(out, config_.gamma_reciprocal);
+    write_8_bytes(out, config_.zeta_xB7);
+    write_8_bytes(out, config_.theta_reciprocal);
+    write_8_bytes(out, config_.delta);
+    write_8_bytes(out, config_.epsilon_max);
+    write_8_bytes(out, config_.beta_max);
+    write_8_bytes(out, interval_);
+    write_8_bytes(out, anchor_height_);
+    write_8_bytes(out, block_sizes_.size());
+
+    for (auto const block_size : block_sizes_) {
+        write_8_bytes(out, block_size);
+    }
+
+    for (auto const& snapshot : snapshots_) {
+        write_state(out, snapshot);
+    }
+}
+
+size_t schedule::serialized_size() const {
+    return sizeof(uint64_t) * (fixed_fields + block_sizes_.size() + state_fields * snapshots_.size());
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+config const& schedule::configuration() const {
+    return config_;
+}
+
+size_t schedule::interval() const {
+    return interval_;
+}
+
+size_t schedule::anchor_height() const {
+    return anchor_height_;
+}
+
+size_t schedule::top_height() const {
+    return anchor_height_ + block_sizes_.size();
+}
+
+state const& schedule::top() const {
+    return top_;
+}
+
+std::optional<state> schedule::at(size_t height) const {
+    if (height < anchor_height_ || height > top_height()) {
+        return std::nullopt;
+    }
+
+    auto const offset = height - anchor_height_;
+    auto const first = offset - offset % interval_;
+    auto current = snapshots_[offset / interval_];
+
+    // The pushed states did not overflow, so neither does their replay.
+    for (auto index = first; index < offset; ++index) {
+        current = *next(current, config_, block_sizes_[index]);
+    }
+
+    return current;
+}
+
+std::optional<uint64_t> schedule::block_size_limit(size_t height) const {
+    auto const current = at(height);
+    if ( ! current) {
+        return std::nullopt;
+    }
+
+    return abla::block_size_limit(*current);
+}
+
+// Modifiers.
+//-----------------------------------------------------------------------------
+
+bool schedule::push(uint64_t block_size) {
+    auto const following = next(top_, config_, block_size);
+    if ( ! following) {
+        return false;
+    }
+
+    top_ = *following;
+    block_sizes_.push_back(block_size);
+
+    if (block_sizes_.size() % interval_ == 0) {
+        snapshots_.push_back(top_);
+    }
+
+    return true;
+}
+
+size_t schedule::push(std::span<uint64_t const> block_sizes) {
+    block_sizes_.reserve(block_sizes_.size() + block_sizes.size());
+    snapshots_.reserve(snapshots_.size() + block_sizes.size() / interval_ + 1);
+
+    size_t pushed = 0;
+    for (auto const block_size : block_sizes) {
+        if ( ! push(block_size)) {
+            break;
+        }
+
+        ++pushed;
+    }
+
+    return pushed;
+}
+
+void schedule::truncate(size_t height) {
+    KTH_ASSERT(height >= anchor_height_ && height <= top_height());
+    auto const offset = height - anchor_height_;
+    top_ = *at(height);
+    block_sizes_.resize(offset);
+    snapshots_.resize(offset / interval_ + 1);
+}
+
+} // namespace kth::domain::chain::abla
@@ -184,35 +184,13 @@ block::block(chain::header const& header, transaction::list&& transactions)
     : block_basis(header, std::move(transactions))
 {}
 
-block::block(block const& x)
-    : block_basis(x)
-    , validation(x.validation)
-{}
-
-block::block(block&& x) noexcept
-    : block_basis(std::move(x))
-    , validation(std::move(x.validation))
-{}
-
-block& block::operator=(block const& x) {
-    block_basis::operator=(x);
-    validation = x.validation;
-    return *this;
-}
-
-block& block::operator=(block&& x) noexcept {
-    block_basis::operator=(std::move(static_cast<block_basis&&>(x)));
-    validation = std::move(x.validation);
-    return *this;
-}
-
 // Deserialization.
 //-----------------------------------------------------------------------------
 
 
-expect<block> block::from_data(byte_reader& reader, bool wire) {
+expect<block> block::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
     auto const start_deserialize = asio::steady_clock::now();
-    auto basis = block_basis::from_data(reader, wire);
+    auto basis = block_basis::from_data(reader, wire, resource);
     auto const end_deserialize = asio::steady_clock::now();
     if ( ! basis) {
         return make_unexpected(basis.error());
@@ -235,57 +213,21 @@ data_chunk block::to_data() const {
 
 // Full block serialization is always canonical encoding.
 size_t block::serialized_size() const {
-    size_t value;
-
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (base_size_) {
-        value = base_size_.value();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if (base_size_) {
-            return base_size_.value();
-        }
-    }
-
-    std::unique_lock lock(mutex_);
-#endif
-
-    value = chain::serialized_size(*this);
-    base_size_ = value;
-
-#if ! defined(__EMSCRIPTEN__)
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-#endif
-
-    return value;
+    return base_size_.get([this] { return chain::serialized_size(*this); });
 }
 
 // TODO(legacy): see set_header comments.
 void block::set_transactions(transaction::list const& value) {
     block_basis::set_transactions(value);
-    total_inputs_ = std::nullopt;
-    base_size_ = std::nullopt;
+    total_inputs_.reset();
+    base_size_.reset();
 }
 
 // TODO(legacy): see set_header comments.
 void block::set_transactions(transaction::list&& value) {
     block_basis::set_transactions(std::move(value));
-    total_inputs_ = std::nullopt;
-    base_size_ = std::nullopt;
+    total_inputs_.reset();
+    base_size_.reset();
 }
 
 // Utilities.
@@ -385,52 +327,23 @@ size_t block::signature_operations() const {
 }
 
 size_t block::total_inputs(bool with_coinbase) const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_inputs_ != std::nullopt) {
-        auto const value = total_inputs_.value();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+    // Only the total with coinbase is cached, the coinbase is excluded on demand.
+    auto const total = total_inputs_.get([this] { return chain::total_inputs(*this, true); });
 
-    auto const value = chain::total_inputs(*this, with_coinbase);
-    total_inputs_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-#else
-    {
-        std::shared_lock lock(mutex_);
-
-        if (total_inputs_) {
-            return total_inputs_.value();
-        }
+    if (with_coinbase || transactions().empty()) {
+        return total;
     }
 
-    std::unique_lock lock(mutex_);
-    if ( ! total_inputs_) {
-        total_inputs_ = chain::total_inputs(*this, with_coinbase);
-    }
-
-    auto value = total_inputs_.value();
-#endif
-
-    return value;
+    return total - transactions().front().inputs().size();
 }
 
 // Validation.
 //-----------------------------------------------------------------------------
 
 // These checks are self-contained; blockchain (and so version) independent.
-code block::check() const {
+code block::check(size_t threads) const {
     validation.start_check = asio::steady_clock::now();
-    return block_basis::check(serialized_size());
+    return block_basis::check(serialized_size(), threads);
 }
 
 code block::accept(bool transactions) const {
@@ -449,4 +362,9 @@ code block::connect() const {
     return state ? block_basis::connect(*state) : error::operation_failed;
 }
 
+code block::connect(verification_pool& pool) const {
+    auto const state = validation.state;
+    return state ? block_basis::connect(*state, pool) : error::operation_failed;
+}
+
 } // namespace kth::domain::chain
@@ -15,6 +15,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include <boost/range/adaptor/reversed.hpp>
 
@@ -22,11 +23,14 @@
 #include <kth/domain/chain/compact.hpp>
 #include <kth/domain/chain/input_point.hpp>
 #include <kth/domain/chain/script.hpp>
+#include <kth/domain/chain/verification_pool.hpp>
 #include <kth/domain/constants.hpp>
 #include <kth/domain/deserialization.hpp>
 #include <kth/domain/machine/opcode.hpp>
 #include <kth/domain/machine/rule_fork.hpp>
+#include <kth/domain/math/merkle.hpp>
 #include <kth/domain/multi_crypto_support.hpp>
+#include <kth/domain/utility/parallel.hpp>
 #include <kth/infrastructure/config/checkpoint.hpp>
 #include <kth/infrastructure/error.hpp>
 #include <kth/infrastructure/formats/base_16.hpp>
@@ -92,12 +96,12 @@ bool block_basis::is_valid() const {
 
 
 // static
-expect<block_basis> block_basis::from_data(byte_reader& reader, bool wire) {
+expect<block_basis> block_basis::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
     auto const hdr = chain::header::from_data(reader, wire);
     if ( ! hdr) {
         return make_unexpected(hdr.error());
     }
-    auto txs = read_collection<chain::transaction>(reader, wire);
+    auto txs = read_pmr_collection<chain::transaction>(reader, resource, wire);
     if ( ! txs) {
         return make_unexpected(txs.error());
     }
@@ -124,9 +128,12 @@ void block_basis::to_data(data_sink& stream) const {
     to_data(sink_w);
 }
 
-hash_list block_basis::to_hashes() const {
+hash_list block_basis::to_hashes(size_t threads) const {
+    hash_transactions(threads);
     hash_list out;
-    out.reserve(transactions_.size());
+
+    // One spare node, so merkle_root can duplicate an odd last node in place.
+    out.reserve(transactions_.size() + 1);
     auto const to_hash = [&out](transaction const& tx) {
         out.push_back(tx.hash());
     };
@@ -234,6 +241,20 @@ bool block_basis::is_final(size_t height, uint32_t block_time) const {
     return std::all_of(txs.begin(), txs.end(), value);
 }
 
+void block_basis::hash_transactions(size_t threads) const {
+    std::vector<transaction const*> pending;
+    pending.reserve(transactions_.size());
+
+    for (auto const& tx : transactions_) {
+        if ( ! tx.is_hash_cached()) {
+            pending.push_back(&tx);
+        }
+    }
+
+    size_t const parallel_transactions = 512;
+    cache_hashes(pending, threads, parallel_transactions);
+}
+
 // Distinctness is defined by transaction hash.
 bool block_basis::is_distinct_transaction_set() const {
     auto const hasher = [](transaction const& tx) { return tx.hash(); };
@@ -245,33 +266,8 @@ bool block_basis::is_distinct_transaction_set() const {
     return distinct_end == hashes.end();
 }
 
-hash_digest block_basis::generate_merkle_root() const {
-    if (transactions_.empty()) {
-        return null_hash;
-    }
-
-    hash_list update;
-    auto merkle = to_hashes();
-
-    // Initial capacity is half of the original list (clear doesn't reset).
-    update.reserve((merkle.size() + 1) / 2);
-
-    while (merkle.size() > 1) {
-        // If number of hashes is odd, duplicate last hash in the list.
-        if (merkle.size() % 2 != 0) {
-            merkle.push_back(merkle.back());
-        }
-
-        for (auto it = merkle.begin(); it != merkle.end(); it += 2) {
-            update.push_back(bitcoin_hash(build_chunk({it[0], it[1]})));
-        }
-
-        std::swap(merkle, update);
-        update.clear();
-    }
-
-    // There is now only one item in the list.
-    return merkle.front();
+hash_digest block_basis::generate_merkle_root(size_t threads) const {
+    return merkle_root(to_hashes(threads), threads);
 }
 
 size_t block_basis::non_coinbase_input_count() const {
@@ -344,8 +340,8 @@ bool block_basis::is_internal_double_spend() const {
     return !distinct;
 }
 
-bool block_basis::is_valid_merkle_root() const {
-    return generate_merkle_root() == header_.merkle();
+bool block_basis::is_valid_merkle_root(size_t threads) const {
+    return generate_merkle_root(threads) == header_.merkle();
 }
 
 // Overflow returns max_uint64.
@@ -413,12 +409,19 @@ code block_basis::connect_transactions(chain_state const& state) const {
     return error::success;
 }
 
+// All (tx, input) pairs of the block are verified concurrently, the result
+// matches the serial overload.
+code block_basis::connect_transactions(chain_state const& state, verification_pool& pool) const {
+    return pool.connect(transactions_, state);
+}
+
 // Validation.
 //-----------------------------------------------------------------------------
 
 // These checks are self-contained; blockchain (and so version) independent.
-code block_basis::check(size_t serialized_size_false) const {
+code block_basis::check(size_t serialized_size_false, size_t threads) const {
     code ec;
+    threads = thread_count(threads);
 
     if ((ec = header_.check())) {
         return ec;
@@ -443,6 +446,9 @@ code block_basis::check(size_t serialized_size_false) const {
         // TODO(legacy): determinable from tx pool graph.
     }
 
+    // The checks below need every txid, compute them in a single batch.
+    hash_transactions(threads);
+
 #if ! defined(KTH_CURRENCY_BCH) // BTC and LTC
     //Note(kth): LTOR (Legacy Transaction ORdering) is a check just for Bitcoin (BTC)
     //               and for BitcoinCash (BCH) before 2018-Nov-15.
@@ -462,7 +468,7 @@ code block_basis::check(size_t serialized_size_false) const {
         // TODO(legacy): relates height to tx.hash(false) (pool cache).
     }
 
-    if ( ! is_valid_merkle_root()) {
+    if ( ! is_valid_merkle_root(threads)) {
         return error::merkle_mismatch;
 
         // We cannot know if bip16 is enabled at this point so we disable it.
@@ -566,6 +572,13 @@ code block_basis::connect(chain_state const& state) const {
     return connect_transactions(state);
 }
 
+code block_basis::connect(chain_state const& state, verification_pool& pool) const {
+    if (state.is_under_checkpoint()) {
+        return error::success;
+    }
+    return connect_transactions(state, pool);
+}
+
 // Non-member functions.
 //-----------------------------------------------------------------------------
 
@@ -0,0 +1,560 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/block_view.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <kth/domain/chain/token_data.hpp>
+#include <kth/domain/constants.hpp>
+#include <kth/domain/math/limits.hpp>
+#include <kth/domain/math/merkle.hpp>
+#include <kth/domain/math/sha256.hpp>
+#include <kth/domain/utility/parallel.hpp>
+#include <kth/infrastructure/utility/assert.hpp>
+#include <kth/infrastructure/utility/endian.hpp>
+
+namespace kth::domain::chain {
+
+namespace {
+
+// Version, input count, output count and locktime.
+constexpr size_t min_transaction_size = 10;
+
+// Hash and index of a wire serialized outpoint.
+constexpr size_t outpoint_size = hash_size + sizeof(uint32_t);
+
+bool is_null_outpoint(uint8_t const* outpoint) {
+    auto const zero = [](uint8_t byte) { return byte == 0; };
+    return from_little_endian_unsafe<uint32_t>(outpoint + hash_size) == point::null_index &&
+        std::all_of(outpoint, outpoint + hash_size, zero);
+}
+
+} // namespace
+
+// input_view.
+//-----------------------------------------------------------------------------
+
+input_view::input_view(block_view const& block, size_t index)
+    : block_(&block)
+    , index_(index)
+{}
+
+output_point input_view::previous_output() const {
+    auto const& entry = block_->inputs_[index_];
+    auto const outpoint = block_->slice(entry.offset, outpoint_size);
+
+    hash_digest hash;
+    std::copy_n(outpoint.begin(), hash_size, hash.begin());
+    return {hash, from_little_endian_unsafe<uint32_t>(outpoint.begin() + hash_size)};
+}
+
+byte_span input_view::script() const {
+    auto const& entry = block_->inputs_[index_];
+    return block_->slice(entry.script_offset, entry.script_size);
+}
+
+uint32_t input_view::sequence() const {
+    auto const& entry = block_->inputs_[index_];
+    auto const bytes = block_->slice(entry.script_offset + entry.script_size, sizeof(uint32_t));
+    return from_little_endian_unsafe<uint32_t>(bytes.begin());
+}
+
+byte_span input_view::data() const {
+    auto const& entry = block_->inputs_[index_];
+    auto const end = entry.script_offset + entry.script_size + sizeof(uint32_t);
+    return block_->slice(entry.offset, end - entry.offset);
+}
+
+// output_view.
+//-----------------------------------------------------------------------------
+
+output_view::output_view(block_view const& block, size_t index)
+    : block_(&block)
+    , index_(index)
+{}
+
+uint64_t output_view::value() const {
+    auto const& entry = block_->outputs_[index_];
+    auto const bytes = block_->slice(entry.offset, sizeof(uint64_t));
+    return from_little_endian_unsafe<uint64_t>(bytes.begin());
+}
+
+bool output_view::has_token_data() const {
+    return block_->outputs_[index_].token_size != 0;
+}
+
+byte_span output_view::token_data() const {
+    auto const& entry = block_->outputs_[index_];
+    return block_->slice(entry.token_offset, entry.token_size);
+}
+
+byte_span output_view::script() const {
+    auto const& entry = block_->outputs_[index_];
+    return block_->slice(entry.script_offset, entry.script_size);
+}
+
+byte_span output_view::data() const {
+    auto const& entry = block_->outputs_[index_];
+    auto const end = entry.script_offset + entry.script_size;
+    return block_->slice(entry.offset, end - entry.offset);
+}
+
+// transaction_view.
+//-----------------------------------------------------------------------------
+
+transaction_view::transaction_view(block_view const& block, size_t index)
+    : block_(&block)
+    , index_(index)
+{}
+
+uint32_t transaction_view::version() const {
+    return from_little_endian_unsafe<uint32_t>(data().begin());
+}
+
+uint32_t transaction_view::locktime() const {
+    return from_little_endian_unsafe<uint32_t>(data().end() - sizeof(uint32_t));
+}
+
+size_t transaction_view::input_count() const {
+    return block_->transactions_[index_].inputs;
+}
+
+input_view transaction_view::input_at(size_t index) const {
+    KTH_ASSERT(index < input_count());
+    return {*block_, block_->transactions_[index_].first_input + index};
+}
+
+size_t transaction_view::output_count() const {
+    return block_->transactions_[index_].outputs;
+}
+
+output_view transaction_view::output_at(size_t index) const {
+    KTH_ASSERT(index < output_count());
+    return {*block_, block_->transactions_[index_].first_output + index};
+}
+
+byte_span transaction_view::data() const {
+    auto const& entry = block_->transactions_[index_];
+    return block_->slice(entry.offset, entry.size);
+}
+
+hash_digest transaction_view::hash() const {
+    sha256_context context;
+    auto const bytes = data();
+    context.write_bytes(bytes.data(), bytes.size());
+    return context.finalize_double();
+}
+
+bool transaction_view::is_coinbase() const {
+    return input_count() == 1 && is_null_outpoint(input_at(0).data().data());
+}
+
+// True if not coinbase but has null previous_output(s).
+bool transaction_view::is_null_non_coinbase() const {
+    if (is_coinbase()) {
+        return false;
+    }
+
+    for (size_t index = 0; index < input_count(); ++index) {
+        if (is_null_outpoint(input_at(index).data().data())) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// True if coinbase and has invalid input[0] script size.
+bool transaction_view::is_oversized_coinbase() const {
+    if ( ! is_coinbase()) {
+        return false;
+    }
+
+    auto const script_size = input_at(0).script().size();
+    return script_size < min_coinbase_size || script_size > max_coinbase_size;
+}
+
+uint64_t transaction_view::total_output_value() const {
+    uint64_t total = 0;
+    for (size_t index = 0; index < output_count(); ++index) {
+        total = ceiling_add(total, output_at(index).value());
+    }
+    return total;
+}
+
+code transaction_view::check(bool retarget) const {
+    if (input_count() == 0 || output_count() == 0) {
+        return error::empty_transaction;
+    }
+
+    if (is_null_non_coinbase()) {
+        return error::previous_output_null;
+    }
+
+    if (total_output_value() > max_money(retarget)) {
+        return error::spend_overflow;
+    }
+
+    if (is_oversized_coinbase()) {
+        return error::invalid_coinbase_script_size;
+    }
+
+    return error::success;
+}
+
+expect<transaction> transaction_view::to_transaction(std::pmr::memory_resource* resource) const {
+    byte_reader reader(data());
+    return transaction::from_data(reader, true, resource);
+}
+
+// Deserialization.
+//-----------------------------------------------------------------------------
+
+// static
+expect<block_view> block_view::from_data(byte_span data) {
+    // Offsets are 32 bits wide, far above any valid block size.
+    data = data.first(std::min<size_t>(data.size(), max_uint32));
+
+    block_view view;
+    view.data_ = data;
+    byte_reader reader(data);
+
+    auto header = chain::header::from_data(reader, true);
+    if ( ! header) {
+        return make_unexpected(header.error());
+    }
+    view.header_ = std::move(*header);
+
+    auto const count = reader.read_size_little_endian();
+    if ( ! count) {
+        return make_unexpected(count.error());
+    }
+    if (*count > static_absolute_max_block_size()) {
+        return make_unexpected(error::invalid_size);
+    }
+
+    // The count is not trusted to size the allocation, the buffer is.
+    view.transactions_.reserve(std::min(*count, data.size() / min_transaction_size));
+
+    for (size_t index = 0; index < *count; ++index) {
+        auto const parsed = view.parse_transaction(reader);
+        if ( ! parsed) {
+            return make_unexpected(parsed.error());
+        }
+    }
+
+    auto const rest = reader.read_remaining_bytes();
+    if ( ! rest) {
+        return make_unexpected(rest.error());
+    }
+    view.data_ = data.first(view.offset_of(*rest));
+    return view;
+}
+
+// private
+expect<void> block_view::parse_transaction(byte_reader& reader) {
+    auto const version = reader.read_bytes(sizeof(uint32_t));
+    if ( ! version) {
+        return make_unexpected(version.error());
+    }
+
+    transaction_entry tx {};
+    tx.offset = offset_of(*version);
+    tx.first_input = uint32_t(inputs_.size());
+    tx.first_output = uint32_t(outputs_.size());
+
+    auto const inputs = reader.read_size_little_endian();
+    if ( ! inputs) {
+        return make_unexpected(inputs.error());
+    }
+    if (*inputs > static_absolute_max_block_size()) {
+        return make_unexpected(error::invalid_size);
+    }
+
+    for (size_t index = 0; index < *inputs; ++index) {
+        auto const outpoint = reader.read_bytes(outpoint_size);
+        if ( ! outpoint) {
+            return make_unexpected(outpoint.error());
+        }
+
+        auto const size = reader.read_size_little_endian();
+        if ( ! size) {
+            return make_unexpected(size.error());
+        }
+        if (*size > static_absolute_max_block_size()) {
+            return make_unexpected(error::script_invalid_size);
+        }
+
+        auto const script = reader.read_bytes(*size);
+        if ( ! script) {
+            return make_unexpected(script.error());
+        }
+
+        auto const sequence = reader.read_bytes(sizeof(uint32_t));
+        if ( ! sequence) {
+            return make_unexpected(sequence.error());
+        }
+
+        inputs_.push_back({offset_of(*outpoint), offset_of(*script), uint32_t(script->size())});
+    }
+
+    auto const outputs = reader.read_size_little_endian();
+    if ( ! outputs) {
+        return make_unexpected(outputs.error());
+    }
+    if (*outputs > static_absolute_max_block_size()) {
+        return make_unexpected(error::invalid_size);
+    }
+
+    for (size_t index = 0; index < *outputs; ++index) {
+        auto const value = reader.read_bytes(sizeof(uint64_t));
+        if ( ! value) {
+            return make_unexpected(value.error());
+        }
+
+        auto const size = reader.read_size_little_endian();
+        if ( ! size) {
+            return make_unexpected(size.error());
+        }
+        if (*size > static_absolute_max_block_size()) {
+            return make_unexpected(error::script_invalid_size);
+        }
+
+        auto const script = reader.read_bytes(*size);
+        if ( ! script) {
+            return make_unexpected(script.error());
+        }
+
+        output_entry output {};
+        output.offset = offset_of(*value);
+        output.script_offset = offset_of(*script);
+        output.script_size = uint32_t(script->size());
+
+        // Token data is carried inside the script field, behind a prefix byte.
+        if ( ! script->empty() && script->front() == chain::encoding::PREFIX_BYTE) {
+            byte_reader token_reader(script->subspan(1));
+            auto const token = token::encoding::from_data(token_reader);
+            if ( ! token) {
+                return make_unexpected(token.error());
+            }
+
+            auto const token_size = token::encoding::serialized_size(*token);
+            if (token_size + 1 > script->size()) {
+                return make_unexpected(error::invalid_size);
+            }
+
+            output.token_offset = output.script_offset + 1;
+            output.token_size = uint32_t(token_size);
+            output.script_offset = output.token_offset + output.token_size;
+            output.script_size -= output.token_size + 1;
+        }
+
+        outputs_.push_back(output);
+    }
+
+    auto const locktime = reader.read_bytes(sizeof(uint32_t));
+    if ( ! locktime) {
+        return make_unexpected(locktime.error());
+    }
+
+    tx.inputs = uint32_t(*inputs);
+    tx.outputs = uint32_t(*outputs);
+    tx.size = offset_of(*locktime) + sizeof(uint32_t) - tx.offset;
+    transactions_.push_back(tx);
+    return {};
+}
+
+// private
+uint32_t block_view::offset_of(byte_span bytes) const {
+    return uint32_t(bytes.data() - data_.data());
+}
+
+// private
+byte_span block_view::slice(uint32_t offset, uint32_t size) const {
+    return data_.subspan(offset, size);
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+byte_span block_view::data() const {
+    return data_;
+}
+
+chain::header const& block_view::header() const {
+    return header_;
+}
+
+hash_digest block_view::hash() const {
+    return header_.hash();
+}
+
+size_t block_view::transaction_count() const {
+    return transactions_.size();
+}
+
+transaction_view block_view::transaction_at(size_t index) const {
+    KTH_ASSERT(index < transaction_count());
+    return {*this, index};
+}
+
+hash_list block_view::transaction_hashes(size_t threads) const {
+    auto const count = transactions_.size();
+
+    // One spare node, so merkle_root can duplicate an odd last node in place.
+    hash_list hashes;
+    hashes.reserve(count + 1);
+    hashes.resize(count);
+
+    // The wire slices are hashed in place, nothing is serialized.
+    auto const hash_range = [this, &hashes](size_t first, size_t last) {
+        std::vector<data_slice> messages;
+        messages.reserve(last - first);
+
+        for (auto index = first; index < last; ++index) {
+            auto const bytes = transaction_at(index).data();
+            messages.emplace_back(bytes.data(), bytes.data() + bytes.size());
+        }
+
+        double_sha256(hashes.data() + first, messages.data(), messages.size());
+    };
+
+    size_t const parallel_transactions = 512;
+    parallel_ranges(count, threads, parallel_transactions, hash_range);
+    return hashes;
+}
+
+// Validation.
+//-----------------------------------------------------------------------------
+
+hash_digest block_view::generate_merkle_root(size_t threads) const {
+    return merkle_root(transaction_hashes(threads), threads);
+}
+
+bool block_view::is_valid_merkle_root(size_t threads) const {
+    return generate_merkle_root(threads) == header_.merkle();
+}
+
+bool block_view::is_extra_coinbases() const {
+    for (size_t index = 1; index < transaction_count(); ++index) {
+        if (transaction_at(index).is_coinbase()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Outpoints are compared as wire bytes, nothing is materialized.
+bool block_view::is_internal_double_spend() const {
+    if (transactions_.empty()) {
+        return false;
+    }
+
+    auto const& coinbase = transactions_.front();
+    std::vector<uint8_t const*> outpoints;
+    outpoints.reserve(inputs_.size() - coinbase.inputs);
+
+    for (auto input = coinbase.first_input + coinbase.inputs; input < inputs_.size(); ++input) {
+        outpoints.push_back(data_.data() + inputs_[input].offset);
+    }
+
+    auto const less = [](uint8_t const* x, uint8_t const* y) {
+        return std::memcmp(x, y, outpoint_size) < 0;
+    };
+
+    auto const equal = [](uint8_t const* x, uint8_t const* y) {
+        return std::memcmp(x, y, outpoint_size) == 0;
+    };
+
+    std::sort(outpoints.begin(), outpoints.end(), less);
+    return std::adjacent_find(outpoints.begin(), outpoints.end(), equal) != outpoints.end();
+}
+
+code block_view::check(size_t threads) const {
+    code ec;
+    threads = thread_count(threads);
+
+    if ((ec = header_.check())) {
+        return ec;
+    }
+
+    if (data_.size() > static_absolute_max_block_size()) {
+        return error::block_size_limit;
+    }
+
+    if (transactions_.empty()) {
+        return error::empty_block;
+    }
+
+    if ( ! transaction_at(0).is_coinbase()) {
+        return error::first_not_coinbase;
+    }
+
+    if (is_extra_coinbases()) {
+        return error::extra_coinbases;
+    }
+
+    auto hashes = transaction_hashes(threads);
+
+#if ! defined(KTH_CURRENCY_BCH) // BTC and LTC
+    std::unordered_set<hash_digest> later;
+    for (auto index = transaction_count(); index-- > 0;) {
+        later.insert(hashes[index]);
+        auto const tx = transaction_at(index);
+
+        for (size_t input = 0; input < tx.input_count(); ++input) {
+            if (later.count(tx.input_at(input).previous_output().hash()) != 0) {
+                return error::forward_reference;
+            }
+        }
+    }
+#endif
+
+    if (is_internal_double_spend()) {
+        return error::block_internal_double_spend;
+    }
+
+    if (merkle_root(std::move(hashes), threads) != header_.merkle()) {
+        return error::merkle_mismatch;
+    }
+
+    for (size_t index = 0; index < transaction_count(); ++index) {
+        if ((ec = transaction_at(index).check())) {
+            return ec;
+        }
+    }
+
+    return error::success;
+}
+
+// Materialization.
+//-----------------------------------------------------------------------------
+
+expect<block> block_view::to_block(std::pmr::memory_resource* resource) const {
+    byte_reader reader(data_);
+    return block::from_data(reader, true, resource);
+}
+
+expect<block> block_view::to_block(hash_list const& transaction_hashes, std::pmr::memory_resource* resource) const {
+    KTH_ASSERT(transaction_hashes.size() == transaction_count());
+    auto result = to_block(resource);
+    if ( ! result) {
+        return result;
+    }
+
+    auto const& txs = result->transactions();
+    for (size_t index = 0; index < txs.size(); ++index) {
+        txs[index].cache_hash(transaction_hashes[index]);
+    }
+
+    return result;
+}
+
+} // namespace kth::domain::chain
@@ -5,6 +5,7 @@
 #include <kth/domain/chain/chain_state.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
@@ -120,29 +121,89 @@ domain::config::network chain_state::network() const {
     return network_;
 }
 
+// private
+chain_state::chain_state(chain_state const& base, data&& values, std::optional<uint32_t> known_median_time_past, std::optional<uint32_t> known_work_required)
+    : data_(std::move(values))
+#if defined(KTH_CURRENCY_BCH)
+    , assert_anchor_block_info_(base.assert_anchor_block_info_)
+#endif
+    , forks_(base.forks_)
+    , checkpoints_(base.checkpoints_)
+    , network_(base.network_)
+    , active_(activation(data_, forks_, network_
+#if defined(KTH_CURRENCY_BCH)
+        , base.leibniz_activation_time_
+        , base.cantor_activation_time_
+#endif  //KTH_CURRENCY_BCH
+        ))
+    , median_time_past_(known_median_time_past ? *known_median_time_past : median_time_past(data_))
+    , work_required_(known_work_required ? *known_work_required : work_required(data_, network_, forks_
+#if defined(KTH_CURRENCY_BCH)
+            , base.leibniz_activation_time_
+            , base.cantor_activation_time_
+            , base.assert_anchor_block_info_
+            , base.asert_half_life_
+#endif
+    ))
+#if defined(KTH_CURRENCY_BCH)
+    , asert_half_life_(base.asert_half_life_)
+    , abla_config_(base.abla_config_)
+    , leibniz_activation_time_(base.leibniz_activation_time_)
+    , cantor_activation_time_(base.cantor_activation_time_)
+#endif  //KTH_CURRENCY_BCH
+{}
 
 // Named constructors.
 //-----------------------------------------------------------------------------
 
 // static
 std::shared_ptr<chain_state> chain_state::from_pool_ptr(chain_state const& pool, block const& block) {
-    return std::make_shared<chain_state>(to_block(pool, block), pool.forks_, pool.checkpoints_
-        , pool.network_
+    return from_pool_ptr(pool, block.header());
+}
+
+// static
+std::shared_ptr<chain_state> chain_state::from_pool_ptr(chain_state const& pool, header const& header) {
+    // The histories are those of the pool state, so is the median time past.
+    // Only minimum difficulty blocks make the work depend on the timestamp.
+    auto const easy_blocks = script::is_enabled(pool.forks_, rule_fork::easy_blocks);
+    auto const work = easy_blocks ? std::nullopt : std::optional<uint32_t>(pool.work_required_);
+    return std::shared_ptr<chain_state>(new chain_state(pool, to_block(pool, header), pool.median_time_past_, work));
+}
+
+// static
+std::shared_ptr<chain_state> chain_state::from_top_ptr(chain_state const& top
 #if defined(KTH_CURRENCY_BCH)
-        , pool.assert_anchor_block_info_
-        , pool.asert_half_life_
-        , pool.abla_config_
-        // , pool.fermat_activation_time_
-        // , pool.euler_activation_time_
-        // , pool.gauss_activation_time_
-        // , pool.descartes_activation_time_
-        // , pool.lobachevski_activation_time_
-        // , pool.galois_activation_time_
-        , pool.leibniz_activation_time_
-        , pool.cantor_activation_time_
-#endif  //KTH_CURRENCY_BCH
+    , abla::state const& abla_state
+#endif
+) {
+    auto data = to_pool(top);
+    if ( ! data) {
+        return nullptr;
+    }
+
+#if defined(KTH_CURRENCY_BCH)
+    data->abla_state = abla_state;
+#endif
+
+    auto const work = work_required(*data, top.network_, top.forks_
+#if defined(KTH_CURRENCY_BCH)
+        , top.leibniz_activation_time_
+        , top.cantor_activation_time_
+        , top.assert_anchor_block_info_
+        , top.asert_half_life_
+#endif
     );
+
+    data->bits.self = work;
+    return std::shared_ptr<chain_state>(new chain_state(top, std::move(*data), std::nullopt, work));
+}
+
+#if defined(KTH_CURRENCY_BCH)
+// static
+std::shared_ptr<chain_state> chain_state::from_top_ptr(chain_state const& top) {
+    return from_top_ptr(top, abla::state{});
 }
+#endif
 
 // Inlines.
 //-----------------------------------------------------------------------------
@@ -897,34 +958,22 @@ bool chain_state::is_galois_enabled(size_t height, config::network network) {
 
 #endif // KTH_CURRENCY_BCH
 
-auto timestamps_position(chain_state::timestamps const& times, size_t last_n = median_time_past_interval) {
-    if (times.size() > last_n) {
-        return times.begin() + (times.size() - last_n);
+uint32_t chain_state::median_time_past(data const& values, size_t last_n /* = median_time_past_interval*/) {
+    auto const& times = values.timestamp.ordered;
+    auto const count = std::min({times.size(), last_n, median_time_past_interval});
+    if (count == 0) {
+        return 0;
     }
-    return times.begin();
-}
-
-std::vector<typename chain_state::timestamps::value_type> timestamps_subset(chain_state::timestamps const& times, size_t last_n = median_time_past_interval) {
-    auto at = timestamps_position(times, last_n);
-    auto n = (std::min)(static_cast<size_t>(std::distance(at, times.end())), median_time_past_interval);
-    std::vector<typename chain_state::timestamps::value_type> subset(n);
-    std::copy_n(at, n, subset.begin());
-    return subset;
-}
 
-uint32_t median(std::vector<typename chain_state::timestamps::value_type>& subset) {
-    // Sort the times by value to obtain the median.
-    // Note(fernando): no need to stable sorting, because we are dealing with just integers.
-    std::sort(subset.begin(), subset.end());
+    // The window is a few values, selected in place of a sort.
+    std::array<uint32_t, median_time_past_interval> subset;
+    std::copy(times.end() - count, times.end(), subset.begin());
 
     // Consensus defines median time using modulo 2 element selection.
     // This differs from arithmetic median which averages two middle values.
-    return subset.empty() ? 0 : subset[subset.size() / 2];
-}
-
-uint32_t chain_state::median_time_past(data const& values, size_t last_n /* = median_time_past_interval*/) {
-    auto subset = timestamps_subset(values.timestamp.ordered, last_n);
-    return median(subset);
+    auto const middle = subset.begin() + count / 2;
+    std::nth_element(subset.begin(), middle, subset.begin() + count);
+    return *middle;
 }
 
 // ------------------------------------------------------------------------------------------------------------
@@ -1317,7 +1366,7 @@ uint32_t chain_state::signal_version(uint32_t forks) {
 }
 
 // static
-chain_state::data chain_state::to_block(chain_state const& pool, block const& block) {
+chain_state::data chain_state::to_block(chain_state const& pool, header const& header) {
     // // Alias configured forks.
     // auto const forks = pool.forks_;
 
@@ -1326,7 +1375,6 @@ chain_state::data chain_state::to_block(chain_state const& pool, block const& bl
 
     // Replace pool chain state with block state at same (next) height.
     // Preserve data.timestamp.retarget promotion.
-    auto const& header = block.header();
     data.hash = header.hash();
     data.bits.self = header.bits();
     data.version.self = header.version();
@@ -1353,6 +1401,44 @@ chain_state::data chain_state::to_block(chain_state const& pool, block const& bl
     return data;
 }
 
+// static
+std::optional<chain_state::data> chain_state::to_pool(chain_state const& top) {
+    auto const forks = top.forks_;
+    auto const retarget = script::is_enabled(forks, rule_fork::retarget);
+
+    // Copy data from the previous height block state, sharing its histories.
+    auto data = top.data_;
+    ++data.height;
+
+    // Enqueue the previous block values, dequeue those out of range.
+    auto const advance = [](shared_window<uint32_t>& history, uint32_t value, size_t count) {
+        history.push_back(value);
+        while (history.size() > count) {
+            history.pop_front();
+        }
+
+        return history.size() == count;
+    };
+
+    if ( ! advance(data.bits.ordered, data.bits.self, bits_count(data.height, forks)) ||
+         ! advance(data.version.ordered, data.version.self, version_count(data.height, forks, top.network_)) ||
+         ! advance(data.timestamp.ordered, data.timestamp.self, timestamp_count(data.height, forks))) {
+        return std::nullopt;
+    }
+
+    // Regtest does not perform retargeting.
+    // If promoting from retarget height, move that timestamp into retarget.
+    if (retarget && is_retarget_height(data.height - 1)) {
+        data.timestamp.retarget = data.timestamp.self;
+    }
+
+    // Replace previous block state with tx pool chain state for next height.
+    // Preserve top block timestamp for use in computation of staleness.
+    data.hash = null_hash;
+    data.version.self = signal_version(forks);
+    return data;
+}
+
 // Semantic invalidity can also arise from too many/few values in the arrays.
 // The same computations used to specify the ranges could detect such errors.
 // These are the conditions that would cause exception during execution.
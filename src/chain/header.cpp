@@ -20,17 +20,6 @@ namespace kth::domain::chain {
 // Constructors.
 //-----------------------------------------------------------------------------
 
-header::header(header const& x)
-    : header_basis(x)
-    , validation(x.validation)
-{}
-
-header& header::operator=(header const& x) {
-    header_basis::operator=(x);
-    validation = x.validation;
-    return *this;
-}
-
 // protected
 void header::reset() {
     header_basis::reset();
@@ -75,8 +75,8 @@ void input::reset() {
 //-----------------------------------------------------------------------------
 
 // static
-expect<input> input::from_data(byte_reader& reader, bool wire) {
-    auto basis = input_basis::from_data(reader, wire);
+expect<input> input::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
+    auto basis = input_basis::from_data(reader, wire, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -76,7 +76,7 @@ output::addresses_ptr output::addresses_cache() const {
 //-----------------------------------------------------------------------------
 
 // static
-expect<output> output::from_data(byte_reader& reader, bool wire) {
+expect<output> output::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
     uint32_t spender_height = validation::not_spent;
     if ( ! wire) {
         auto const height = reader.read_little_endian<uint32_t>();
@@ -86,7 +86,7 @@ expect<output> output::from_data(byte_reader& reader, bool wire) {
         spender_height = *height;
     }
 
-    auto basis = output_basis::from_data(reader, wire);
+    auto basis = output_basis::from_data(reader, wire, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
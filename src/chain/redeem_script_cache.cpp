@@ -0,0 +1,79 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/redeem_script_cache.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <kth/domain/machine/program.hpp>
+#include <kth/infrastructure/utility/assert.hpp>
+
+namespace kth::domain::chain {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+// The bytecode borrows the bytes of the script, so the entry is not movable
+// (entries are held by pointer).
+redeem_script_cache::entry::entry(data_chunk&& bytes, uint32_t forks)
+    : redeem(std::move(bytes), false)
+    , compiled(machine::program::compile(redeem, forks))
+    , forks(forks)
+{}
+
+redeem_script_cache::redeem_script_cache(size_t capacity)
+    : capacity_(capacity)
+{
+    KTH_ASSERT(capacity_ != 0);
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+size_t redeem_script_cache::size() const {
+    return entries_.size();
+}
+
+size_t redeem_script_cache::capacity() const {
+    return capacity_;
+}
+
+// Cache.
+//-----------------------------------------------------------------------------
+
+redeem_script_cache::entry const& redeem_script_cache::get(byte_span script_hash, byte_span redeem, uint32_t forks) {
+    KTH_ASSERT(script_hash.size() <= hash_size);
+
+    // A short hash is zero padded, the redeem bytes disambiguate.
+    hash_digest key{};
+    std::copy(script_hash.begin(), script_hash.end(), key.begin());
+
+    auto const it = entries_.find(key);
+    if (it != entries_.end()) {
+        auto& cached = *it->second;
+        auto const bytes = cached.redeem.bytes();
+
+        if (cached.forks == forks && std::ranges::equal(bytes, redeem)) {
+            return cached;
+        }
+
+        it->second = std::make_unique<entry>(data_chunk(redeem.begin(), redeem.end()), forks);
+        return *it->second;
+    }
+
+    if (entries_.size() == capacity_) {
+        entries_.clear();
+    }
+
+    auto& created = entries_[key];
+    created = std::make_unique<entry>(data_chunk(redeem.begin(), redeem.end()), forks);
+    return *created;
+}
+
+void redeem_script_cache::clear() {
+    entries_.clear();
+}
+
+} // namespace kth::domain::chain
@@ -15,6 +15,8 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <kth/domain/chain/script_template.hpp>
+#include <kth/domain/chain/sighash_context.hpp>
 #include <kth/domain/chain/transaction.hpp>
 #include <kth/domain/constants.hpp>
 #include <kth/domain/machine/interpreter.hpp>
@@ -23,6 +25,8 @@
 // #include <kth/infrastructure/message/message_tools.hpp>
 #include <kth/domain/machine/opcode.hpp>
 #include <kth/domain/machine/rule_fork.hpp>
+#include <kth/domain/machine/signature_cache.hpp>
+#include <kth/domain/math/sha256.hpp>
 #include <kth/domain/multi_crypto_support.hpp>
 #include <kth/infrastructure/error.hpp>
 #include <kth/infrastructure/formats/base_16.hpp>
@@ -105,8 +109,8 @@ script& script::operator=(script const& x) {
 //-----------------------------------------------------------------------------
 
 // static
-expect<script> script::from_data(byte_reader& reader, bool prefix) {
-    auto basis = script_basis::from_data(reader, prefix);
+expect<script> script::from_data(byte_reader& reader, bool prefix, std::pmr::memory_resource* resource) {
+    auto basis = script_basis::from_data(reader, prefix, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -114,8 +118,8 @@ expect<script> script::from_data(byte_reader& reader, bool prefix) {
 }
 
 // static
-expect<script> script::from_data_with_size(byte_reader& reader, size_t size) {
-    auto basis = script_basis::from_data_with_size(reader, size);
+expect<script> script::from_data_with_size(byte_reader& reader, size_t size, std::pmr::memory_resource* resource) {
+    auto basis = script_basis::from_data_with_size(reader, size, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -329,16 +333,6 @@ operation script::first_operation() const {
 // Signing (unversioned).
 //-----------------------------------------------------------------------------
 
-inline
-std::pair<hash_digest, size_t> signature_hash(transaction const& tx, uint32_t sighash_type) {
-    // There is no rational interpretation of a signature hash for a coinbase.
-    KTH_ASSERT( ! tx.is_coinbase());
-
-    auto serialized = tx.to_data(true);
-    extend_data(serialized, to_little_endian(sighash_type));
-    return {bitcoin_hash(serialized), serialized.size()};
-}
-
 //*****************************************************************************
 // CONSENSUS: Due to masking of bits 6/7 (8 is the anyone_can_pay flag),
 // there are 4 possible 7 bit values that can set "single" and 4 others that
@@ -363,113 +357,126 @@ uint8_t is_sighash_enum(uint8_t sighash_type, sighash_algorithm value) {
     );
 }
 
+// The signature hash preimages are streamed into the hasher directly from the
+// original transaction, no modified transaction copy is serialized.
+
+// The script code with code separators removed, with its size prefix.
 static
-std::pair<hash_digest, size_t> sign_none(transaction const& tx, uint32_t input_index, script const& script_code, uint8_t sighash_type) {
-    input::list ins;
-    auto const& inputs = tx.inputs();
-    auto const any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
+void write_stripped_script(sha256_context& sink, script const& script_code) {
+    auto const& ops = script_code.operations();
+    auto const sum = [](size_t total, operation const& op) {
+        return op.code() == opcode::codeseparator ? total : total + op.serialized_size();
+    };
 
-    KTH_ASSERT(input_index < inputs.size());
-    auto const& self = inputs[input_index];
+    sink.write_variable_little_endian(std::accumulate(ops.begin(), ops.end(), size_t(0), sum));
 
-    if (any) {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    } else {
-        // Erase all input scripts and sequences.
-        for (auto const& input : inputs) {
-            ins.emplace_back(input.previous_output(), script{}, 0);
+    for (auto const& op : ops) {
+        if (op.code() != opcode::codeseparator) {
+            op.to_data(sink);
         }
-
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ins[input_index].set_sequence(self.sequence());
     }
-
-    // Move new inputs to new transaction and drop outputs.
-    return signature_hash({tx.version(), tx.locktime(), std::move(ins), {}}, sighash_type);
 }
 
+// Writes the version and the inputs, all input scripts but self are erased.
 static
-std::pair<hash_digest, size_t> sign_single(transaction const& tx, uint32_t input_index, script const& script_code, uint8_t sighash_type) {
-    input::list ins;
+void write_inputs(sha256_context& sink, transaction const& tx, uint32_t input_index, script const& script_code, uint8_t sighash_type, bool keep_sequences) {
     auto const& inputs = tx.inputs();
     auto const any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
 
     KTH_ASSERT(input_index < inputs.size());
     auto const& self = inputs[input_index];
 
+    sink.write_4_bytes_little_endian(tx.version());
+
     if (any) {
         // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    } else {
-        // Erase all input scripts and sequences.
-        for (auto const& input : inputs) {
-            ins.emplace_back(input.previous_output(), script{}, 0);
-        }
+        sink.write_variable_little_endian(1);
+        self.previous_output().to_data(sink);
+        write_stripped_script(sink, script_code);
+        sink.write_4_bytes_little_endian(self.sequence());
+        return;
+    }
+
+    sink.write_variable_little_endian(inputs.size());
 
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ins[input_index].set_sequence(self.sequence());
+    for (size_t index = 0; index < inputs.size(); ++index) {
+        auto const& input = inputs[index];
+        input.previous_output().to_data(sink);
+
+        if (index == input_index) {
+            write_stripped_script(sink, script_code);
+            sink.write_4_bytes_little_endian(self.sequence());
+        } else {
+            sink.write_variable_little_endian(0);
+            sink.write_4_bytes_little_endian(keep_sequences ? input.sequence() : 0);
+        }
     }
+}
 
-    // Trim and clear outputs except that of specified input index.
-    auto const& outputs = tx.outputs();
-    output::list outs(input_index + 1);
+// Writes the locktime and the sighash type, then hashes.
+static
+std::pair<hash_digest, size_t> finish_signature_hash(sha256_context& sink, transaction const& tx, uint8_t sighash_type) {
+    sink.write_4_bytes_little_endian(tx.locktime());
+    sink.write_4_bytes_little_endian(sighash_type);
+    return {sink.finalize_double(), size_t(sink.size())};
+}
 
-    KTH_ASSERT(input_index < outputs.size());
-    outs.back() = outputs[input_index];
+static
+std::pair<hash_digest, size_t> sign_none(transaction const& tx, uint32_t input_index, script const& script_code, uint8_t sighash_type) {
+    // There is no rational interpretation of a signature hash for a coinbase.
+    KTH_ASSERT( ! tx.is_coinbase());
+    sha256_context sink;
 
-    // Move new inputs and new outputs to new transaction.
-    return signature_hash({tx.version(), tx.locktime(), std::move(ins),
-                           std::move(outs)},
-                          sighash_type);
+    // Erase all input scripts and sequences.
+    write_inputs(sink, tx, input_index, script_code, sighash_type, false);
+
+    // Drop outputs.
+    sink.write_variable_little_endian(0);
+    return finish_signature_hash(sink, tx, sighash_type);
 }
 
 static
-std::pair<hash_digest, size_t> sign_all(transaction const& tx, uint32_t input_index, script const& script_code, uint8_t sighash_type) {
-    input::list ins;
-    auto const& inputs = tx.inputs();
-    auto const any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
-    ins.reserve(any ? 1 : inputs.size());
+std::pair<hash_digest, size_t> sign_single(transaction const& tx, uint32_t input_index, script const& script_code, uint8_t sighash_type) {
+    // There is no rational interpretation of a signature hash for a coinbase.
+    KTH_ASSERT( ! tx.is_coinbase());
+    sha256_context sink;
 
-    KTH_ASSERT(input_index < inputs.size());
-    auto const& self = inputs[input_index];
+    // Erase all input scripts and sequences.
+    write_inputs(sink, tx, input_index, script_code, sighash_type, false);
 
-    if (any) {
-        // Retain only self.
-        ins.emplace_back(self.previous_output(), script_code, self.sequence());
-    } else {
-        // Erase all input scripts.
-        for (auto const& input : inputs) {
-            ins.emplace_back(input.previous_output(), script{},
-                             input.sequence());
-        }
+    // Trim and clear outputs except that of specified input index.
+    auto const& outputs = tx.outputs();
+    KTH_ASSERT(input_index < outputs.size());
+    sink.write_variable_little_endian(input_index + 1);
 
-        // Replace self that is lost in the loop.
-        ins[input_index].set_script(script_code);
-        ////ins[input_index].set_sequence(self.sequence());
+    // Cleared outputs serialize as a default output (not_found, empty script).
+    for (uint32_t index = 0; index < input_index; ++index) {
+        sink.write_8_bytes_little_endian(output::not_found);
+        sink.write_variable_little_endian(0);
     }
 
-    // Move new inputs and copy outputs to new transaction.
-    transaction out(tx.version(), tx.locktime(), input::list{}, tx.outputs());
-    out.set_inputs(std::move(ins));
-    return signature_hash(out, sighash_type);
+    outputs[input_index].to_data(sink, true);
+    return finish_signature_hash(sink, tx, sighash_type);
 }
 
 static
-script strip_code_seperators(script const& script_code) {
-    operation::list ops;
+std::pair<hash_digest, size_t> sign_all(transaction const& tx, uint32_t input_index, script const& script_code, uint8_t sighash_type) {
+    // There is no rational interpretation of a signature hash for a coinbase.
+    KTH_ASSERT( ! tx.is_coinbase());
+    sha256_context sink;
 
-     for (auto const& op : script_code) {
-        if (op.code() != opcode::codeseparator) {
-            ops.push_back(op);
-        }
+    // Erase all input scripts.
+    write_inputs(sink, tx, input_index, script_code, sighash_type, true);
+
+    // Keep all outputs.
+    auto const& outputs = tx.outputs();
+    sink.write_variable_little_endian(outputs.size());
+
+    for (auto const& output : outputs) {
+        output.to_data(sink, true);
     }
 
-    return script(std::move(ops));
+    return finish_signature_hash(sink, tx, sighash_type);
 }
 
 #if ! defined(KTH_CURRENCY_BCH)
@@ -489,18 +496,18 @@ std::pair<hash_digest, size_t> script::generate_unversioned_signature_hash(trans
 
     //*************************************************************************
     // CONSENSUS: more wacky satoshi behavior.
+    // Code separators are stripped from the script code as it is written.
     //*************************************************************************
-    auto const stripped = strip_code_seperators(script_code);
 
     // The sighash serializations are isolated for clarity and optimization.
     switch (sighash) {
         case sighash_algorithm::none:
-            return sign_none(tx, input_index, stripped, sighash_type);
+            return sign_none(tx, input_index, script_code, sighash_type);
         case sighash_algorithm::single:
-            return sign_single(tx, input_index, stripped, sighash_type);
+            return sign_single(tx, input_index, script_code, sighash_type);
         default:
         case sighash_algorithm::all:
-            return sign_all(tx, input_index, stripped, sighash_type);
+            return sign_all(tx, input_index, script_code, sighash_type);
     }
 }
 #endif // ! KTH_CURRENCY_BCH
@@ -593,9 +600,18 @@ std::pair<hash_digest, size_t> script::generate_signature_hash(
     , script_version version
 #endif // ! KTH_CURRENCY_BCH
     , uint64_t value
+    , sighash_context const* context
 ) {
 
+    if (context != nullptr) {
+        KTH_ASSERT(&context->tx() == &tx);
+        KTH_ASSERT(context->active_forks() == active_forks);
+    }
+
 #if defined(KTH_CURRENCY_BCH)
+    if (context != nullptr) {
+        return context->signature_hash(input_index, script_code, value, sighash_type);
+    }
     return generate_version_0_signature_hash(tx, input_index, script_code, value, sighash_type, active_forks);
 #else
     // The way of serialization is changed (bip143).
@@ -603,6 +619,9 @@ std::pair<hash_digest, size_t> script::generate_signature_hash(
         case script_version::unversioned:
             return generate_unversioned_signature_hash(tx, input_index, script_code, sighash_type);
         case script_version::zero:
+            if (context != nullptr) {
+                return context->signature_hash(input_index, script_code, value, sighash_type);
+            }
             return generate_version_0_signature_hash(tx, input_index, script_code, value, sighash_type, active_forks);
         case script_version::reserved:
         default:
@@ -616,7 +635,7 @@ std::pair<hash_digest, size_t> script::generate_signature_hash(
 std::pair<bool, size_t> script::check_signature(
     ec_signature const& signature
     , uint8_t sighash_type
-    , data_chunk const& public_key
+    , byte_span public_key
     , script const& script_code
     , transaction const& tx
     , uint32_t input_index
@@ -624,7 +643,8 @@ std::pair<bool, size_t> script::check_signature(
 #if ! defined(KTH_CURRENCY_BCH)
     , script_version version
 #endif // ! KTH_CURRENCY_BCH
-    , uint64_t value) {
+    , uint64_t value
+    , sighash_context const* context) {
 
     if (public_key.empty()) {
         return {false, 0};
@@ -639,16 +659,28 @@ std::pair<bool, size_t> script::check_signature(
 #if ! defined(KTH_CURRENCY_BCH)
                                                                 version,
 #endif // ! KTH_CURRENCY_BCH
-                                                                value);
+                                                                value,
+                                                                context);
+
+    // Signatures verified for the mempool are not verified again.
+    auto& cache = machine::signature_cache::global();
+    auto const entry = cache.entry(sighash, public_key, signature);
 
-    std::cout << "script::check_signature() - sighash: ";
-    for (auto const& byte : sighash) {
-        printf("%02x", int(byte));
+    if (cache.contains(entry)) {
+        return { true, size };
     }
-    printf("\n");
 
-    // Validate the EC signature.
-    return { verify_signature(public_key, sighash, signature), size };
+    // Validate the EC signature. Checks are verified one at a time, the
+    // interpreter only verifies DER (ecdsa) signatures and the secp256k1
+    // interface in use has no batch (multi-scalar) verification.
+    auto const point = data_slice(public_key.data(), public_key.data() + public_key.size());
+
+    if ( ! verify_signature(point, sighash, signature)) {
+        return { false, size };
+    }
+
+    cache.insert(entry);
+    return { true, size };
 }
 
 // static
@@ -663,7 +695,8 @@ nonstd::expected<endorsement, std::error_code> script::create_endorsement(
     script_version version /* = script_version::unversioned */,
 #endif // ! KTH_CURRENCY_BCH
     uint64_t value /* = max_uint64 */,
-    endorsement_type type /* = endorsement_type::ecdsa */) {
+    endorsement_type type /* = endorsement_type::ecdsa */,
+    sighash_context const* context /* = nullptr */) {
 
     // This always produces a valid signature hash, including one_hash.
     auto const [sighash, size] = chain::script::generate_signature_hash(
@@ -675,7 +708,8 @@ nonstd::expected<endorsement, std::error_code> script::create_endorsement(
 #if ! defined(KTH_CURRENCY_BCH)
         version,
 #endif // ! KTH_CURRENCY_BCH
-        value
+        value,
+        context
     );
 
     endorsement result;
@@ -971,32 +1005,8 @@ script_pattern script::pattern() const {
 // Output patterns are mutually and input unambiguous.
 // The bip141 coinbase pattern is not tested here, must test independently.
 script_pattern script::output_pattern() const {
-    // The first operations access must be method-based to guarantee the cache.
-    if (is_pay_public_key_hash_pattern(operations())) {
-        return script_pattern::pay_public_key_hash;
-    }
-
-    if (is_pay_script_hash_pattern(operations_)) {
-        return script_pattern::pay_script_hash;
-    }
-
-    if (is_pay_script_hash_32_pattern(operations_)) {
-        return script_pattern::pay_script_hash_32;
-    }
-
-    if (is_null_data_pattern(operations_)) {
-        return script_pattern::null_data;
-    }
-
-    if (is_pay_public_key_pattern(operations_)) {
-        return script_pattern::pay_public_key;
-    }
-
-    if (is_pay_multisig_pattern(operations_)) {
-        return script_pattern::pay_multisig;
-    }
-
-    return script_pattern::non_standard;
+    // Matched on the bytes, the operations are not materialized.
+    return script_template::output_pattern(bytes());
 }
 
 // A sign_public_key_hash result always implies sign_script_hash as well.
@@ -1034,41 +1044,19 @@ script_pattern script::input_pattern() const {
 
 bool script::is_pay_to_script_hash(uint32_t forks) const {
     // This is used internally as an optimization over using script::pattern.
-    // The first operations access must be method-based to guarantee the cache.
     return is_enabled(forks, rule_fork::bip16_rule) &&
-           is_pay_script_hash_pattern(operations());
+           script_template::is_pay_script_hash(bytes());
 }
 
 bool script::is_pay_to_script_hash_32(uint32_t forks) const {
     // This is used internally as an optimization over using script::pattern.
-    // The first operations access must be method-based to guarantee the cache.
     return is_enabled(forks, rule_fork::bch_gauss) &&
-           is_pay_script_hash_32_pattern(operations());
-}
-
-// Count 1..16 multisig accurately for embedded (bip16) and witness (bip141).
-inline size_t multisig_sigops(bool accurate, opcode code) {
-    return accurate && operation::is_positive(code) ? operation::opcode_to_positive(code) : multisig_default_sigops;
+           script_template::is_pay_script_hash_32(bytes());
 }
 
 size_t script::sigops(bool accurate) const {
-    size_t total = 0;
-    auto preceding = opcode::reserved_255;
-
-    // The first operations access must be method-based to guarantee the cache.
-    for (auto const& op : operations()) {
-        auto const code = op.code();
-
-        if (code == opcode::checksig || code == opcode::checksigverify) {
-            ++total;
-        } else if (code == opcode::checkmultisig || code == opcode::checkmultisigverify) {
-            total += multisig_sigops(accurate, preceding);
-        }
-
-        preceding = code;
-    }
-
-    return total;
+    // Counted on the bytes, the operations are not materialized.
+    return script_template::sigops(bytes(), accurate);
 }
 
 ////// This is slightly more efficient because the script does not get parsed,
@@ -1089,8 +1077,7 @@ size_t script::sigops(bool accurate) const {
 // circumstance. This allows for exclusion of the output as unspendable.
 // The criteria below are not be comprehensive but are fast to evaluate.
 bool script::is_unspendable() const {
-    // The first operations access must be method-based to guarantee the cache.
-    return ( ! operations().empty() && operations_[0].code() == opcode::return_) || serialized_size(false) > max_script_size;
+    return script_template::is_unspendable(bytes());
 }
 
 // Validation.
@@ -1122,7 +1109,7 @@ code script::verify(transaction const& tx, uint32_t input_index, uint32_t forks,
         }
 
         // Embedded script must be at the top of the stack (bip16).
-        script embedded_script(input.pop(), false);
+        script embedded_script(input.pop().to_chunk(), false);
 
         program embedded(embedded_script, std::move(input), true);
         if ((ec = embedded.evaluate())) {
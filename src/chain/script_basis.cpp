@@ -66,7 +66,7 @@ script_basis::script_basis(data_chunk&& encoded, bool prefix) {
     }
 
     // This is an optimization that avoids streaming the encoded bytes.
-    bytes_ = std::move(encoded);
+    chunk_ = std::move(encoded);
     valid_ = true;
 }
 
@@ -80,11 +80,19 @@ script_basis::script_basis(data_chunk const& encoded, bool prefix) {
     *this = std::move(obj.value());
 }
 
+// protected
+script_basis::script_basis(std::pmr::vector<uint8_t>&& bytes)
+    : bytes_(std::move(bytes))
+    , valid_(true)
+{}
+
 // Operators.
 //-----------------------------------------------------------------------------
 
 bool script_basis::operator==(script_basis const& x) const {
-    return bytes_ == x.bytes_;
+    auto const left = bytes();
+    auto const right = x.bytes();
+    return std::equal(left.begin(), left.end(), right.begin(), right.end());
 }
 
 bool script_basis::operator!=(script_basis const& x) const {
@@ -117,7 +125,8 @@ bool script_basis::from_string(std::string const& mnemonic) {
 // Concurrent read/write is not supported, so no critical section.
 void script_basis::from_operations(operation::list const& ops) {
     ////reset();
-    bytes_ = operations_to_data(ops);
+    bytes_.clear();
+    chunk_ = operations_to_data(ops);
     valid_ = true;
 }
 
@@ -150,6 +159,8 @@ size_t script_basis::serialized_size(operation::list const& ops) {
 void script_basis::reset() {
     bytes_.clear();
     bytes_.shrink_to_fit();
+    chunk_.clear();
+    chunk_.shrink_to_fit();
     valid_ = false;
 }
 
@@ -164,13 +175,13 @@ bool script_basis::is_valid() const {
 //-----------------------------------------------------------------------------
 
 // static
-expect<script_basis> script_basis::from_data(byte_reader& reader, bool prefix) {
+expect<script_basis> script_basis::from_data(byte_reader& reader, bool prefix, std::pmr::memory_resource* resource) {
     if ( ! prefix) {
         auto const bytes = reader.read_remaining_bytes();
         if ( ! bytes) {
             return make_unexpected(bytes.error());
         }
-        return script_basis {data_chunk(std::begin(*bytes), std::end(*bytes)), false};
+        return script_basis {std::pmr::vector<uint8_t>(std::begin(*bytes), std::end(*bytes), resource)};
     }
 
     auto const size = reader.read_size_little_endian();
@@ -187,11 +198,11 @@ expect<script_basis> script_basis::from_data(byte_reader& reader, bool prefix) {
     if ( ! bytes) {
         return make_unexpected(bytes.error());
     }
-    return script_basis {data_chunk(std::begin(*bytes), std::end(*bytes)), false};
+    return script_basis {std::pmr::vector<uint8_t>(std::begin(*bytes), std::end(*bytes), resource)};
 }
 
 // static
-expect<script_basis> script_basis::from_data_with_size(byte_reader& reader, size_t size) {
+expect<script_basis> script_basis::from_data_with_size(byte_reader& reader, size_t size, std::pmr::memory_resource* resource) {
     // The max_script_size constant limits evaluation, but not all scripts evaluate, so use max_block_size to guard memory allocation here.
     if (size > static_absolute_max_block_size()) {
         return make_unexpected(error::script_invalid_size);
@@ -201,7 +212,7 @@ expect<script_basis> script_basis::from_data_with_size(byte_reader& reader, size
     if ( ! bytes) {
         return make_unexpected(bytes.error());
     }
-    return script_basis {data_chunk(std::begin(*bytes), std::end(*bytes)), false};
+    return script_basis {std::pmr::vector<uint8_t>(std::begin(*bytes), std::end(*bytes), resource)};
 }
 
 // Serialization.
@@ -240,7 +251,7 @@ std::string script_basis::to_string(uint32_t active_forks) const {
 //-----------------------------------------------------------------------------
 
 size_t script_basis::serialized_size(bool prefix) const {
-    auto size = bytes_.size();
+    auto size = bytes().size();
 
     if (prefix) {
         size += infrastructure::message::variable_uint_size(size);
@@ -249,8 +260,8 @@ size_t script_basis::serialized_size(bool prefix) const {
     return size;
 }
 
-data_chunk const& script_basis::bytes() const {
-    return bytes_;
+byte_span script_basis::bytes() const {
+    return chunk_.empty() ? byte_span(bytes_) : byte_span(chunk_);
 }
 
 // Signing (unversioned).
@@ -0,0 +1,52 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/script_cache.hpp>
+
+#include <kth/domain/chain/transaction.hpp>
+#include <kth/infrastructure/utility/random.hpp>
+
+namespace kth::domain::chain {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+script_cache::script_cache(size_t memory, size_t shards)
+    : cuckoo_cache(memory, shards)
+{
+    // The salt fills the first block, the copies of the context resume it.
+    sha256_context::block_type salt;
+    pseudo_random_fill(salt.data(), salt.size());
+    salted_.write(salt.data(), salt.size());
+}
+
+// static
+script_cache& script_cache::global() {
+    static script_cache instance;
+    return instance;
+}
+
+// Cache.
+//-----------------------------------------------------------------------------
+
+hash_digest script_cache::entry(transaction const& tx, uint32_t forks) const {
+    auto context = salted_;
+    context.write_hash(tx.hash());
+    context.write_4_bytes_little_endian(forks);
+
+    // The previous outputs are serialized into the digest as they are.
+    for (auto const& input : tx.inputs()) {
+        auto const& prevout = input.previous_output().validation.cache;
+        auto const valid = prevout.is_valid();
+        context.write_byte(valid ? 1 : 0);
+
+        if (valid) {
+            prevout.to_data(context, true);
+        }
+    }
+
+    return context.finalize();
+}
+
+} // namespace kth::domain::chain
@@ -0,0 +1,337 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/script_template.hpp>
+
+#include <array>
+#include <cstdint>
+
+#include <kth/domain/constants.hpp>
+#include <kth/domain/machine/opcode.hpp>
+#include <kth/infrastructure/math/elliptic_curve.hpp>
+#include <kth/infrastructure/math/hash.hpp>
+
+namespace kth::domain::chain::script_template {
+
+using machine::opcode;
+
+namespace {
+
+constexpr auto op_push_size_75 = uint8_t(opcode::push_size_75);
+constexpr auto op_push_one_size = uint8_t(opcode::push_one_size);
+constexpr auto op_push_two_size = uint8_t(opcode::push_two_size);
+constexpr auto op_push_four_size = uint8_t(opcode::push_four_size);
+constexpr auto op_push_negative_1 = uint8_t(opcode::push_negative_1);
+constexpr auto op_push_positive_1 = uint8_t(opcode::push_positive_1);
+constexpr auto op_push_positive_16 = uint8_t(opcode::push_positive_16);
+constexpr auto op_return = uint8_t(opcode::return_);
+constexpr auto op_dup = uint8_t(opcode::dup);
+constexpr auto op_equal = uint8_t(opcode::equal);
+constexpr auto op_equalverify = uint8_t(opcode::equalverify);
+constexpr auto op_hash160 = uint8_t(opcode::hash160);
+constexpr auto op_hash256 = uint8_t(opcode::hash256);
+constexpr auto op_checksig = uint8_t(opcode::checksig);
+constexpr auto op_checksigverify = uint8_t(opcode::checksigverify);
+constexpr auto op_checkmultisig = uint8_t(opcode::checkmultisig);
+constexpr auto op_checkmultisigverify = uint8_t(opcode::checkmultisigverify);
+constexpr auto op_invalid = uint8_t(opcode::invalidopcode);
+
+// The longest output template, a 16 of 16 multisig.
+constexpr size_t max_template_operations = 16 + 3;
+
+// An operation borrowed from the script bytes.
+struct operation_view {
+    uint8_t code;
+    byte_span data;
+};
+
+using operation_views = std::array<operation_view, max_template_operations>;
+
+// Reads the operation at the position and moves past it. A truncated push
+// reads as an invalid operation and ends the script, as in operations().
+operation_view next_operation(byte_span script, size_t& position) {
+    auto const code = script[position++];
+    auto const remaining = script.size() - position;
+
+    size_t prefix = 0;
+    size_t size = 0;
+
+    if (code <= op_push_size_75) {
+        size = code;
+    } else if (code == op_push_one_size && remaining >= 1) {
+        prefix = 1;
+        size = script[position];
+    } else if (code == op_push_two_size && remaining >= 2) {
+        prefix = 2;
+        size = size_t(script[position]) |
+            size_t(script[position + 1]) << 8;
+    } else if (code == op_push_four_size && remaining >= 4) {
+        prefix = 4;
+        size = size_t(script[position]) |
+            size_t(script[position + 1]) << 8 |
+            size_t(script[position + 2]) << 16 |
+            size_t(script[position + 3]) << 24;
+    } else if (code == op_push_one_size || code == op_push_two_size || code == op_push_four_size) {
+        position = script.size();
+        return {op_invalid, {}};
+    }
+
+    if (size > remaining - prefix) {
+        position = script.size();
+        return {op_invalid, {}};
+    }
+
+    auto const data = script.subspan(position + prefix, size);
+    position += prefix + size;
+    return {code, data};
+}
+
+// The operation count, or max_template_operations + 1 if the script is
+// longer than any output template (the operations are then incomplete).
+size_t decode(byte_span script, operation_views& out) {
+    size_t count = 0;
+    size_t position = 0;
+
+    while (position < script.size()) {
+        if (count == out.size()) {
+            return out.size() + 1;
+        }
+
+        out[count++] = next_operation(script, position);
+    }
+
+    return count;
+}
+
+bool is_public_key(byte_span data) {
+    return kth::is_public_key(data_slice(data.data(), data.data() + data.size()));
+}
+
+bool is_minimal_push(operation_view const& op) {
+    auto const size = op.data.size();
+
+    // Single byte numbers [-1, 1..16] are pushed by their numeric opcodes.
+    if (size == 1) {
+        auto const value = op.data[0];
+
+        if (value == 0x81) {
+            return op.code == op_push_negative_1;
+        }
+
+        if (value == 0x00) {
+            return op.code == 0;
+        }
+
+        if (value >= 1 && value <= 16) {
+            return op.code == op_push_positive_1 + value - 1;
+        }
+    }
+
+    if (size <= op_push_size_75) {
+        return op.code == size;
+    }
+
+    if (size <= max_uint8) {
+        return op.code == op_push_one_size;
+    }
+
+    if (size <= max_uint16) {
+        return op.code == op_push_two_size;
+    }
+
+    return op.code == op_push_four_size;
+}
+
+bool is_pay_public_key_hash(operation_views const& ops, size_t count) {
+    return count == 5 &&
+        ops[0].code == op_dup &&
+        ops[1].code == op_hash160 &&
+        ops[2].data.size() == short_hash_size &&
+        ops[3].code == op_equalverify &&
+        ops[4].code == op_checksig;
+}
+
+bool is_pay_public_key(operation_views const& ops, size_t count) {
+    return count == 2 &&
+        is_public_key(ops[0].data) &&
+        ops[1].code == op_checksig;
+}
+
+bool is_pay_multisig(operation_views const& ops, size_t count) {
+    if (count < 4 || count > max_template_operations || ops[count - 1].code != op_checkmultisig) {
+        return false;
+    }
+
+    auto const op_m = ops[0].code;
+    auto const op_n = ops[count - 2].code;
+
+    if (op_m < op_push_positive_1 || op_m > op_n || op_n < op_push_positive_1 || op_n > op_push_positive_16) {
+        return false;
+    }
+
+    if (size_t(op_n - op_push_positive_1 + 1) != count - 3) {
+        return false;
+    }
+
+    for (size_t index = 1; index < count - 2; ++index) {
+        if ( ! is_public_key(ops[index].data)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool is_null_data(operation_views const& ops, size_t count) {
+    return count == 2 &&
+        ops[0].code == op_return &&
+        is_minimal_push(ops[1]) &&
+        ops[1].data.size() <= max_null_data_size;
+}
+
+} // namespace
+
+bool is_pay_public_key_hash(byte_span script) {
+    // The minimal encoding, then any other encoding of the 20 byte push.
+    if (script.size() == 25) {
+        return script[0] == op_dup &&
+            script[1] == op_hash160 &&
+            script[2] == short_hash_size &&
+            script[23] == op_equalverify &&
+            script[24] == op_checksig;
+    }
+
+    if (script.size() < 25 || script.size() > 29) {
+        return false;
+    }
+
+    operation_views ops;
+    return is_pay_public_key_hash(ops, decode(script, ops));
+}
+
+//*****************************************************************************
+// CONSENSUS: this pattern is used to activate bip16 validation rules.
+//*****************************************************************************
+bool is_pay_script_hash(byte_span script) {
+    return script.size() == 23 &&
+        script[0] == op_hash160 &&
+        script[1] == short_hash_size &&
+        script[22] == op_equal;
+}
+
+bool is_pay_script_hash_32(byte_span script) {
+    return script.size() == 35 &&
+        script[0] == op_hash256 &&
+        script[1] == hash_size &&
+        script[34] == op_equal;
+}
+
+bool is_pay_public_key(byte_span script) {
+    // The minimal encodings of compressed and uncompressed keys.
+    if (script.size() == ec_compressed_size + 2 || script.size() == ec_uncompressed_size + 2) {
+        if (script[0] == script.size() - 2) {
+            return script.back() == op_checksig &&
+                is_public_key(script.subspan(1, script.size() - 2));
+        }
+    }
+
+    operation_views ops;
+    return is_pay_public_key(ops, decode(script, ops));
+}
+
+bool is_pay_multisig(byte_span script) {
+    if (script.empty() || script.back() != op_checkmultisig) {
+        return false;
+    }
+
+    operation_views ops;
+    return is_pay_multisig(ops, decode(script, ops));
+}
+
+bool is_null_data(byte_span script) {
+    if (script.empty() || script[0] != op_return) {
+        return false;
+    }
+
+    operation_views ops;
+    return is_null_data(ops, decode(script, ops));
+}
+
+// Output patterns are mutually and input unambiguous.
+script_pattern output_pattern(byte_span script) {
+    if (is_pay_script_hash(script)) {
+        return script_pattern::pay_script_hash;
+    }
+
+    if (is_pay_script_hash_32(script)) {
+        return script_pattern::pay_script_hash_32;
+    }
+
+    // The remaining templates share one decoding of the operations.
+    operation_views ops;
+    auto const count = decode(script, ops);
+
+    if (is_pay_public_key_hash(ops, count)) {
+        return script_pattern::pay_public_key_hash;
+    }
+
+    if (is_null_data(ops, count)) {
+        return script_pattern::null_data;
+    }
+
+    if (is_pay_public_key(ops, count)) {
+        return script_pattern::pay_public_key;
+    }
+
+    if (is_pay_multisig(ops, count)) {
+        return script_pattern::pay_multisig;
+    }
+
+    return script_pattern::non_standard;
+}
+
+byte_span output_payload(byte_span script, script_pattern pattern) {
+    operation_views ops;
+
+    switch (pattern) {
+        case script_pattern::pay_public_key_hash:
+            return is_pay_public_key_hash(ops, decode(script, ops)) ? ops[2].data : byte_span{};
+        case script_pattern::pay_script_hash:
+            return is_pay_script_hash(script) ? script.subspan(2, short_hash_size) : byte_span{};
+        case script_pattern::pay_script_hash_32:
+            return is_pay_script_hash_32(script) ? script.subspan(2, hash_size) : byte_span{};
+        case script_pattern::pay_public_key:
+            return is_pay_public_key(ops, decode(script, ops)) ? ops[0].data : byte_span{};
+        default:
+            return {};
+    }
+}
+
+size_t sigops(byte_span script, bool accurate) {
+    size_t total = 0;
+    size_t position = 0;
+    auto preceding = op_invalid;
+
+    while (position < script.size()) {
+        auto const code = next_operation(script, position).code;
+
+        if (code == op_checksig || code == op_checksigverify) {
+            ++total;
+        } else if (code == op_checkmultisig || code == op_checkmultisigverify) {
+            // Count 1..16 multisig accurately for embedded (bip16) scripts.
+            auto const positive = preceding >= op_push_positive_1 && preceding <= op_push_positive_16;
+            total += accurate && positive ? size_t(preceding - op_push_positive_1 + 1) : multisig_default_sigops;
+        }
+
+        preceding = code;
+    }
+
+    return total;
+}
+
+bool is_unspendable(byte_span script) {
+    return ( ! script.empty() && script[0] == op_return) || script.size() > max_script_size;
+}
+
+} // namespace kth::domain::chain::script_template
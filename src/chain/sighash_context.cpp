@@ -0,0 +1,197 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/sighash_context.hpp>
+
+#include <kth/domain/chain/script.hpp>
+#include <kth/domain/chain/token_data.hpp>
+#include <kth/domain/machine/rule_fork.hpp>
+#include <kth/infrastructure/machine/sighash_algorithm.hpp>
+#include <kth/infrastructure/utility/assert.hpp>
+
+using namespace kth::infrastructure::machine;
+
+namespace kth::domain::chain {
+
+//*****************************************************************************
+// CONSENSUS: see script_basis::generate_version_0_signature_hash, the
+// preimage produced here must be byte for byte identical.
+//*****************************************************************************
+inline
+sighash_algorithm to_sighash_enum(uint8_t sighash_type) {
+    switch (sighash_type & sighash_algorithm::mask) {
+        case sighash_algorithm::single:
+            return sighash_algorithm::single;
+        case sighash_algorithm::none:
+            return sighash_algorithm::none;
+        default:
+            return sighash_algorithm::all;
+    }
+}
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+sighash_context::sighash_context(transaction const& tx, uint32_t active_forks)
+    : tx_(&tx)
+    , active_forks_(active_forks)
+    , descartes_(script::is_enabled(active_forks, machine::rule_fork::bch_descartes))
+    , utxos_hash_(null_hash)
+{
+    // One pass over each component, streamed without serialization buffers.
+    sha256_context inpoints;
+    sha256_context sequences;
+    sha256_context utxos;
+
+    for (auto const& input : tx.inputs()) {
+        input.previous_output().to_data(inpoints);
+        sequences.write_4_bytes_little_endian(input.sequence());
+
+        if (descartes_) {
+            auto const& prevout = input.previous_output().validation.cache;
+            if (prevout.is_valid()) {
+                prevout.to_data(utxos);
+            }
+        }
+    }
+
+    sha256_context outputs;
+    for (auto const& output : tx.outputs()) {
+        output.to_data(outputs, true);
+    }
+
+    inpoints_hash_ = inpoints.finalize_double();
+    sequences_hash_ = sequences.finalize_double();
+    outputs_hash_ = outputs.finalize_double();
+
+    if (descartes_) {
+        utxos_hash_ = utxos.finalize_double();
+    }
+
+    for (size_t flags = 0; flags < prefixes_.size(); ++flags) {
+        auto const any = (flags & any_flag) != 0;
+        auto const all = (flags & all_flag) != 0;
+        auto const with_utxos = (flags & utxos_flag) != 0;
+        auto& midstate = prefixes_[flags];
+
+        // 1. transaction version (4-byte little endian).
+        midstate.write_4_bytes_little_endian(tx.version());
+
+        // 2. inpoints hash (32-byte hash).
+        midstate.write_hash( ! any ? inpoints_hash_ : null_hash);
+
+        // 3. Optional utxos hash (32-byte hash).
+        if (descartes_ && with_utxos) {
+            midstate.write_hash(utxos_hash_);
+        }
+
+        // 4. sequences hash (32-byte hash).
+        midstate.write_hash( ! any && all ? sequences_hash_ : null_hash);
+    }
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+transaction const& sighash_context::tx() const {
+    return *tx_;
+}
+
+uint32_t sighash_context::active_forks() const {
+    return active_forks_;
+}
+
+hash_digest const& sighash_context::inpoints_hash() const {
+    return inpoints_hash_;
+}
+
+hash_digest const& sighash_context::sequences_hash() const {
+    return sequences_hash_;
+}
+
+hash_digest const& sighash_context::outputs_hash() const {
+    return outputs_hash_;
+}
+
+hash_digest const& sighash_context::utxos_hash() const {
+    return utxos_hash_;
+}
+
+// private
+sha256_context const& sighash_context::prefix(bool any, bool all, bool utxos) const {
+    return prefixes_[(any ? any_flag : 0) | (all ? all_flag : 0) | (utxos ? utxos_flag : 0)];
+}
+
+// Signing.
+//-----------------------------------------------------------------------------
+
+std::pair<hash_digest, size_t> sighash_context::signature_hash(uint32_t input_index, script_basis const& script_code, uint64_t value, uint8_t sighash_type) const {
+    auto const& tx = *tx_;
+
+    // Unlike unversioned algorithm this does not allow an invalid input index.
+    KTH_ASSERT(input_index < tx.inputs().size());
+    auto const& input = tx.inputs()[input_index];
+    auto const& prevout = input.previous_output().validation.cache;
+    KTH_ASSERT(prevout.is_valid());
+
+    // Flags derived from the signature hash byte.
+    auto const sighash = to_sighash_enum(sighash_type);
+    auto const any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
+
+#if defined(KTH_CURRENCY_BCH)
+    auto const single = sighash == sighash_algorithm::single ||
+                        sighash == sighash_algorithm::forkid_single ||
+                        sighash == sighash_algorithm::utxos_single;
+    auto const all = sighash == sighash_algorithm::all ||
+                     sighash == sighash_algorithm::forkid_all ||
+                     sighash == sighash_algorithm::utxos_all;
+    auto const utxos = (sighash_type & sighash_algorithm::utxos) != 0;
+#else
+    auto const single = sighash == sighash_algorithm::single;
+    auto const all = sighash == sighash_algorithm::all;
+    auto const utxos = false;
+#endif
+
+    // 1. to 4. are shared by all inputs.
+    auto sink = prefix(any, all, utxos);
+
+    // 5. outpoint (32-byte hash + 4-byte little endian).
+    input.previous_output().to_data(sink);
+
+    // 6. Optional token data (variable size).
+    if (descartes_ && prevout.token_data().has_value()) {
+        sink.write_byte(chain::encoding::PREFIX_BYTE);
+        chain::token::encoding::to_data(sink, prevout.token_data().value());
+    }
+
+    // 7. script of the input (with prefix).
+    script_code.to_data(sink, true);
+
+    // 8. value of the output spent by this input (8-byte little endian).
+    sink.write_8_bytes_little_endian(value);
+
+    // 9. sequence of the input (4-byte little endian).
+    sink.write_4_bytes_little_endian(input.sequence());
+
+    // 10. outputs hash (32-byte hash).
+    if (all) {
+        sink.write_hash(outputs_hash_);
+    } else if (single && input_index < tx.outputs().size()) {
+        sha256_context output;
+        tx.outputs()[input_index].to_data(output, true);
+        sink.write_hash(output.finalize_double());
+    } else {
+        sink.write_hash(null_hash);
+    }
+
+    // 11. transaction locktime (4-byte little endian).
+    sink.write_4_bytes_little_endian(tx.locktime());
+
+    // 12. sighash type of the signature (4-byte [not 1] little endian).
+    sink.write_4_bytes_little_endian(sighash_type);
+
+    return {sink.finalize_double(), size_t(sink.size())};
+}
+
+} // namespace kth::domain::chain
@@ -23,6 +23,11 @@
 #include <kth/domain/chain/input.hpp>
 #include <kth/domain/chain/output.hpp>
 #include <kth/domain/chain/script.hpp>
+#include <kth/domain/chain/script_cache.hpp>
+#include <kth/domain/chain/script_template.hpp>
+#include <kth/domain/chain/sighash_context.hpp>
+#include <kth/domain/chain/verification_context.hpp>
+#include <kth/domain/chain/verification_pool.hpp>
 #include <kth/domain/constants.hpp>
 #include <kth/domain/machine/opcode.hpp>
 #include <kth/domain/machine/operation.hpp>
@@ -72,19 +77,14 @@ transaction::transaction(uint32_t version, uint32_t locktime, input::list&& inpu
 transaction::transaction(transaction const& x, hash_digest const& hash)
     : transaction_basis(x)
     , validation(x.validation)
-{
-    hash_ = std::make_shared<hash_digest>(hash);
-    // validation = x.validation;
-}
+    , hash_(hash)
+{}
 
 transaction::transaction(transaction&& x, hash_digest const& hash)
     : transaction_basis(std::move(x))
     , validation(std::move(x.validation))
-{
-    hash_ = std::make_shared<hash_digest>(hash);
-    // validation = std::move(x.validation);
-}
-
+    , hash_(hash)
+{}
 
 transaction::transaction(transaction_basis const& x)
     : transaction_basis(x)
@@ -94,28 +94,6 @@ transaction::transaction(transaction_basis&& x) noexcept
     : transaction_basis(std::move(x))
 {}
 
-transaction::transaction(transaction const& x)
-    : transaction_basis(x)
-    , validation(x.validation)
-{}
-
-transaction::transaction(transaction&& x) noexcept
-    : transaction_basis(std::move(x))
-    , validation(std::move(x.validation))
-{}
-
-transaction& transaction::operator=(transaction const& x) {
-    transaction_basis::operator=(x);
-    validation = x.validation;
-    return *this;
-}
-
-transaction& transaction::operator=(transaction&& x) noexcept {
-    transaction_basis::operator=(std::move(static_cast<transaction_basis&&>(x)));
-    validation = std::move(x.validation);
-    return *this;
-}
-
 // protected
 void transaction::reset() {
     transaction_basis::reset();
@@ -123,17 +101,17 @@ void transaction::reset() {
     outputs_hash_.reset();
     inpoints_hash_.reset();
     sequences_hash_.reset();
-    segregated_ = std::nullopt;
-    total_input_value_ = std::nullopt;
-    total_output_value_ = std::nullopt;
+    utxos_hash_.reset();
+    total_input_value_.reset();
+    total_output_value_.reset();
 }
 
 // Deserialization.
 //-----------------------------------------------------------------------------
 
 // static
-expect<transaction> transaction::from_data(byte_reader& reader, bool wire) {
-    auto basis = transaction_basis::from_data(reader, wire);
+expect<transaction> transaction::from_data(byte_reader& reader, bool wire, std::pmr::memory_resource* resource) {
+    auto basis = transaction_basis::from_data(reader, wire, resource);
     if ( ! basis) {
         return make_unexpected(basis.error());
     }
@@ -190,31 +168,22 @@ void transaction::set_locktime(uint32_t value) {
 
 void transaction::set_inputs(input::list const& value) {
     transaction_basis::set_inputs(value);
-    invalidate_cache();
-    inpoints_hash_.reset();
-    sequences_hash_.reset();
-    segregated_ = std::nullopt;
-    total_input_value_ = std::nullopt;
+    invalidate_input_cache();
 }
 
 void transaction::set_inputs(input::list&& value) {
     transaction_basis::set_inputs(std::move(value));
-    invalidate_cache();
-    segregated_ = std::nullopt;
-    total_input_value_ = std::nullopt;
+    invalidate_input_cache();
 }
 
 void transaction::set_outputs(output::list const& value) {
     transaction_basis::set_outputs(value);
-    invalidate_cache();
-    outputs_hash_.reset();
-    total_output_value_ = std::nullopt;
+    invalidate_output_cache();
 }
 
 void transaction::set_outputs(output::list&& value) {
     transaction_basis::set_outputs(std::move(value));
-    invalidate_cache();
-    total_output_value_ = std::nullopt;
+    invalidate_output_cache();
 }
 
 // Cache.
@@ -222,210 +191,58 @@ void transaction::set_outputs(output::list&& value) {
 
 // protected
 void transaction::invalidate_cache() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if (hash_) {
-        hash_mutex_.unlock_upgrade_and_lock();
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_.reset();
-        //---------------------------------------------------------------------
-        hash_mutex_.unlock_and_lock_upgrade();
-    }
+    hash_.reset();
+}
 
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if ( ! hash_) {
-            return;
-        }
-    }
+// private
+void transaction::invalidate_input_cache() const {
+    invalidate_cache();
+    inpoints_hash_.reset();
+    sequences_hash_.reset();
+    utxos_hash_.reset();
+    total_input_value_.reset();
+}
 
-    std::unique_lock lock(hash_mutex_);
-    hash_.reset();
-#endif
+// private
+void transaction::invalidate_output_cache() const {
+    invalidate_cache();
+    outputs_hash_.reset();
+    total_output_value_.reset();
 }
 
 hash_digest transaction::hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade(); //TODO(fernando): use RAII
-
-    if ( ! hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock(); //TODO(fernando): use RAII
-        hash_ = std::make_shared<hash_digest>(chain::hash(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
+    return hash_.get([this] { return chain::hash(*this); });
+}
 
-    auto const hash = *hash_;
-    hash_mutex_.unlock_upgrade();
-///////////////////////////////////////////////////////////////////////////
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (hash_) {
-            return *hash_;
-        }
-    }
+bool transaction::is_hash_cached() const {
+    return hash_.has_value();
+}
 
-    std::unique_lock lock(hash_mutex_);
-    if ( ! hash_) {
-        hash_ = std::make_shared<hash_digest>(chain::hash(*this));
-    }
-    return *hash_;
-#endif
+void transaction::cache_hash(hash_digest const& hash) const {
+    hash_.publish(hash);
 }
 
 hash_digest transaction::outputs_hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if ( ! outputs_hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        outputs_hash_ = std::make_shared<hash_digest>(to_outputs(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *outputs_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (outputs_hash_) {
-            return *outputs_hash_;
-        }
-    }
-    std::unique_lock lock(hash_mutex_);
-    if ( ! outputs_hash_) {
-        outputs_hash_ = std::make_shared<hash_digest>(to_outputs(*this));
-    }
-    return *outputs_hash_;
-
-#endif
+    return outputs_hash_.get([this] { return to_outputs(*this); });
 }
 
 hash_digest transaction::inpoints_hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if ( ! inpoints_hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        inpoints_hash_ = std::make_shared<hash_digest>(to_inpoints(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *inpoints_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (inpoints_hash_) {
-            return *inpoints_hash_;
-        }
-    }
-    std::unique_lock lock(hash_mutex_);
-    if ( ! inpoints_hash_) {
-        inpoints_hash_ = std::make_shared<hash_digest>(to_inpoints(*this));
-    }
-    return *inpoints_hash_;
-#endif
+    return inpoints_hash_.get([this] { return to_inpoints(*this); });
 }
 
 hash_digest transaction::sequences_hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if ( ! sequences_hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        sequences_hash_ = std::make_shared<hash_digest>(to_sequences(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *sequences_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (sequences_hash_) {
-            return *sequences_hash_;
-        }
-    }
-    std::unique_lock lock(hash_mutex_);
-    if ( ! sequences_hash_) {
-        sequences_hash_ = std::make_shared<hash_digest>(to_sequences(*this));
-    }
-    return *sequences_hash_;
-#endif
+    return sequences_hash_.get([this] { return to_sequences(*this); });
 }
 
 hash_digest transaction::utxos_hash() const {
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    hash_mutex_.lock_upgrade();
-
-    if ( ! utxos_hash_) {
-        //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-        hash_mutex_.unlock_upgrade_and_lock();
-        utxos_hash_ = std::make_shared<hash_digest>(to_utxos(*this));
-        hash_mutex_.unlock_and_lock_upgrade();
-        //-----------------------------------------------------------------
-    }
-
-    auto const hash = *utxos_hash_;
-    hash_mutex_.unlock_upgrade();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return hash;
-#else
-    {
-        std::shared_lock lock(hash_mutex_);
-        if (utxos_hash_) {
-            return *utxos_hash_;
-        }
-    }
-    std::unique_lock lock(hash_mutex_);
-    if ( ! utxos_hash_) {
-        utxos_hash_ = std::make_shared<hash_digest>(to_utxos(*this));
-    }
-    return *utxos_hash_;
-#endif
+    return utxos_hash_.get([this] { return to_utxos(*this); });
 }
 
 // Utilities.
 //-----------------------------------------------------------------------------
 
 void transaction::recompute_hash() {
-    hash_ = nullptr;
+    hash_.reset();
     hash();
 }
 
@@ -434,81 +251,12 @@ void transaction::recompute_hash() {
 
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_input_value() const {
-
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_input_value_ != std::nullopt) {
-        auto const value = total_input_value_.value();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-    auto const value = chain::total_input_value(*this);
-    total_input_value_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if (total_input_value_ != std::nullopt) {
-            return total_input_value_.value();
-        }
-    }
-    std::unique_lock lock(mutex_);
-    if (total_input_value_ == std::nullopt) {
-        total_input_value_ = chain::total_input_value(*this);
-    }
-    return total_input_value_.value();
-#endif
+    return total_input_value_.get([this] { return chain::total_input_value(*this); });
 }
 
 // Returns max_uint64 in case of overflow.
 uint64_t transaction::total_output_value() const {
-
-#if ! defined(__EMSCRIPTEN__)
-    ///////////////////////////////////////////////////////////////////////////
-    // Critical Section
-    mutex_.lock_upgrade();
-
-    if (total_output_value_ != std::nullopt) {
-        auto const value = total_output_value_.value();
-        mutex_.unlock_upgrade();
-        //---------------------------------------------------------------------
-        return value;
-    }
-
-    mutex_.unlock_upgrade_and_lock();
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-
-    auto const value = chain::total_output_value(*this);
-    total_output_value_ = value;
-    mutex_.unlock();
-    ///////////////////////////////////////////////////////////////////////////
-
-    return value;
-#else
-    {
-        std::shared_lock lock(mutex_);
-        if (total_output_value_ != std::nullopt) {
-            return total_output_value_.value();
-        }
-    }
-
-    std::unique_lock lock(mutex_);
-    if (total_output_value_ == std::nullopt) {
-        total_output_value_ = chain::total_output_value(*this);
-    }
-    return total_output_value_.value();
-#endif
+    return total_output_value_.get([this] { return chain::total_output_value(*this); });
 }
 
 uint64_t transaction::fees() const {
@@ -535,6 +283,15 @@ size_t transaction::signature_operations() const {
 
 // Coinbase transactions return success, to simplify iteration.
 code transaction::connect_input(chain_state const& state, size_t input_index) const {
+    return connect_input(state, input_index, nullptr);
+}
+
+code transaction::connect_input(chain_state const& state, size_t input_index, sighash_context const& context) const {
+    return connect_input(state, input_index, &context);
+}
+
+// private
+code transaction::connect_input(chain_state const& state, size_t input_index, sighash_context const* context) const {
     if (input_index >= inputs().size()) {
         return error::operation_failed;
     }
@@ -555,7 +312,7 @@ code transaction::connect_input(chain_state const& state, size_t input_index) co
 
     // Verify the transaction input script against the previous output.
     // return script::verify(*this, index32, forks);
-    return verify(*this, index32, forks);
+    return verify(*this, index32, forks, context);
 }
 
 // Validation.
@@ -582,23 +339,57 @@ code transaction::connect() const {
 }
 
 code transaction::connect(chain_state const& state) const {
+    if (is_coinbase()) {
+        return error::success;
+    }
+
+    // Transactions connected for the mempool are not interpreted again.
+    auto& cache = script_cache::global();
+    auto const entry = cache.entry(*this, state.enabled_forks());
+
+    if (cache.contains(entry)) {
+        return error::success;
+    }
+
+    // The signature hash components are shared by all inputs.
+    sighash_context const context(*this, state.enabled_forks());
     code ec;
 
     for (size_t input = 0; input < inputs().size(); ++input) {
-        if ((ec = connect_input(state, input))) {
+        if ((ec = connect_input(state, input, context))) {
             return ec;
         }
     }
 
+    cache.insert(entry);
     return error::success;
 }
 
-code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script const& input_script, script const& prevout_script, uint64_t /*value*/) {
+// Inputs are verified concurrently, the result matches the serial overload.
+code transaction::connect(chain_state const& state, verification_pool& pool) const {
+    return pool.connect(*this, state);
+}
+
+// Each verifying thread reuses its context across inputs.
+static
+verification_context& thread_verification_context() {
+    thread_local verification_context context;
+    return context;
+}
+
+code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script const& input_script, script const& prevout_script, uint64_t value, sighash_context const* context) {
+    return verify(tx, input_index, forks, input_script, prevout_script, value, context, thread_verification_context());
+}
+
+code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script const& input_script, script const& prevout_script, uint64_t /*value*/, sighash_context const* context, verification_context& verification) {
     using machine::program;
     code ec;
 
+    // The programs of the previous input are gone, rewind their arena.
+    verification.reset();
+
     // Evaluate input script.
-    program input(input_script, tx, input_index, forks);
+    program input(input_script, tx, input_index, forks, context, verification.resource());
     if ((ec = input.evaluate())) {
         return ec;
     }
@@ -611,8 +402,6 @@ code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script
 
     // This precludes bare witness programs of -0 (undocumented).
     if ( ! prevout.stack_result(false)) {
-        fmt::print("verify() - embedded.stack_result(false) - 1\n");
-        std::terminate();
         return error::stack_false;
     }
 
@@ -624,17 +413,22 @@ code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script
         }
 
         // Embedded script must be at the top of the stack (bip16).
-        script embedded_script(input.pop(), false);
+        auto const redeem = input.pop();
+
+        // The redeem script is committed to by the prevout script hash.
+        auto const prevout_bytes = prevout_script.bytes();
+        auto const script_hash = script_template::is_pay_script_hash(prevout_bytes) ?
+            prevout_bytes.subspan(2, short_hash_size) : prevout_bytes.subspan(2, hash_size);
+
+        auto const& embedded_script = verification.redeem_scripts().get(script_hash, redeem, forks);
 
-        program embedded(embedded_script, std::move(input), true);
+        program embedded(embedded_script.redeem, embedded_script.compiled, std::move(input));
         if ((ec = embedded.evaluate())) {
             return ec;
         }
 
         // This precludes embedded witness programs of -0 (undocumented).
         if ( ! embedded.stack_result(false)) {
-            fmt::print("verify() - embedded.stack_result(false) - 2\n");
-            std::terminate();
             return error::stack_false;
         }
     }
@@ -642,14 +436,14 @@ code verify(transaction const& tx, uint32_t input_index, uint32_t forks, script
     return error::success;
 }
 
-code verify(transaction const& tx, uint32_t input, uint32_t forks) {
+code verify(transaction const& tx, uint32_t input, uint32_t forks, sighash_context const* context) {
     if (input >= tx.inputs().size()) {
         return error::operation_failed;
     }
 
     auto const& in = tx.inputs()[input];
     auto const& prevout = in.previous_output().validation.cache;
-    return verify(tx, input, forks, in.script(), prevout.script(), prevout.value());
+    return verify(tx, input, forks, in.script(), prevout.script(), prevout.value(), context);
 
 }
 
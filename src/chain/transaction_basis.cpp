@@ -23,6 +23,7 @@
 #include <kth/domain/machine/opcode.hpp>
 #include <kth/domain/machine/operation.hpp>
 #include <kth/domain/machine/rule_fork.hpp>
+#include <kth/domain/math/sha256.hpp>
 #include <kth/domain/multi_crypto_support.hpp>
 #include <kth/infrastructure/error.hpp>
 #include <kth/infrastructure/math/hash.hpp>
@@ -85,18 +86,18 @@ bool transaction_basis::is_valid() const {
 //-----------------------------------------------------------------------------
 
 // static
-expect<transaction_basis> transaction_basis::from_data(byte_reader& reader, bool wire /*= true*/) {
+expect<transaction_basis> transaction_basis::from_data(byte_reader& reader, bool wire /*= true*/, std::pmr::memory_resource* resource) {
     if (wire) {
         // Wire (satoshi protocol) deserialization.
         auto const version = reader.read_little_endian<uint32_t>();
         if ( ! version) {
             return make_unexpected(version.error());
         }
-        auto inputs = read_collection<chain::input>(reader, wire);
+        auto inputs = read_pmr_collection<chain::input>(reader, resource, wire);
         if ( ! inputs) {
             return make_unexpected(inputs.error());
         }
-        auto outputs = read_collection<chain::output>(reader, wire);
+        auto outputs = read_pmr_collection<chain::output>(reader, resource, wire);
         if ( ! outputs) {
             return make_unexpected(outputs.error());
         }
@@ -113,11 +114,11 @@ expect<transaction_basis> transaction_basis::from_data(byte_reader& reader, bool
     }
 
     // Database (outputs forward) serialization.
-    auto outputs = read_collection<chain::output>(reader, wire);
+    auto outputs = read_pmr_collection<chain::output>(reader, resource, wire);
     if ( ! outputs) {
         return make_unexpected(outputs.error());
     }
-    auto inputs = read_collection<chain::input>(reader, wire);
+    auto inputs = read_pmr_collection<chain::input>(reader, resource, wire);
     if ( ! inputs) {
         return make_unexpected(inputs.error());
     }
@@ -569,7 +570,10 @@ bool transaction_basis::is_standard() const {
 }
 
 hash_digest hash(transaction_basis const& tx) {
-    return bitcoin_hash(tx.to_data(true));
+    // Streamed into the hash, without a serialization buffer.
+    sha256_context context;
+    tx.to_data(context, true);
+    return context.finalize_double();
 }
 
 hash_digest outputs_hash(transaction_basis const& tx) {
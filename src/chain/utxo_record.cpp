@@ -0,0 +1,395 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/utxo_record.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <kth/domain/chain/script_template.hpp>
+#include <kth/domain/chain/token_data_serialization.hpp>
+#include <kth/domain/constants.hpp>
+#include <kth/domain/machine/opcode.hpp>
+#include <kth/infrastructure/math/elliptic_curve.hpp>
+#include <kth/infrastructure/utility/assert.hpp>
+
+namespace kth::domain::chain {
+
+using machine::opcode;
+
+namespace {
+
+constexpr uint8_t pay_key_hash = 0;
+constexpr uint8_t pay_script_hash = 1;
+constexpr uint8_t pay_public_key_even = 2;
+constexpr uint8_t pay_public_key_odd = 3;
+constexpr uint8_t pay_script_hash_32 = 4;
+
+constexpr uint8_t coinbase_flag = 1;
+constexpr uint8_t token_flag = 2;
+
+size_t varint_size(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+void write_varint(data_chunk& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(uint8_t(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(uint8_t(value));
+}
+
+expect<uint64_t> read_varint(byte_reader& reader) {
+    uint64_t value = 0;
+
+    for (size_t shift = 0; shift < 64; shift += 7) {
+        auto const byte = reader.read_byte();
+        if ( ! byte) {
+            return make_unexpected(byte.error());
+        }
+
+        value |= uint64_t(*byte & 0x7f) << shift;
+        if ((*byte & 0x80) == 0) {
+            return value;
+        }
+    }
+
+    return make_unexpected(error::invalid_size);
+}
+
+uint8_t to_byte(opcode code) {
+    return static_cast<uint8_t>(code);
+}
+
+// The script kind and the bytes that identify the script within it. Only
+// the minimal encodings are compressed, so that they rebuild exactly.
+std::pair<uint64_t, byte_span> to_template(byte_span script) {
+    if (script.size() == 25 && script_template::is_pay_public_key_hash(script)) {
+        return {pay_key_hash, script.subspan(3, short_hash_size)};
+    }
+
+    if (script_template::is_pay_script_hash(script)) {
+        return {pay_script_hash, script.subspan(2, short_hash_size)};
+    }
+
+    if (script_template::is_pay_script_hash_32(script)) {
+        return {pay_script_hash_32, script.subspan(2, hash_size)};
+    }
+
+    // A compressed key, its prefix is the kind.
+    if (script.size() == 35 && script[0] == ec_compressed_size && script_template::is_pay_public_key(script)) {
+        auto const kind = script[1] == 0x02 ? pay_public_key_even : pay_public_key_odd;
+        return {kind, script.subspan(2, hash_size)};
+    }
+
+    return {utxo_record::special_scripts + script.size(), script};
+}
+
+data_chunk from_template(uint8_t kind, byte_span payload) {
+    data_chunk script;
+
+    switch (kind) {
+        case pay_key_hash:
+            script.reserve(25);
+            script.push_back(to_byte(opcode::dup));
+            script.push_back(to_byte(opcode::hash160));
+            script.push_back(uint8_t(short_hash_size));
+            script.insert(script.end(), payload.begin(), payload.end());
+            script.push_back(to_byte(opcode::equalverify));
+            script.push_back(to_byte(opcode::checksig));
+            break;
+        case pay_script_hash:
+            script.reserve(23);
+            script.push_back(to_byte(opcode::hash160));
+            script.push_back(uint8_t(short_hash_size));
+            script.insert(script.end(), payload.begin(), payload.end());
+            script.push_back(to_byte(opcode::equal));
+            break;
+        case pay_script_hash_32:
+            script.reserve(35);
+            script.push_back(to_byte(opcode::hash256));
+            script.push_back(uint8_t(hash_size));
+            script.insert(script.end(), payload.begin(), payload.end());
+            script.push_back(to_byte(opcode::equal));
+            break;
+        default:
+            script.reserve(35);
+            script.push_back(uint8_t(ec_compressed_size));
+            script.push_back(kind == pay_public_key_even ? 0x02 : 0x03);
+            script.insert(script.end(), payload.begin(), payload.end());
+            script.push_back(to_byte(opcode::checksig));
+            break;
+    }
+
+    return script;
+}
+
+size_t template_payload_size(uint8_t kind) {
+    return kind == pay_key_hash || kind == pay_script_hash ? short_hash_size : hash_size;
+}
+
+bool operator<(utxo_key const& key, output_point const& point) {
+    auto const order = std::memcmp(key.hash.data(), point.hash().data(), hash_size);
+    return order < 0 || (order == 0 && key.index < point.index());
+}
+
+bool operator<(utxo_key const& x, utxo_key const& y) {
+    auto const order = std::memcmp(x.hash.data(), y.hash.data(), hash_size);
+    return order < 0 || (order == 0 && x.index < y.index);
+}
+
+} // namespace
+
+// Amount compression.
+//-----------------------------------------------------------------------------
+
+uint64_t compress_amount(uint64_t amount) {
+    if (amount == 0) {
+        return 0;
+    }
+
+    uint64_t exponent = 0;
+    while ((amount % 10) == 0 && exponent < 9) {
+        amount /= 10;
+        ++exponent;
+    }
+
+    if (exponent < 9) {
+        auto const digit = amount % 10;
+        KTH_ASSERT(digit >= 1 && digit <= 9);
+        amount /= 10;
+        return 1 + (amount * 9 + digit - 1) * 10 + exponent;
+    }
+
+    return 1 + (amount - 1) * 10 + 9;
+}
+
+uint64_t decompress_amount(uint64_t compressed) {
+    if (compressed == 0) {
+        return 0;
+    }
+
+    --compressed;
+    auto exponent = compressed % 10;
+    compressed /= 10;
+
+    uint64_t amount = 0;
+    if (exponent < 9) {
+        auto const digit = (compressed % 9) + 1;
+        compressed /= 9;
+        amount = compressed * 10 + digit;
+    } else {
+        amount = compressed + 1;
+    }
+
+    while (exponent != 0) {
+        amount *= 10;
+        --exponent;
+    }
+
+    return amount;
+}
+
+// utxo_record.
+//-----------------------------------------------------------------------------
+
+// static
+expect<utxo_record> utxo_record::from_data(byte_reader& reader) {
+    auto const code = read_varint(reader);
+    if ( ! code) {
+        return make_unexpected(code.error());
+    }
+    if ((*code >> 2) > max_uint32) {
+        return make_unexpected(error::invalid_size);
+    }
+
+    auto const amount = read_varint(reader);
+    if ( ! amount) {
+        return make_unexpected(amount.error());
+    }
+
+    auto const kind = read_varint(reader);
+    if ( ! kind) {
+        return make_unexpected(kind.error());
+    }
+
+    utxo_record record;
+    record.height = uint32_t(*code >> 2);
+    record.coinbase = (*code & coinbase_flag) != 0;
+    record.output.set_value(decompress_amount(*amount));
+
+    if (*kind < special_scripts) {
+        auto const payload = reader.read_bytes(template_payload_size(uint8_t(*kind)));
+        if ( ! payload) {
+            return make_unexpected(payload.error());
+        }
+        record.output.set_script(chain::script(from_template(uint8_t(*kind), *payload), false));
+    } else {
+        auto raw = chain::script::from_data_with_size(reader, *kind - special_scripts);
+        if ( ! raw) {
+            return make_unexpected(raw.error());
+        }
+        record.output.set_script(std::move(*raw));
+    }
+
+    if ((*code & token_flag) != 0) {
+        auto token = token::encoding::from_data(reader);
+        if ( ! token) {
+            return make_unexpected(token.error());
+        }
+        record.output.set_token_data(std::move(*token));
+    }
+
+    return record;
+}
+
+data_chunk utxo_record::to_data() const {
+    data_chunk data;
+    auto const size = serialized_size();
+    data.reserve(size);
+    to_data(data);
+    KTH_ASSERT(data.size() == size);
+    return data;
+}
+
+void utxo_record::to_data(data_chunk& out) const {
+    auto const& token = output.token_data();
+    auto const flags = (coinbase ? coinbase_flag : 0) | (token.has_value() ? token_flag : 0);
+    auto const [kind, payload] = to_template(output.script().bytes());
+
+    write_varint(out, uint64_t(height) << 2 | flags);
+    write_varint(out, compress_amount(output.value()));
+    write_varint(out, kind);
+    out.insert(out.end(), payload.begin(), payload.end());
+
+    if (token.has_value()) {
+        auto const encoded = token::encoding::to_data(token.value());
+        out.insert(out.end(), encoded.begin(), encoded.end());
+    }
+}
+
+size_t utxo_record::serialized_size() const {
+    auto const& token = output.token_data();
+    auto const [kind, payload] = to_template(output.script().bytes());
+
+    return varint_size(uint64_t(height) << 2) +
+        varint_size(compress_amount(output.value())) +
+        varint_size(kind) +
+        payload.size() +
+        token::encoding::serialized_size(token);
+}
+
+utxo utxo_record::to_utxo(output_point const& point) const {
+    utxo result(point, output.value(), output.token_data());
+    result.set_height(height);
+    return result;
+}
+
+// utxo_table_view.
+//-----------------------------------------------------------------------------
+
+utxo_table_view::utxo_table_view(std::span<utxo_key const> keys, byte_span records)
+    : keys_(keys)
+    , records_(records)
+{}
+
+size_t utxo_table_view::size() const {
+    return keys_.size();
+}
+
+// private
+utxo_key const* utxo_table_view::lower_bound(output_point const& point) const {
+    auto const it = std::lower_bound(keys_.begin(), keys_.end(), point,
+        [](utxo_key const& key, output_point const& value) { return key < value; });
+
+    if (it == keys_.end() || it->index != point.index() || it->hash != point.hash()) {
+        return nullptr;
+    }
+
+    return &*it;
+}
+
+bool utxo_table_view::contains(output_point const& point) const {
+    return lower_bound(point) != nullptr;
+}
+
+byte_span utxo_table_view::find_data(output_point const& point) const {
+    auto const key = lower_bound(point);
+    if (key == nullptr || key->offset >= records_.size()) {
+        return {};
+    }
+
+    return records_.subspan(key->offset);
+}
+
+std::optional<utxo_record> utxo_table_view::find(output_point const& point) const {
+    auto const data = find_data(point);
+    if (data.empty()) {
+        return std::nullopt;
+    }
+
+    byte_reader reader(data);
+    auto record = utxo_record::from_data(reader);
+    if ( ! record) {
+        return std::nullopt;
+    }
+
+    return std::move(*record);
+}
+
+// utxo_table.
+//-----------------------------------------------------------------------------
+
+bool utxo_table::insert(output_point const& point, utxo_record const& record) {
+    auto const offset = records_.size();
+    if (offset + record.serialized_size() > max_uint32) {
+        return false;
+    }
+
+    record.to_data(records_);
+    keys_.push_back({point.hash(), point.index(), uint32_t(offset)});
+    sorted_ = sorted_ && (keys_.size() == 1 || keys_[keys_.size() - 2] < keys_.back());
+    return true;
+}
+
+void utxo_table::sort() {
+    if ( ! sorted_) {
+        std::sort(keys_.begin(), keys_.end(), [](utxo_key const& x, utxo_key const& y) { return x < y; });
+        sorted_ = true;
+    }
+}
+
+bool utxo_table::is_sorted() const {
+    return sorted_;
+}
+
+size_t utxo_table::size() const {
+    return keys_.size();
+}
+
+std::span<utxo_key const> utxo_table::keys() const {
+    return keys_;
+}
+
+byte_span utxo_table::records() const {
+    return records_;
+}
+
+utxo_table_view utxo_table::view() const {
+    KTH_ASSERT(sorted_);
+    return {keys_, records_};
+}
+
+std::optional<utxo_record> utxo_table::find(output_point const& point) const {
+    return view().find(point);
+}
+
+} // namespace kth::domain::chain
@@ -0,0 +1,33 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/verification_context.hpp>
+
+namespace kth::domain::chain {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+verification_context::verification_context(size_t arena_size, size_t redeem_scripts)
+    : buffer_(arena_size)
+    , arena_(buffer_.data(), buffer_.size())
+    , redeem_scripts_(redeem_scripts)
+{}
+
+void verification_context::reset() {
+    arena_.release();
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+std::pmr::memory_resource* verification_context::resource() {
+    return &arena_;
+}
+
+redeem_script_cache& verification_context::redeem_scripts() {
+    return redeem_scripts_;
+}
+
+} // namespace kth::domain::chain
@@ -0,0 +1,310 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/chain/verification_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include <kth/domain/chain/script_cache.hpp>
+#include <kth/domain/utility/parallel.hpp>
+#include <kth/infrastructure/error.hpp>
+
+namespace kth::domain::chain {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+verification_pool::verification_pool(size_t threads) {
+    threads = thread_count(threads);
+
+    slices_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        slices_.push_back(std::make_unique<slice>());
+    }
+
+    // The calling thread is worker zero.
+    threads_.reserve(threads - 1);
+    for (size_t i = 1; i < threads; ++i) {
+        threads_.emplace_back([this, i] { loop(i); });
+    }
+}
+
+verification_pool::~verification_pool() {
+    {
+        std::lock_guard lock(mutex_);
+        stopped_ = true;
+    }
+
+    start_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+size_t verification_pool::size() const {
+    return slices_.size();
+}
+
+size_t verification_pool::jobs() const {
+    return jobs_.size();
+}
+
+bool verification_pool::parallel() const {
+    return parallel_;
+}
+
+// Verification.
+//-----------------------------------------------------------------------------
+
+code verification_pool::connect(transaction const& tx, chain_state const& state) {
+    std::lock_guard lock(run_mutex_);
+    jobs_.clear();
+    contexts_.clear();
+    entries_.clear();
+    contexts_.reserve(1);
+    add_jobs(tx, state.enabled_forks());
+    return finish(run(state));
+}
+
+code verification_pool::connect(transaction::list const& txs, chain_state const& state) {
+    std::lock_guard lock(run_mutex_);
+    jobs_.clear();
+    contexts_.clear();
+    entries_.clear();
+
+    // Reserved so that jobs can point into the contexts.
+    contexts_.reserve(txs.size());
+    auto const forks = state.enabled_forks();
+
+    for (auto const& tx : txs) {
+        if ( ! tx.validation.validated) {
+            add_jobs(tx, forks);
+        }
+    }
+
+    return finish(run(state));
+}
+
+// private
+void verification_pool::add_jobs(transaction const& tx, uint32_t forks) {
+    // Coinbase inputs are never connected (see transaction::connect_input).
+    if (tx.is_coinbase()) {
+        return;
+    }
+
+    // Transactions connected for the mempool are not interpreted again.
+    auto& cache = script_cache::global();
+    auto const entry = cache.entry(tx, forks);
+
+    if (cache.contains(entry)) {
+        return;
+    }
+
+    entries_.push_back(entry);
+
+    // The signature hash components are shared by all inputs of the tx.
+    auto const& context = contexts_.emplace_back(tx, forks);
+
+    auto const inputs = static_cast<uint32_t>(tx.inputs().size());
+    for (uint32_t index = 0; index < inputs; ++index) {
+        jobs_.push_back({&tx, &context, index});
+    }
+}
+
+// private
+code verification_pool::run(chain_state const& state) {
+    auto const count = jobs_.size();
+
+    parallel_ = ! threads_.empty() && count >= 2;
+
+    if ( ! parallel_) {
+        return run_serial(state);
+    }
+
+    // Evenly distribute the jobs, workers rebalance by stealing.
+    auto const workers = slices_.size();
+    for (size_t worker = 0; worker < workers; ++worker) {
+        slices_[worker]->begin = count * worker / workers;
+        slices_[worker]->end = count * (worker + 1) / workers;
+    }
+
+    failed_job_ = count;
+    failure_ = error::success;
+
+    {
+        std::lock_guard lock(mutex_);
+        state_ = &state;
+        pending_ = threads_.size();
+        ++generation_;
+    }
+
+    start_.notify_all();
+    work(0);
+
+    {
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return pending_ == 0; });
+        state_ = nullptr;
+    }
+
+    return failed_job_ == count ? error::success : failure_;
+}
+
+// private
+code verification_pool::finish(code ec) {
+    // The set is only cached as a whole, its failing tx is not known here.
+    if ( ! ec) {
+        auto& cache = script_cache::global();
+        for (auto const& entry : entries_) {
+            cache.insert(entry);
+        }
+    }
+
+    return ec;
+}
+
+// private
+code verification_pool::run_serial(chain_state const& state) const {
+    code ec;
+    for (auto const& item : jobs_) {
+        if ((ec = item.tx->connect_input(state, item.index, *item.context))) {
+            return ec;
+        }
+    }
+    return error::success;
+}
+
+// private
+void verification_pool::loop(size_t worker) {
+    size_t generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock lock(mutex_);
+            start_.wait(lock, [&] { return stopped_ || generation_ != generation; });
+
+            if (stopped_) {
+                return;
+            }
+
+            generation = generation_;
+        }
+
+        work(worker);
+
+        {
+            std::lock_guard lock(mutex_);
+            if (--pending_ == 0) {
+                done_.notify_one();
+            }
+        }
+    }
+}
+
+// private
+void verification_pool::work(size_t worker) {
+    size_t job;
+    while (next(worker, job)) {
+        // A job after a known failure cannot change the result, but every job
+        // before it must still run since it may fail first in serial order.
+        if (job > failed_job_) {
+            continue;
+        }
+
+        auto const& item = jobs_[job];
+        auto const ec = item.tx->connect_input(*state_, item.index, *item.context);
+        if (ec) {
+            fail(job, ec);
+        }
+    }
+}
+
+// private
+bool verification_pool::next(size_t worker, size_t& out_job) {
+    auto& own = *slices_[worker];
+
+    while (true) {
+        {
+            std::lock_guard lock(own.mutex);
+            if (own.begin < own.end) {
+                out_job = own.begin++;
+                return true;
+            }
+        }
+
+        if ( ! steal(worker)) {
+            return false;
+        }
+    }
+}
+
+// private
+bool verification_pool::steal(size_t worker) {
+    while (true) {
+        size_t victim = worker;
+        size_t largest = 0;
+
+        for (size_t other = 0; other < slices_.size(); ++other) {
+            if (other == worker) {
+                continue;
+            }
+
+            auto& candidate = *slices_[other];
+            std::lock_guard lock(candidate.mutex);
+            auto const remaining = candidate.end - candidate.begin;
+            if (remaining > largest) {
+                largest = remaining;
+                victim = other;
+            }
+        }
+
+        // All slices are exhausted.
+        if (largest == 0) {
+            return false;
+        }
+
+        size_t begin;
+        size_t end;
+
+        {
+            auto& from = *slices_[victim];
+            std::lock_guard lock(from.mutex);
+            auto const remaining = from.end - from.begin;
+
+            // Lost the race for this slice, look again.
+            if (remaining == 0) {
+                continue;
+            }
+
+            // Take the back half, rounding up so a single job can be stolen.
+            end = from.end;
+            begin = end - (remaining + 1) / 2;
+            from.end = begin;
+        }
+
+        auto& own = *slices_[worker];
+        std::lock_guard lock(own.mutex);
+        own.begin = begin;
+        own.end = end;
+        return true;
+    }
+}
+
+// private
+void verification_pool::fail(size_t job, code ec) {
+    std::lock_guard lock(failure_mutex_);
+    if (job < failed_job_) {
+        failure_ = ec;
+        failed_job_ = job;
+    }
+}
+
+} // namespace kth::domain::chain
@@ -0,0 +1,146 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/machine/bytecode.hpp>
+
+#include <kth/domain/constants.hpp>
+#include <kth/domain/machine/operation.hpp>
+#include <kth/infrastructure/utility/assert.hpp>
+
+namespace kth::domain::machine {
+
+namespace {
+
+constexpr auto op_75 = uint8_t(opcode::push_size_75);
+
+// The size of the push data length that follows the opcode, if any.
+size_t data_prefix_size(opcode code) {
+    switch (code) {
+        case opcode::push_one_size:
+            return 1;
+        case opcode::push_two_size:
+            return 2;
+        case opcode::push_four_size:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+size_t read_data_size(byte_span prefix) {
+    size_t size = 0;
+    for (size_t byte = 0; byte < prefix.size(); ++byte) {
+        size |= size_t(prefix[byte]) << (8 * byte);
+    }
+    return size;
+}
+
+} // namespace
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+bytecode::bytecode(byte_span script, uint32_t active_forks, size_t max_push_size)
+    : script_(script)
+{
+    KTH_ASSERT(script.size() <= max_uint32);
+
+    // One instruction per byte is the upper limit of instructions.
+    instructions_.reserve(script.size());
+
+    size_t position = 0;
+    while (position < script.size()) {
+        auto const offset = position;
+        auto const code = opcode(script[position++]);
+        auto const prefix = data_prefix_size(code);
+        auto const remaining = script.size() - position;
+
+        size_t size = 0;
+        if (prefix != 0 && prefix <= remaining) {
+            size = read_data_size(script.subspan(position, prefix));
+        } else if (uint8_t(code) <= op_75) {
+            size = uint8_t(code);
+        }
+
+        // A truncated push ends the script as an invalid instruction.
+        if (prefix > remaining || size > remaining - prefix) {
+            instructions_.push_back({opcode::invalidopcode, instruction::counted, uint32_t(offset), uint32_t(script.size()), 0, counted_, 0});
+            ++counted_;
+            valid_ = false;
+            break;
+        }
+
+        uint8_t flags = 0;
+        flags |= operation::is_counted(code) ? instruction::counted : 0;
+        flags |= operation::is_conditional(code) ? instruction::conditional : 0;
+        flags |= size > max_push_size ? instruction::oversized : 0;
+        flags |= operation::is_disabled(code, active_forks) ? instruction::disabled : 0;
+
+        instructions_.push_back({code, flags, uint32_t(offset), uint32_t(position + prefix), uint32_t(size), counted_, 0});
+        counted_ += (flags & instruction::counted) != 0 ? 1 : 0;
+        position += prefix + size;
+    }
+
+    // Instructions up to the next conditional are not executed while a
+    // branch is not taken, so they can be skipped by only counting them,
+    // unless one of them must fail (that is left to the step by step run).
+    auto next_conditional = uint32_t(instructions_.size());
+    auto skippable = true;
+
+    for (auto index = instructions_.size(); index-- != 0;) {
+        auto& current = instructions_[index];
+        current.skip = skippable ? next_conditional : uint32_t(index + 1);
+
+        if ((current.flags & instruction::conditional) != 0) {
+            next_conditional = uint32_t(index);
+            skippable = true;
+        } else if ((current.flags & (instruction::oversized | instruction::disabled)) != 0) {
+            skippable = false;
+        }
+    }
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+bool bytecode::is_valid() const {
+    return valid_;
+}
+
+bool bytecode::empty() const {
+    return instructions_.empty();
+}
+
+size_t bytecode::size() const {
+    return instructions_.size();
+}
+
+bytecode::instruction const& bytecode::operator[](size_t index) const {
+    KTH_ASSERT(index < instructions_.size());
+    return instructions_[index];
+}
+
+bytecode::view bytecode::at(size_t index) const {
+    auto const& current = (*this)[index];
+    return {current.code, script_.subspan(current.data_offset, current.data_size), index};
+}
+
+size_t bytecode::counted(size_t first, size_t last) const {
+    KTH_ASSERT(first <= last && last <= instructions_.size());
+    auto const before = [this](size_t index) {
+        return index == instructions_.size() ? counted_ : instructions_[index].counted_before;
+    };
+
+    return before(last) - before(first);
+}
+
+byte_span bytecode::script_from(size_t index) const {
+    if (index >= instructions_.size()) {
+        return {};
+    }
+
+    return script_.subspan(instructions_[index].offset);
+}
+
+} // namespace kth::domain::machine
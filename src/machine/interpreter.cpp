@@ -4,6 +4,15 @@
 
 #include <kth/domain/machine/interpreter.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#if defined(KTH_OPCODE_PROFILER)
+#include <kth/domain/machine/opcode_profile.hpp>
+#endif
+
 // #include <kth/domain/constants.hpp>
 // #include <kth/domain/machine/operation.hpp>
 // #include <kth/domain/machine/program.hpp>
@@ -11,7 +20,88 @@
 
 namespace kth::domain::machine {
 
+namespace {
+
+// A bytecode view whose opcode is a constant, for run_op to fold its switch.
+template <opcode Code>
+class fixed_view : public bytecode::view {
+public:
+    explicit
+    fixed_view(bytecode::view const& op)
+        : bytecode::view(op)
+    {}
+
+    static constexpr
+    opcode code() {
+        return Code;
+    }
+};
+
+// Chosen when the library is built (WITH_SWITCH_DISPATCH).
+#if defined(KTH_SWITCH_DISPATCH)
+constexpr auto default_dispatch = interpreter::dispatch::switched;
+#else
+constexpr auto default_dispatch = interpreter::dispatch::threaded;
+#endif
+
+constexpr
+bool is_push_size(opcode code) {
+    return uint8_t(code) <= uint8_t(opcode::push_size_75);
+}
+
+} // namespace
+
+// Threaded dispatch.
+//-----------------------------------------------------------------------------
+
+// The hottest opcodes of standard scripts have fast paths, their results and
+// metrics match run_op. The others are run_op of their constant opcode.
+template <opcode Code>
+interpreter::result interpreter::run_fixed(bytecode::view const& op, program& program) {
+    if constexpr (is_push_size(Code)) {
+        // The bytecode guarantees the data size of the push.
+        program.get_metrics().add_op_cost(kth::may2025::opcode_cost);
+        program.push_move(op.data());
+        program.get_metrics().add_op_cost(program.top().size());
+        return error::success;
+    } else if constexpr (Code == opcode::equalverify) {
+        // The items are compared in place and dropped.
+        program.get_metrics().add_op_cost(kth::may2025::opcode_cost);
+        if (program.size() < 2) {
+            return error::op_equal_verify1;
+        }
+
+        auto const equal = program.item(0) == program.item(1);
+        program.erase(program.position(1), program.position(0) + 1);
+        program.get_metrics().add_op_cost(equal ? 1 : 0);
+        return equal ? error::success : error::op_equal_verify2;
+    } else {
+        return run_op(fixed_view<Code>(op), program);
+    }
+}
+
+template <size_t... Codes>
+std::array<interpreter::handler, sizeof...(Codes)> interpreter::make_handlers(std::index_sequence<Codes...> /*codes*/) {
+    return {{&interpreter::run_fixed<opcode(Codes)>...}};
+}
+
+// Script runner.
+//-----------------------------------------------------------------------------
+
 code interpreter::run(program& program) {
+    return run(program, default_dispatch);
+}
+
+code interpreter::run(program& program, dispatch mode) {
+    return mode == dispatch::threaded ?
+        run_script<dispatch::threaded>(program) :
+        run_script<dispatch::switched>(program);
+}
+
+template <interpreter::dispatch Mode>
+code interpreter::run_script(program& program) {
+    // One handler per opcode value.
+    static auto const handlers = make_handlers(std::make_index_sequence<256>{});
     code ec;
 
     if ( ! program.is_valid()) {
@@ -36,21 +126,41 @@ code interpreter::run(program& program) {
     //     program.get_metrics().set_script_limits(program.get_flags(), context->scriptSig().size());
     // }
 
-    for (auto const& op : program) {
-        if (op.is_oversized(program.max_script_element_size())) {
+    // The script runs from its bytecode, compiled for the program forks.
+    auto const& compiled = program.get_bytecode();
+
+    for (size_t index = 0; index < compiled.size();) {
+        auto const& instruction = compiled[index];
+
+        if ((instruction.flags & bytecode::instruction::oversized) != 0) {
             return error::invalid_push_data_size;
         }
 
-        if (op.is_disabled(program.forks())) {
+        if ((instruction.flags & bytecode::instruction::disabled) != 0) {
             return error::op_disabled;
         }
 
-        if ( ! program.increment_operation_count(op)) {
+        if ( ! program.increment_operation_count(instruction.code)) {
             return error::invalid_operation_count;
         }
 
-        if (program.if_(op)) {
-            if ((ec = run_op(op, program))) {
+        if ((instruction.flags & bytecode::instruction::conditional) != 0 || program.succeeded()) {
+#if defined(KTH_OPCODE_PROFILER)
+            auto const bytes = size_t(instruction.data_size) + (program.empty() ? 0 : program.top().size());
+            auto const start = opcode_profile::now();
+#endif
+
+            if constexpr (Mode == dispatch::threaded) {
+                ec = handlers[uint8_t(instruction.code)](compiled.at(index), program);
+            } else {
+                ec = run_op(compiled.at(index), program);
+            }
+
+#if defined(KTH_OPCODE_PROFILER)
+            opcode_profile::local().record(instruction.code, opcode_profile::now() - start, bytes);
+#endif
+
+            if (ec) {
                 return ec;
             }
 
@@ -92,6 +202,18 @@ code interpreter::run(program& program) {
                 }
             }
         }
+
+        ++index;
+
+        // Up to the next conditional nothing runs in a branch not taken,
+        // the skipped instructions are only counted.
+        if ( ! program.succeeded() && instruction.skip > index) {
+            if ( ! program.add_operation_count(compiled.counted(index, instruction.skip))) {
+                return error::invalid_operation_count;
+            }
+
+            index = instruction.skip;
+        }
     }
 
     return program.closed() ? error::success : error::invalid_stack_scope;
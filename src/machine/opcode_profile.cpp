@@ -0,0 +1,183 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/machine/opcode_profile.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define KTH_PROFILE_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define KTH_PROFILE_RDTSC
+#endif
+
+#include <kth/domain/machine/rule_fork.hpp>
+
+namespace kth::domain::machine {
+
+namespace {
+
+// The profiles of the running threads and the sum of those that ended.
+struct registry {
+    std::mutex mutex;
+    std::vector<opcode_profile*> profiles;
+    opcode_profile ended;
+};
+
+registry& profiles() {
+    static registry instance;
+    return instance;
+}
+
+// Registers the profile of a thread for its lifetime.
+struct thread_profile {
+    thread_profile() {
+        auto& all = profiles();
+        std::lock_guard lock(all.mutex);
+        all.profiles.push_back(&profile);
+    }
+
+    ~thread_profile() {
+        auto& all = profiles();
+        std::lock_guard lock(all.mutex);
+        all.ended.merge(profile);
+        std::erase(all.profiles, &profile);
+    }
+
+    opcode_profile profile;
+};
+
+} // namespace
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+opcode_profile::opcode_profile(opcode_profile const& x) {
+    merge(x);
+}
+
+opcode_profile& opcode_profile::operator=(opcode_profile const& x) {
+    if (this != &x) {
+        reset();
+        merge(x);
+    }
+
+    return *this;
+}
+
+// static
+opcode_profile& opcode_profile::local() {
+    thread_local thread_profile instance;
+    return instance.profile;
+}
+
+// static
+opcode_profile opcode_profile::collect() {
+    auto& all = profiles();
+    std::lock_guard lock(all.mutex);
+
+    opcode_profile result(all.ended);
+    for (auto const* profile : all.profiles) {
+        result.merge(*profile);
+    }
+
+    return result;
+}
+
+// static
+void opcode_profile::reset_all() {
+    auto& all = profiles();
+    std::lock_guard lock(all.mutex);
+
+    all.ended.reset();
+    for (auto* profile : all.profiles) {
+        profile->reset();
+    }
+}
+
+// static
+uint64_t opcode_profile::now() {
+#if defined(KTH_PROFILE_RDTSC)
+    return __rdtsc();
+#else
+    auto const elapsed = std::chrono::steady_clock::now().time_since_epoch();
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+#endif
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+opcode_profile::entry opcode_profile::get(opcode code) const {
+    auto const& item = counters_[uint8_t(code)];
+    return {
+        item.count.load(std::memory_order_relaxed),
+        item.cycles.load(std::memory_order_relaxed),
+        item.bytes.load(std::memory_order_relaxed)
+    };
+}
+
+uint64_t opcode_profile::total_count() const {
+    uint64_t total = 0;
+    for (auto const& item : counters_) {
+        total += item.count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t opcode_profile::total_cycles() const {
+    uint64_t total = 0;
+    for (auto const& item : counters_) {
+        total += item.cycles.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// Recording.
+//-----------------------------------------------------------------------------
+
+// Increments, not a load and a store, so a concurrent reset_all is not
+// overwritten with the totals read before it.
+void opcode_profile::record(opcode code, uint64_t cycles, size_t bytes) {
+    auto& item = counters_[uint8_t(code)];
+    item.count.fetch_add(1, std::memory_order_relaxed);
+    item.cycles.fetch_add(cycles, std::memory_order_relaxed);
+    item.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// The other profile may be recording, its counters are read atomically.
+void opcode_profile::merge(opcode_profile const& other) {
+    for (size_t code = 0; code < counters_.size(); ++code) {
+        auto const item = other.get(opcode(code));
+        counters_[code].count.fetch_add(item.count, std::memory_order_relaxed);
+        counters_[code].cycles.fetch_add(item.cycles, std::memory_order_relaxed);
+        counters_[code].bytes.fetch_add(item.bytes, std::memory_order_relaxed);
+    }
+}
+
+void opcode_profile::reset() {
+    for (auto& item : counters_) {
+        item.count.store(0, std::memory_order_relaxed);
+        item.cycles.store(0, std::memory_order_relaxed);
+        item.bytes.store(0, std::memory_order_relaxed);
+    }
+}
+
+void opcode_profile::dump(std::ostream& out) const {
+    for (size_t code = 0; code < counters_.size(); ++code) {
+        auto const item = get(opcode(code));
+        if (item.count == 0) {
+            continue;
+        }
+
+        out << "script;" << opcode_to_string(opcode(code), rule_fork::all_rules) << ' ' << item.cycles << '\n';
+    }
+}
+
+} // namespace kth::domain::machine
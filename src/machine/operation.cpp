@@ -155,7 +155,7 @@ expect<operation> operation::from_data(byte_reader& reader) {
     if ( ! data) {
         return make_unexpected(data.error());
     }
-    return operation(data_chunk(data->begin(), data->end()), false);
+    return operation(code, data_chunk(data->begin(), data->end()), true);
 }
 
 // Serialization.
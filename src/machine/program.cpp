@@ -44,7 +44,7 @@ void program::reserve_stacks() {
 program::program()
     : script_(default_script_),
       transaction_(default_tx_),
-      jump_(script_.begin())
+      bytecode_(compile(script_, forks_))
 {
     reserve_stacks();
 }
@@ -52,17 +52,20 @@ program::program()
 program::program(script const& script)
     : script_(script),
       transaction_(default_tx_),
-      jump_(script_.begin()) {
+      bytecode_(compile(script_, forks_)) {
     reserve_stacks();
 }
 
-program::program(script const& script, chain::transaction const& transaction, uint32_t input_index, uint32_t forks)
+program::program(script const& script, chain::transaction const& transaction, uint32_t input_index, uint32_t forks, chain::sighash_context const* context, std::pmr::memory_resource* resource)
     : script_(script),
       transaction_(transaction),
+      sighash_context_(context),
       input_index_(input_index),
       forks_(forks),
       value_(max_uint64),
-      jump_(script_.begin()) {
+      bytecode_(compile(script_, forks_)),
+      primary_(resource),
+      alternate_(resource) {
     reserve_stacks();
 }
 
@@ -86,8 +89,8 @@ program::program(
 #if ! defined(KTH_CURRENCY_BCH)
       version_(version),
 #endif // ! KTH_CURRENCY_BCH
-      jump_(script_.begin()),
-      primary_(std::move(stack)) {
+      bytecode_(compile(script_, forks_)),
+      primary_(stack.begin(), stack.end()) {
     reserve_stacks();
 }
 
@@ -95,11 +98,13 @@ program::program(
 program::program(script const& script, const program& x)
     : script_(script),
       transaction_(x.transaction_),
+      sighash_context_(x.sighash_context_),
       input_index_(x.input_index_),
       forks_(x.forks_),
       value_(x.value_),
-      jump_(script_.begin()),
-      primary_(x.primary_) {
+      bytecode_(compile(script_, forks_)),
+      primary_(x.primary_, x.primary_.get_allocator()),
+      alternate_(x.alternate_.get_allocator()) {
     reserve_stacks();
 }
 
@@ -107,14 +112,35 @@ program::program(script const& script, const program& x)
 program::program(script const& script, program&& x, bool /*unused*/)
     : script_(script),
       transaction_(x.transaction_),
+      sighash_context_(x.sighash_context_),
       input_index_(x.input_index_),
       forks_(x.forks_),
       value_(x.value_),
-      jump_(script_.begin()),
-      primary_(std::move(x.primary_)) {
+      bytecode_(compile(script_, forks_)),
+      primary_(std::move(x.primary_)),
+      alternate_(x.alternate_.get_allocator()) {
     reserve_stacks();
 }
 
+// Condition, alternate, jump and operation_count are not moved.
+program::program(script const& script, machine::bytecode const& compiled, program&& x)
+    : script_(script),
+      transaction_(x.transaction_),
+      sighash_context_(x.sighash_context_),
+      input_index_(x.input_index_),
+      forks_(x.forks_),
+      value_(x.value_),
+      shared_bytecode_(&compiled),
+      primary_(std::move(x.primary_)),
+      alternate_(x.alternate_.get_allocator()) {
+    reserve_stacks();
+}
+
+// static
+machine::bytecode program::compile(script const& script, uint32_t forks) {
+    return {script.bytes(), forks, max_script_element_size(forks)};
+}
+
 // Instructions.
 //-----------------------------------------------------------------------------
 
@@ -0,0 +1,40 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/machine/signature_cache.hpp>
+
+#include <kth/infrastructure/utility/random.hpp>
+
+namespace kth::domain::machine {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+signature_cache::signature_cache(size_t memory, size_t shards)
+    : cuckoo_cache(memory, shards)
+{
+    // The salt fills the first block, the copies of the context resume it.
+    sha256_context::block_type salt;
+    pseudo_random_fill(salt.data(), salt.size());
+    salted_.write(salt.data(), salt.size());
+}
+
+// static
+signature_cache& signature_cache::global() {
+    static signature_cache instance;
+    return instance;
+}
+
+// Cache.
+//-----------------------------------------------------------------------------
+
+hash_digest signature_cache::entry(hash_digest const& sighash, byte_span public_key, ec_signature const& signature) const {
+    auto context = salted_;
+    context.write_hash(sighash);
+    context.write_bytes(public_key.data(), public_key.size());
+    context.write_bytes(signature.data(), signature.size());
+    return context.finalize();
+}
+
+} // namespace kth::domain::machine
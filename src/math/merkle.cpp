@@ -0,0 +1,87 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/math/merkle.hpp>
+
+#include <algorithm>
+
+#include <kth/domain/math/sha256.hpp>
+#include <kth/domain/utility/parallel.hpp>
+
+namespace kth::domain {
+
+namespace {
+
+static_assert(sizeof(hash_digest) == 32);
+
+// The minimum leaves per thread (see parallel_ranges).
+constexpr size_t parallel_leaves = 4096;
+
+// Hashes one level in place, the parents overwrite the front of the nodes.
+// nodes[count] must be writable, it receives the copy of an odd last node.
+size_t hash_level(hash_digest* nodes, size_t count) {
+    if (count % 2 != 0) {
+        nodes[count] = nodes[count - 1];
+        ++count;
+    }
+
+    auto* data = reinterpret_cast<uint8_t*>(nodes);
+    double_sha256_64(data, data, count / 2);
+    return count / 2;
+}
+
+// A subtree spans 2^height leaves of the full tree, it is reduced by exactly
+// height levels. Only the rightmost subtree may be partial, its last node is
+// then duplicated at every level, as it is in the full tree.
+void hash_subtree(hash_digest* nodes, size_t count, size_t height) {
+    for (size_t level = 0; level < height; ++level) {
+        count = hash_level(nodes, count);
+    }
+}
+
+} // namespace
+
+hash_digest merkle_root(hash_list leaves, size_t threads) {
+    if (leaves.empty()) {
+        return null_hash;
+    }
+
+    auto count = leaves.size();
+    leaves.resize(count + 1);
+    auto* nodes = leaves.data();
+
+    if (threads > 1 && count >= threads * parallel_leaves) {
+        // The smallest power of two subtree size that needs at most threads subtrees.
+        size_t size = 1;
+        size_t height = 0;
+        while ((count + size - 1) / size > threads) {
+            size *= 2;
+            ++height;
+        }
+
+        // One subtree per thread.
+        auto const subtrees = (count + size - 1) / size;
+        parallel_ranges(subtrees, subtrees, 1, [=](size_t first, size_t last) {
+            for (auto subtree = first; subtree < last; ++subtree) {
+                auto const offset = subtree * size;
+                hash_subtree(nodes + offset, std::min(size, count - offset), height);
+            }
+        });
+
+        // The subtree roots are the next level of the tree.
+        for (size_t subtree = 1; subtree < subtrees; ++subtree) {
+            nodes[subtree] = nodes[subtree * size];
+        }
+
+        count = subtrees;
+    }
+
+    while (count > 1) {
+        count = hash_level(nodes, count);
+    }
+
+    return nodes[0];
+}
+
+} // namespace kth::domain
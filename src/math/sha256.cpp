@@ -0,0 +1,746 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/math/sha256.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <kth/domain/utility/kernel_registry.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KTH_SHA256_X86
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace kth::domain {
+
+namespace {
+
+constexpr sha256_context::state_type initial_state {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+alignas(64) constexpr uint32_t k[64] {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+// The second block of a 64 byte message: 0x80, zeros and a 512 bit length.
+constexpr uint32_t padding_64[16] {
+    0x80000000, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 512
+};
+
+inline
+uint32_t read_big_endian(uint8_t const* data) {
+    return (uint32_t(data[0]) << 24) | (uint32_t(data[1]) << 16) |
+           (uint32_t(data[2]) << 8) | uint32_t(data[3]);
+}
+
+inline
+void write_big_endian(uint8_t* out, uint32_t value) {
+    out[0] = uint8_t(value >> 24);
+    out[1] = uint8_t(value >> 16);
+    out[2] = uint8_t(value >> 8);
+    out[3] = uint8_t(value);
+}
+
+// Generic kernels.
+// Word is uint32_t for the scalar kernel or a vector of uint32_t lanes, one
+// independent message per lane, for the multi-buffer kernels. These must be
+// inlined so the vector code is generated for the caller's target.
+//-----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#define KTH_SHA256_INLINE inline __attribute__((always_inline))
+#else
+#define KTH_SHA256_INLINE inline
+#endif
+
+// A macro, not a function: a function returning a vector word outside of its
+// target would change the ABI (-Wpsabi), so no kernel returns a word.
+#define KTH_SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+template <typename Word>
+KTH_SHA256_INLINE
+void compress(Word (&state)[8], Word (&w)[16]) {
+    auto a = state[0];
+    auto b = state[1];
+    auto c = state[2];
+    auto d = state[3];
+    auto e = state[4];
+    auto f = state[5];
+    auto g = state[6];
+    auto h = state[7];
+
+    for (size_t i = 0; i < 64; ++i) {
+        // The message schedule is expanded in place over a 16 word window.
+        if (i >= 16) {
+            auto const w15 = w[(i - 15) & 15];
+            auto const w2 = w[(i - 2) & 15];
+            auto const s0 = KTH_SHA256_ROTR(w15, 7) ^ KTH_SHA256_ROTR(w15, 18) ^ (w15 >> 3);
+            auto const s1 = KTH_SHA256_ROTR(w2, 17) ^ KTH_SHA256_ROTR(w2, 19) ^ (w2 >> 10);
+            w[i & 15] += s0 + w[(i - 7) & 15] + s1;
+        }
+
+        auto const s1 = KTH_SHA256_ROTR(e, 6) ^ KTH_SHA256_ROTR(e, 11) ^ KTH_SHA256_ROTR(e, 25);
+        auto const choose = (e & f) ^ (~e & g);
+        auto const t1 = h + s1 + choose + k[i] + w[i & 15];
+        auto const s0 = KTH_SHA256_ROTR(a, 2) ^ KTH_SHA256_ROTR(a, 13) ^ KTH_SHA256_ROTR(a, 22);
+        auto const majority = (a & b) ^ (a & c) ^ (b & c);
+        auto const t2 = s0 + majority;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+#undef KTH_SHA256_ROTR
+
+template <size_t Lanes, typename Word>
+KTH_SHA256_INLINE
+uint32_t& lane(Word& word, size_t index) {
+    if constexpr (Lanes == 1) {
+        return word;
+    } else {
+        return reinterpret_cast<uint32_t*>(&word)[index];
+    }
+}
+
+// sha256(sha256) of one 64 byte message per lane, in[lane * 64] to
+// out[lane * 32]. All input is read before any output is written.
+template <typename Word, size_t Lanes>
+KTH_SHA256_INLINE
+void double_sha256_64_lanes(uint8_t* out, uint8_t const* in) {
+    Word w[16];
+    for (size_t i = 0; i < 16; ++i) {
+        for (size_t j = 0; j < Lanes; ++j) {
+            lane<Lanes>(w[i], j) = read_big_endian(in + 64 * j + 4 * i);
+        }
+    }
+
+    Word state[8];
+    for (size_t i = 0; i < 8; ++i) {
+        state[i] = Word{} + initial_state[i];
+    }
+
+    compress(state, w);
+
+    for (size_t i = 0; i < 16; ++i) {
+        w[i] = Word{} + padding_64[i];
+    }
+
+    compress(state, w);
+
+    // The second hash is over the 32 byte digest, in a single block.
+    for (size_t i = 0; i < 8; ++i) {
+        w[i] = state[i];
+        state[i] = Word{} + initial_state[i];
+    }
+
+    w[8] = Word{} + uint32_t(0x80000000);
+    for (size_t i = 9; i < 15; ++i) {
+        w[i] = Word{};
+    }
+    w[15] = Word{} + uint32_t(256);
+
+    compress(state, w);
+
+    for (size_t i = 0; i < 8; ++i) {
+        for (size_t j = 0; j < Lanes; ++j) {
+            write_big_endian(out + 32 * j + 4 * i, lane<Lanes>(state[i], j));
+        }
+    }
+}
+
+// sha256(sha256) of messages of any size, one message per lane at a time.
+// A lane moves on to its next message as soon as it completes one, idle
+// lanes compress a dummy block.
+template <typename Word, size_t Lanes>
+KTH_SHA256_INLINE
+void double_sha256_lanes(hash_digest* out, data_slice const* messages, size_t count) {
+    struct job {
+        size_t message;
+        uint8_t const* data;
+        size_t full;
+        size_t blocks;
+        size_t next;
+        bool second;
+        bool active;
+        uint8_t tail[2 * sha256_context::block_size];
+    };
+
+    static constexpr uint8_t idle[sha256_context::block_size] = {};
+    job jobs[Lanes];
+    Word state[8];
+    size_t pending = 0;
+
+    auto const reset = [&](size_t index) {
+        for (size_t i = 0; i < 8; ++i) {
+            lane<Lanes>(state[i], index) = initial_state[i];
+        }
+    };
+
+    // The whole blocks are read in place, the rest is padded into the tail.
+    auto const start = [&](size_t index) {
+        auto& current = jobs[index];
+        current.active = pending < count;
+        if ( ! current.active) {
+            return;
+        }
+
+        auto const& message = messages[pending];
+        auto const size = message.size();
+        auto const used = size % sha256_context::block_size;
+
+        current.message = pending++;
+        current.data = message.data();
+        current.full = size / sha256_context::block_size;
+        current.next = 0;
+        current.second = false;
+
+        auto const tail_blocks = used + 1 + sizeof(uint64_t) > sha256_context::block_size ? 2 : 1;
+        current.blocks = current.full + tail_blocks;
+
+        std::memset(current.tail, 0, sizeof(current.tail));
+        if (used != 0) {
+            std::memcpy(current.tail, current.data + size - used, used);
+        }
+        current.tail[used] = 0x80;
+
+        auto const bits = uint64_t(size) * 8;
+        auto* length = current.tail + tail_blocks * sha256_context::block_size - sizeof(uint64_t);
+        write_big_endian(length, uint32_t(bits >> 32));
+        write_big_endian(length + 4, uint32_t(bits));
+        reset(index);
+    };
+
+    // The first digest, padded in a single block.
+    auto const restart = [&](size_t index) {
+        auto& current = jobs[index];
+        std::memset(current.tail, 0, sizeof(current.tail));
+        for (size_t i = 0; i < 8; ++i) {
+            write_big_endian(current.tail + 4 * i, lane<Lanes>(state[i], index));
+        }
+        current.tail[32] = 0x80;
+        current.tail[62] = 0x01;
+
+        current.full = 0;
+        current.blocks = 1;
+        current.next = 0;
+        current.second = true;
+        reset(index);
+    };
+
+    auto active = size_t(0);
+    for (size_t index = 0; index < Lanes; ++index) {
+        start(index);
+        active += jobs[index].active ? 1 : 0;
+    }
+
+    while (active != 0) {
+        Word w[16];
+        for (size_t index = 0; index < Lanes; ++index) {
+            auto const& current = jobs[index];
+            auto const* block = ! current.active ? idle :
+                current.next < current.full ? current.data + sha256_context::block_size * current.next :
+                current.tail + sha256_context::block_size * (current.next - current.full);
+
+            for (size_t i = 0; i < 16; ++i) {
+                lane<Lanes>(w[i], index) = read_big_endian(block + 4 * i);
+            }
+        }
+
+        compress(state, w);
+
+        for (size_t index = 0; index < Lanes; ++index) {
+            auto& current = jobs[index];
+            if ( ! current.active || ++current.next != current.blocks) {
+                continue;
+            }
+
+            if ( ! current.second) {
+                restart(index);
+                continue;
+            }
+
+            auto& digest = out[current.message];
+            for (size_t i = 0; i < 8; ++i) {
+                write_big_endian(digest.data() + 4 * i, lane<Lanes>(state[i], index));
+            }
+
+            start(index);
+            active -= current.active ? 0 : 1;
+        }
+    }
+}
+
+void transform_generic(sha256_context::state_type& state, uint8_t const* blocks, size_t count) {
+    uint32_t words[8];
+    std::copy(state.begin(), state.end(), words);
+
+    for (size_t block = 0; block < count; ++block, blocks += sha256_context::block_size) {
+        uint32_t w[16];
+        for (size_t i = 0; i < 16; ++i) {
+            w[i] = read_big_endian(blocks + 4 * i);
+        }
+
+        compress(words, w);
+    }
+
+    std::copy(words, words + 8, state.begin());
+}
+
+void double_sha256_64_generic(uint8_t* out, uint8_t const* in) {
+    double_sha256_64_lanes<uint32_t, 1>(out, in);
+}
+
+#if defined(KTH_SHA256_X86)
+
+// Multi-buffer kernels.
+//-----------------------------------------------------------------------------
+
+using word_x4 = uint32_t __attribute__((vector_size(16)));
+using word_x8 = uint32_t __attribute__((vector_size(32)));
+using word_x16 = uint32_t __attribute__((vector_size(64)));
+
+__attribute__((target("sse4.1")))
+void double_sha256_64_sse41(uint8_t* out, uint8_t const* in) {
+    double_sha256_64_lanes<word_x4, 4>(out, in);
+}
+
+__attribute__((target("avx2")))
+void double_sha256_64_avx2(uint8_t* out, uint8_t const* in) {
+    double_sha256_64_lanes<word_x8, 8>(out, in);
+}
+
+__attribute__((target("avx512f")))
+void double_sha256_64_avx512(uint8_t* out, uint8_t const* in) {
+    double_sha256_64_lanes<word_x16, 16>(out, in);
+}
+
+__attribute__((target("sse4.1")))
+void double_sha256_sse41(hash_digest* out, data_slice const* messages, size_t count) {
+    double_sha256_lanes<word_x4, 4>(out, messages, count);
+}
+
+__attribute__((target("avx2")))
+void double_sha256_avx2(hash_digest* out, data_slice const* messages, size_t count) {
+    double_sha256_lanes<word_x8, 8>(out, messages, count);
+}
+
+__attribute__((target("avx512f")))
+void double_sha256_avx512(hash_digest* out, data_slice const* messages, size_t count) {
+    double_sha256_lanes<word_x16, 16>(out, messages, count);
+}
+
+// SHA extensions (SHA-NI), one message at a time.
+//-----------------------------------------------------------------------------
+
+__attribute__((target("sha,sse4.1")))
+void transform_shani(sha256_context::state_type& state, uint8_t const* blocks, size_t count) {
+    auto const mask = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+
+    // The instructions operate on ABEF/CDGH, not ABCD/EFGH.
+    auto tmp = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[0]));
+    auto state1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xb1);
+    state1 = _mm_shuffle_epi32(state1, 0x1b);
+    auto state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xf0);
+
+    for (size_t block = 0; block < count; ++block, blocks += sha256_context::block_size) {
+        auto const saved0 = state0;
+        auto const saved1 = state1;
+        __m128i messages[4];
+
+        // Four rounds per step, messages[step % 4] holds words [4 * step, 4 * step + 4).
+        for (size_t step = 0; step < 16; ++step) {
+            auto& words = messages[step & 3];
+
+            if (step < 4) {
+                words = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<__m128i const*>(blocks + 16 * step)), mask);
+            } else {
+                auto const& previous = messages[(step + 3) & 3];
+                auto const partial = _mm_sha256msg1_epu32(words, messages[(step + 1) & 3]);
+                auto const lagged = _mm_alignr_epi8(previous, messages[(step + 2) & 3], 4);
+                words = _mm_sha256msg2_epu32(_mm_add_epi32(partial, lagged), previous);
+            }
+
+            auto rounds = _mm_add_epi32(words, _mm_load_si128(reinterpret_cast<__m128i const*>(k + 4 * step)));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, rounds);
+            rounds = _mm_shuffle_epi32(rounds, 0x0e);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, rounds);
+        }
+
+        state0 = _mm_add_epi32(state0, saved0);
+        state1 = _mm_add_epi32(state1, saved1);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1b);
+    state1 = _mm_shuffle_epi32(state1, 0xb1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xf0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+__attribute__((target("sha,sse4.1")))
+void double_sha256_64_shani(uint8_t* out, uint8_t const* in) {
+    // Padded blocks of the 64 byte message and of the 32 byte digest.
+    alignas(16) uint8_t padding[64] = {0x80};
+    padding[62] = 0x02;
+
+    alignas(16) uint8_t digest[64] = {};
+    digest[32] = 0x80;
+    digest[62] = 0x01;
+
+    auto state = initial_state;
+    transform_shani(state, in, 1);
+    transform_shani(state, padding, 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        write_big_endian(digest + 4 * i, state[i]);
+    }
+
+    state = initial_state;
+    transform_shani(state, digest, 1);
+
+    for (size_t i = 0; i < 8; ++i) {
+        write_big_endian(out + 4 * i, state[i]);
+    }
+}
+
+bool has_shani() {
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_max(0, nullptr) < 7) {
+        return false;
+    }
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    auto const sha = (ebx & (1u << 29)) != 0;
+
+    __cpuid(1, eax, ebx, ecx, edx);
+    auto const sse41 = (ecx & (1u << 19)) != 0;
+    auto const ssse3 = (ecx & (1u << 9)) != 0;
+    return sha && sse41 && ssse3;
+}
+
+#endif // KTH_SHA256_X86
+
+// Dispatch.
+//-----------------------------------------------------------------------------
+
+using transform_function = void (*)(sha256_context::state_type&, uint8_t const*, size_t);
+using double_64_function = void (*)(uint8_t*, uint8_t const*);
+using double_function = void (*)(hash_digest*, data_slice const*, size_t);
+
+struct double_64_kernel {
+    size_t lanes;
+    double_64_function hash;
+};
+
+struct sha256_kernels {
+    char const* name;
+    transform_function transform;
+
+    // The single message kernel plus the widest multi-buffer kernel, if any.
+    double_64_function single;
+    double_64_kernel multi;
+
+    // Multi-buffer kernel for messages of any size, if any.
+    double_function batch;
+};
+
+sha256_kernels select_kernels() {
+    sha256_kernels kernels{"generic", transform_generic, double_sha256_64_generic, {1, double_sha256_64_generic}, nullptr};
+
+#if defined(KTH_SHA256_X86)
+    __builtin_cpu_init();
+
+    if (has_shani()) {
+        kernels.name = "shani";
+        kernels.transform = transform_shani;
+        kernels.single = double_sha256_64_shani;
+        kernels.multi = {1, double_sha256_64_shani};
+    }
+
+    // Wide multi-buffer kernels outperform a single SHA-NI stream.
+    if (__builtin_cpu_supports("avx512f")) {
+        kernels.name = kernels.transform == transform_shani ? "shani+avx512" : "avx512";
+        kernels.multi = {16, double_sha256_64_avx512};
+        kernels.batch = double_sha256_avx512;
+    } else if (__builtin_cpu_supports("avx2")) {
+        kernels.name = kernels.transform == transform_shani ? "shani+avx2" : "avx2";
+        kernels.multi = {8, double_sha256_64_avx2};
+
+        // For messages of any size the lane scheduling overhead outweighs
+        // eight lanes over a single SHA-NI stream.
+        if (kernels.transform != transform_shani) {
+            kernels.batch = double_sha256_avx2;
+        }
+    } else if (kernels.transform != transform_shani && __builtin_cpu_supports("sse4.1")) {
+        kernels.name = "sse4.1";
+        kernels.multi = {4, double_sha256_64_sse41};
+        kernels.batch = double_sha256_sse41;
+    }
+#endif
+
+    return kernels;
+}
+
+// The selected kernels first, then each kernel the cpu supports on its own
+// (the multi-buffer kernels over the generic single message kernel).
+std::vector<sha256_kernels> available_kernels() {
+    std::vector<sha256_kernels> available{
+        select_kernels(),
+        {"generic", transform_generic, double_sha256_64_generic, {1, double_sha256_64_generic}, nullptr}
+    };
+
+#if defined(KTH_SHA256_X86)
+    if (has_shani()) {
+        available.push_back({"shani", transform_shani, double_sha256_64_shani, {1, double_sha256_64_shani}, nullptr});
+    }
+
+    if (__builtin_cpu_supports("sse4.1")) {
+        available.push_back({"sse4.1", transform_generic, double_sha256_64_generic, {4, double_sha256_64_sse41}, double_sha256_sse41});
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+        available.push_back({"avx2", transform_generic, double_sha256_64_generic, {8, double_sha256_64_avx2}, double_sha256_avx2});
+    }
+
+    if (__builtin_cpu_supports("avx512f")) {
+        available.push_back({"avx512", transform_generic, double_sha256_64_generic, {16, double_sha256_64_avx512}, double_sha256_avx512});
+    }
+#endif
+
+    return available;
+}
+
+kernel_registry<sha256_kernels>& registry() {
+    static kernel_registry<sha256_kernels> instance(available_kernels());
+    return instance;
+}
+
+sha256_kernels const& kernels() {
+    return registry().selected();
+}
+
+} // namespace
+
+void double_sha256_64(uint8_t* out, uint8_t const* in, size_t count) {
+    auto const& selected = kernels();
+    auto const lanes = selected.multi.lanes;
+
+    for (; count >= lanes && lanes > 1; count -= lanes) {
+        selected.multi.hash(out, in);
+        out += 32 * lanes;
+        in += 64 * lanes;
+    }
+
+    for (; count > 0; --count) {
+        selected.single(out, in);
+        out += 32;
+        in += 64;
+    }
+}
+
+void double_sha256(hash_digest* out, data_slice const* messages, size_t count) {
+    auto const& selected = kernels();
+
+    // Too few messages to fill the lanes, a single stream is faster.
+    if (selected.batch != nullptr && count >= selected.multi.lanes) {
+        selected.batch(out, messages, count);
+        return;
+    }
+
+    for (size_t index = 0; index < count; ++index) {
+        sha256_context context;
+        context.write(messages[index].data(), messages[index].size());
+        out[index] = context.finalize_double();
+    }
+}
+
+char const* sha256_implementation() {
+    return kernels().name;
+}
+
+std::vector<char const*> sha256_implementations() {
+    return registry().names();
+}
+
+bool select_sha256_implementation(char const* name) {
+    return registry().select(name);
+}
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+sha256_context::sha256_context()
+    : state_(initial_state)
+{}
+
+// static
+void sha256_context::transform(state_type& state, uint8_t const* blocks, size_t count) {
+    kernels().transform(state, blocks, count);
+}
+
+// Hashing.
+//-----------------------------------------------------------------------------
+
+void sha256_context::write(uint8_t const* data, size_t size) {
+    auto used = size_t(size_ % block_size);
+    size_ += size;
+
+    // Complete a partially buffered block.
+    if (used != 0) {
+        auto const fill = std::min(size, block_size - used);
+        std::memcpy(buffer_.data() + used, data, fill);
+        data += fill;
+        size -= fill;
+        used += fill;
+
+        if (used < block_size) {
+            return;
+        }
+
+        transform(state_, buffer_.data(), 1);
+    }
+
+    // Compress whole blocks in place, buffer the remainder.
+    auto const blocks = size / block_size;
+    transform(state_, data, blocks);
+    data += blocks * block_size;
+    size -= blocks * block_size;
+
+    if (size != 0) {
+        std::memcpy(buffer_.data(), data, size);
+    }
+}
+
+uint64_t sha256_context::size() const {
+    return size_;
+}
+
+hash_digest sha256_context::finalize() const {
+    hash_digest out;
+    finalize(out);
+    return out;
+}
+
+hash_digest sha256_context::finalize_double() const {
+    hash_digest out;
+    finalize(out);
+
+    sha256_context second;
+    second.write(out.data(), out.size());
+    second.finalize(out);
+    return out;
+}
+
+// private
+void sha256_context::finalize(hash_digest& out) const {
+    auto state = state_;
+    auto const used = size_t(size_ % block_size);
+
+    // Padding is one 0x80 byte, zeros and the 64 bit big endian bit length.
+    uint8_t tail[2 * block_size] = {};
+    std::memcpy(tail, buffer_.data(), used);
+    tail[used] = 0x80;
+
+    auto const blocks = used + 1 + sizeof(uint64_t) > block_size ? 2 : 1;
+    auto const bits = size_ * 8;
+    auto* length = tail + blocks * block_size - sizeof(uint64_t);
+    write_big_endian(length, uint32_t(bits >> 32));
+    write_big_endian(length + 4, uint32_t(bits));
+
+    transform(state, tail, blocks);
+
+    for (size_t i = 0; i < state.size(); ++i) {
+        write_big_endian(out.data() + 4 * i, state[i]);
+    }
+}
+
+// Writer.
+//-----------------------------------------------------------------------------
+
+void sha256_context::write_bytes(data_slice data) {
+    write(data.data(), data.size());
+}
+
+void sha256_context::write_bytes(uint8_t const* data, size_t size) {
+    write(data, size);
+}
+
+void sha256_context::write_byte(uint8_t value) {
+    write(&value, 1);
+}
+
+void sha256_context::write_hash(hash_digest const& value) {
+    write(value.data(), value.size());
+}
+
+void sha256_context::write_2_bytes_little_endian(uint16_t value) {
+    write_little_endian(value);
+}
+
+void sha256_context::write_4_bytes_little_endian(uint32_t value) {
+    write_little_endian(value);
+}
+
+void sha256_context::write_8_bytes_little_endian(uint64_t value) {
+    write_little_endian(value);
+}
+
+void sha256_context::write_variable_little_endian(uint64_t value) {
+    if (value < 0xfd) {
+        write_byte(uint8_t(value));
+    } else if (value <= 0xffff) {
+        write_byte(0xfd);
+        write_2_bytes_little_endian(uint16_t(value));
+    } else if (value <= 0xffffffff) {
+        write_byte(0xfe);
+        write_4_bytes_little_endian(uint32_t(value));
+    } else {
+        write_byte(0xff);
+        write_8_bytes_little_endian(value);
+    }
+}
+
+void sha256_context::write_size_little_endian(uint64_t value) {
+    write_variable_little_endian(value);
+}
+
+void sha256_context::write_string(std::string const& value) {
+    write_variable_little_endian(value.size());
+    write(reinterpret_cast<uint8_t const*>(value.data()), value.size());
+}
+
+} // namespace kth::domain
@@ -0,0 +1,226 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/math/sip_hash.hpp>
+
+#include <bit>
+#include <cstring>
+#include <vector>
+
+#include <kth/domain/utility/kernel_registry.hpp>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KTH_SIP_HASH_X86
+#endif
+
+namespace kth::domain {
+
+namespace {
+
+uint64_t read_little_endian(uint8_t const* data) {
+    uint64_t value = 0;
+    if constexpr (std::endian::native == std::endian::little) {
+        std::memcpy(&value, data, sizeof(value));
+    } else {
+        for (size_t byte = 0; byte < 8; ++byte) {
+            value |= uint64_t(data[byte]) << (8 * byte);
+        }
+    }
+    return value;
+}
+
+// Generic kernel.
+// Word is uint64_t for the scalar kernel or a vector of uint64_t lanes, one
+// independent value per lane. These must be inlined so the vector code is
+// generated for the caller's target.
+//-----------------------------------------------------------------------------
+
+#if defined(__GNUC__)
+#define KTH_SIP_HASH_INLINE inline __attribute__((always_inline))
+#else
+#define KTH_SIP_HASH_INLINE inline
+#endif
+
+// A macro, not a function: a function returning a vector word is diagnosed
+// by -Wpsabi (its ABI depends on the target) even when always inlined.
+#define KTH_SIP_HASH_ROTL(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+template <typename Word>
+KTH_SIP_HASH_INLINE
+void sip_round(Word& v0, Word& v1, Word& v2, Word& v3) {
+    v0 += v1;
+    v1 = KTH_SIP_HASH_ROTL(v1, 13);
+    v1 ^= v0;
+    v0 = KTH_SIP_HASH_ROTL(v0, 32);
+    v2 += v3;
+    v3 = KTH_SIP_HASH_ROTL(v3, 16);
+    v3 ^= v2;
+    v0 += v3;
+    v3 = KTH_SIP_HASH_ROTL(v3, 21);
+    v3 ^= v0;
+    v2 += v1;
+    v1 = KTH_SIP_HASH_ROTL(v1, 17);
+    v1 ^= v2;
+    v2 = KTH_SIP_HASH_ROTL(v2, 32);
+}
+
+#undef KTH_SIP_HASH_ROTL
+
+template <size_t Lanes, typename Word>
+KTH_SIP_HASH_INLINE
+uint64_t& lane(Word& word, size_t index) {
+    if constexpr (Lanes == 1) {
+        return word;
+    } else {
+        return reinterpret_cast<uint64_t*>(&word)[index];
+    }
+}
+
+// SipHash-2-4 of values[lane] into out[lane], the 32 byte message of
+// sip_hash_uint256: four compressed words, then the length block.
+template <typename Word, size_t Lanes>
+KTH_SIP_HASH_INLINE
+void sip_hash_lanes(uint64_t* out, uint64_t k0, uint64_t k1, hash_digest const* values) {
+    Word v0 = Word{} + (0x736f6d6570736575ull ^ k0);
+    Word v1 = Word{} + (0x646f72616e646f6dull ^ k1);
+    Word v2 = Word{} + (0x6c7967656e657261ull ^ k0);
+    Word v3 = Word{} + (0x7465646279746573ull ^ k1);
+
+    for (size_t word = 0; word < 4; ++word) {
+        Word data;
+        for (size_t index = 0; index < Lanes; ++index) {
+            lane<Lanes>(data, index) = read_little_endian(values[index].data() + 8 * word);
+        }
+
+        v3 ^= data;
+        sip_round(v0, v1, v2, v3);
+        sip_round(v0, v1, v2, v3);
+        v0 ^= data;
+    }
+
+    constexpr uint64_t length = uint64_t(32) << 56;
+    v3 ^= length;
+    sip_round(v0, v1, v2, v3);
+    sip_round(v0, v1, v2, v3);
+    v0 ^= length;
+
+    v2 ^= 0xff;
+    sip_round(v0, v1, v2, v3);
+    sip_round(v0, v1, v2, v3);
+    sip_round(v0, v1, v2, v3);
+    sip_round(v0, v1, v2, v3);
+
+    Word result = v0 ^ v1 ^ v2 ^ v3;
+    for (size_t index = 0; index < Lanes; ++index) {
+        out[index] = lane<Lanes>(result, index);
+    }
+}
+
+void sip_hash_generic(uint64_t* out, uint64_t k0, uint64_t k1, hash_digest const* values) {
+    sip_hash_lanes<uint64_t, 1>(out, k0, k1, values);
+}
+
+#if defined(KTH_SIP_HASH_X86)
+
+// Multi-lane kernels.
+//-----------------------------------------------------------------------------
+
+using word_x4 = uint64_t __attribute__((vector_size(32)));
+using word_x8 = uint64_t __attribute__((vector_size(64)));
+
+__attribute__((target("avx2")))
+void sip_hash_avx2(uint64_t* out, uint64_t k0, uint64_t k1, hash_digest const* values) {
+    sip_hash_lanes<word_x4, 4>(out, k0, k1, values);
+}
+
+__attribute__((target("avx512f")))
+void sip_hash_avx512(uint64_t* out, uint64_t k0, uint64_t k1, hash_digest const* values) {
+    sip_hash_lanes<word_x8, 8>(out, k0, k1, values);
+}
+
+#endif // KTH_SIP_HASH_X86
+
+// Dispatch.
+//-----------------------------------------------------------------------------
+
+using sip_hash_function = void (*)(uint64_t*, uint64_t, uint64_t, hash_digest const*);
+
+struct sip_hash_kernel {
+    char const* name;
+    size_t lanes;
+    sip_hash_function hash;
+};
+
+sip_hash_kernel select_kernel() {
+#if defined(KTH_SIP_HASH_X86)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f")) {
+        return {"avx512", 8, sip_hash_avx512};
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+        return {"avx2", 4, sip_hash_avx2};
+    }
+#endif
+
+    return {"generic", 1, sip_hash_generic};
+}
+
+// The selected kernel first, then the others the cpu supports.
+std::vector<sip_hash_kernel> available_kernels() {
+    std::vector<sip_hash_kernel> available{select_kernel(), {"generic", 1, sip_hash_generic}};
+
+#if defined(KTH_SIP_HASH_X86)
+    if (__builtin_cpu_supports("avx2")) {
+        available.push_back({"avx2", 4, sip_hash_avx2});
+    }
+
+    if (__builtin_cpu_supports("avx512f")) {
+        available.push_back({"avx512", 8, sip_hash_avx512});
+    }
+#endif
+
+    return available;
+}
+
+kernel_registry<sip_hash_kernel>& registry() {
+    static kernel_registry<sip_hash_kernel> instance(available_kernels());
+    return instance;
+}
+
+sip_hash_kernel const& kernel() {
+    return registry().selected();
+}
+
+} // namespace
+
+void sip_hash_uint256_batch(uint64_t* out, uint64_t k0, uint64_t k1, hash_digest const* values, size_t count) {
+    auto const& selected = kernel();
+    auto const lanes = selected.lanes;
+
+    for (; count >= lanes && lanes > 1; count -= lanes) {
+        selected.hash(out, k0, k1, values);
+        out += lanes;
+        values += lanes;
+    }
+
+    for (; count > 0; --count) {
+        sip_hash_generic(out++, k0, k1, values++);
+    }
+}
+
+char const* sip_hash_implementation() {
+    return kernel().name;
+}
+
+std::vector<char const*> sip_hash_implementations() {
+    return registry().names();
+}
+
+bool select_sip_hash_implementation(char const* name) {
+    return registry().select(name);
+}
+
+} // namespace kth::domain
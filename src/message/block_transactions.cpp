@@ -62,7 +62,7 @@ expect<block_transactions> block_transactions::from_data(byte_reader& reader, ui
         return make_unexpected(block_hash.error());
     }
 
-    auto txs = read_collection<chain::transaction>(reader, true);
+    auto txs = read_pmr_collection<chain::transaction>(reader, std::pmr::get_default_resource(), true);
     if ( ! txs) {
         return make_unexpected(txs.error());
     }
@@ -7,9 +7,9 @@
 #include <initializer_list>
 
 // #include <kth/infrastructure/message/message_tools.hpp>
+#include <kth/domain/math/sip_hash.hpp>
 #include <kth/domain/message/version.hpp>
 #include <kth/domain/multi_crypto_support.hpp>
-#include <kth/infrastructure/math/sip_hash.hpp>
 #include <kth/infrastructure/message/message_tools.hpp>
 #include <kth/infrastructure/utility/container_sink.hpp>
 #include <kth/infrastructure/utility/container_source.hpp>
@@ -101,15 +101,19 @@ bool compact_block::from_block(message::block const& block) {
     auto k0 = from_little_endian_unsafe<uint64_t>(header_hash.begin());
     auto k1 = from_little_endian_unsafe<uint64_t>(header_hash.begin() + sizeof(uint64_t));
 
-    compact_block::short_id_list short_ids_list;
-    short_ids_list.reserve(block.transactions().size() - 1);
+    // The txids are computed in batches, then the short ids.
+    block.hash_transactions();
+
+    hash_list hashes;
+    hashes.reserve(block.transactions().size() - 1);
     for (size_t i = 1; i < block.transactions().size(); ++i) {
-        uint64_t shortid = sip_hash_uint256(
-            k0,
-            k1,
-            block.transactions()[i].hash()
-        ) & uint64_t(0xffffffffffff);
-        short_ids_list.push_back(shortid);
+        hashes.push_back(block.transactions()[i].hash());
+    }
+
+    compact_block::short_id_list short_ids_list(hashes.size());
+    sip_hash_uint256_batch(short_ids_list.data(), k0, k1, hashes.data(), hashes.size());
+    for (auto& shortid : short_ids_list) {
+        shortid &= uint64_t(0xffffffffffff);
     }
 
     short_ids_ = std::move(short_ids_list);
@@ -0,0 +1,222 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/message/compact_block_reconstructor.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+#include <kth/domain/math/sip_hash.hpp>
+#include <kth/infrastructure/math/sip_hash.hpp>
+#include <kth/infrastructure/utility/assert.hpp>
+
+namespace kth::domain::message {
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+compact_block_reconstructor::compact_block_reconstructor(compact_block const& block)
+    : header_(block.header())
+    , block_hash_(block.header().hash())
+{
+    auto const keys = hash(block);
+    k0_ = from_little_endian_unsafe<uint64_t>(keys.begin());
+    k1_ = from_little_endian_unsafe<uint64_t>(keys.begin() + sizeof(uint64_t));
+    valid_ = index(block);
+}
+
+// private
+bool compact_block_reconstructor::index(compact_block const& block) {
+    auto const& short_ids = block.short_ids();
+    auto const& prefilled = block.transactions();
+    auto const count = short_ids.size() + prefilled.size();
+
+    if (count == 0 || count > max_uint32) {
+        return false;
+    }
+
+    states_.assign(count, state::unknown);
+    transactions_.resize(count);
+
+    // Prefilled indexes are differential, in increasing order.
+    uint64_t last = max_uint64;
+    for (auto const& item : prefilled) {
+        if (item.index() >= count || last + 1 + item.index() >= count) {
+            return false;
+        }
+
+        last += 1 + item.index();
+        states_[last] = state::known;
+        transactions_[last] = item.transaction();
+    }
+
+    // At least twice the short ids, a power of two, for short probes.
+    table_.assign(std::bit_ceil(std::max(short_ids.size() * 2, size_t(1))), entry{empty_id, 0});
+    auto const mask = table_.size() - 1;
+
+    size_t slot = 0;
+    for (auto const value : short_ids) {
+        auto const id = value & short_id_mask;
+        while (states_[slot] == state::known) {
+            ++slot;
+        }
+
+        auto position = size_t(id) & mask;
+        while (table_[position].id != empty_id) {
+            // A repeated short id cannot be resolved from the pool.
+            if (table_[position].id == id) {
+                return false;
+            }
+
+            position = (position + 1) & mask;
+        }
+
+        table_[position] = {id, uint32_t(slot)};
+        ++slot;
+    }
+
+    return true;
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+bool compact_block_reconstructor::is_valid() const {
+    return valid_;
+}
+
+hash_digest const& compact_block_reconstructor::block_hash() const {
+    return block_hash_;
+}
+
+size_t compact_block_reconstructor::size() const {
+    return states_.size();
+}
+
+size_t compact_block_reconstructor::missing() const {
+    return std::count_if(states_.begin(), states_.end(), [](state value) {
+        return value != state::known;
+    });
+}
+
+size_t compact_block_reconstructor::collisions() const {
+    return collisions_;
+}
+
+compact_block_reconstructor::short_id compact_block_reconstructor::to_short_id(hash_digest const& hash) const {
+    return sip_hash_uint256(k0_, k1_, hash) & short_id_mask;
+}
+
+// private
+compact_block_reconstructor::entry const* compact_block_reconstructor::find(short_id id) const {
+    auto const mask = table_.size() - 1;
+    for (auto position = size_t(id) & mask; table_[position].id != empty_id; position = (position + 1) & mask) {
+        if (table_[position].id == id) {
+            return &table_[position];
+        }
+    }
+
+    return nullptr;
+}
+
+// Reconstruction.
+//-----------------------------------------------------------------------------
+
+void compact_block_reconstructor::fill(std::span<chain::transaction const> pool) {
+    if ( ! valid_) {
+        return;
+    }
+
+    // The short ids of a chunk of the pool are computed in one batch.
+    hash_digest hashes[fill_chunk];
+    short_id ids[fill_chunk];
+
+    for (size_t first = 0; first < pool.size(); first += fill_chunk) {
+        auto const chunk = pool.subspan(first, std::min(fill_chunk, pool.size() - first));
+        for (size_t index = 0; index < chunk.size(); ++index) {
+            hashes[index] = chunk[index].hash();
+        }
+
+        sip_hash_uint256_batch(ids, k0_, k1_, hashes, chunk.size());
+        fill(chunk, std::span<short_id const>(ids, chunk.size()));
+    }
+}
+
+void compact_block_reconstructor::fill(std::span<chain::transaction const> pool, std::span<short_id const> ids) {
+    KTH_ASSERT(pool.size() == ids.size());
+    if ( ! valid_) {
+        return;
+    }
+
+    for (size_t index = 0; index < pool.size(); ++index) {
+        auto const* match = find(ids[index] & short_id_mask);
+        if (match == nullptr) {
+            continue;
+        }
+
+        auto& current = states_[match->slot];
+        if (current == state::unknown) {
+            current = state::known;
+            transactions_[match->slot] = pool[index];
+        } else if (current == state::known && transactions_[match->slot].hash() != pool[index].hash()) {
+            current = state::ambiguous;
+            transactions_[match->slot] = chain::transaction{};
+            ++collisions_;
+        }
+    }
+}
+
+get_block_transactions compact_block_reconstructor::request() const {
+    std::vector<uint64_t> indexes;
+
+    uint64_t last = max_uint64;
+    for (size_t slot = 0; slot < states_.size(); ++slot) {
+        if (states_[slot] != state::known) {
+            indexes.push_back(slot - (last + 1));
+            last = slot;
+        }
+    }
+
+    return {block_hash_, std::move(indexes)};
+}
+
+expect<chain::block> compact_block_reconstructor::complete(block_transactions const& response) const {
+    if ( ! valid_ || response.block_hash() != block_hash_) {
+        return make_unexpected(error::invalid_compact_block);
+    }
+
+    auto const& received = response.transactions();
+    auto transactions = transactions_;
+    size_t next = 0;
+
+    for (size_t slot = 0; slot < states_.size(); ++slot) {
+        if (states_[slot] == state::known) {
+            continue;
+        }
+
+        if (next == received.size()) {
+            return make_unexpected(error::invalid_compact_block);
+        }
+
+        transactions[slot] = received[next++];
+    }
+
+    if (next != received.size()) {
+        return make_unexpected(error::invalid_compact_block);
+    }
+
+    chain::block result(header_, std::move(transactions));
+    if ( ! result.is_valid_merkle_root()) {
+        return make_unexpected(error::merkle_mismatch);
+    }
+
+    return result;
+}
+
+expect<chain::block> compact_block_reconstructor::complete() const {
+    return complete(block_transactions{block_hash_, {}});
+}
+
+} // namespace kth::domain::message
@@ -8,12 +8,18 @@
 #include <cstdint>
 #include <initializer_list>
 #include <istream>
+#include <iterator>
 #include <utility>
+#include <vector>
 
+#include <kth/domain/chain/chain_state.hpp>
 #include <kth/domain/message/inventory.hpp>
 #include <kth/domain/message/inventory_vector.hpp>
 #include <kth/domain/message/version.hpp>
+#include <kth/domain/utility/parallel.hpp>
+#include <kth/infrastructure/error.hpp>
 #include <kth/infrastructure/message/message_tools.hpp>
+#include <kth/infrastructure/utility/assert.hpp>
 #include <kth/infrastructure/utility/container_sink.hpp>
 #include <kth/infrastructure/utility/container_source.hpp>
 #include <kth/infrastructure/utility/istream_reader.hpp>
@@ -122,6 +128,68 @@ bool headers::is_sequential() const {
     return true;
 }
 
+void headers::hash_elements(size_t threads) const {
+    std::vector<chain::header const*> pending;
+    pending.reserve(elements_.size());
+
+    for (auto const& element : elements_) {
+        if ( ! element.is_hash_cached()) {
+            pending.push_back(&element);
+        }
+    }
+
+    size_t const parallel_headers = 512;
+    cache_hashes(pending, threads, parallel_headers);
+}
+
+code headers::check(bool retarget, size_t threads) const {
+    hash_elements(threads);
+
+    // Linkage and proof of work are checked in the same pass, on the cached
+    // hashes (the scrypt proof of work of LTC is still hashed per header).
+    for (auto it = elements_.begin(); it != elements_.end(); ++it) {
+        if (it != elements_.begin() && it->previous_block_hash() != std::prev(it)->hash()) {
+            return error::orphan_block;
+        }
+
+        auto const ec = it->check(retarget);
+        if (ec) {
+            return ec;
+        }
+    }
+
+    return error::success;
+}
+
+code headers::accept(chain::chain_state const& pool) const {
+    // The contextual checks are inherently sequential, each header is
+    // accepted in the state that its predecessor promotes.
+    std::shared_ptr<chain::chain_state> next;
+    auto const* state = &pool;
+
+    for (auto const& element : elements_) {
+        auto const ec = element.accept(*state);
+        if (ec) {
+            return ec;
+        }
+
+        if (&element == &elements_.back()) {
+            break;
+        }
+
+        auto const block_state = chain::chain_state::from_pool_ptr(*state, element);
+        next = chain::chain_state::from_top_ptr(*block_state);
+
+        if ( ! next) {
+            return error::operation_failed;
+        }
+
+        state = next.get();
+    }
+
+    return error::success;
+}
+
 void headers::to_hashes(hash_list& out) const {
     out.clear();
     out.reserve(elements_.size());
@@ -0,0 +1,149 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/utility/cuckoo_cache.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+#include <kth/infrastructure/utility/assert.hpp>
+
+namespace kth::domain {
+
+namespace {
+
+// The evictions chained by an insertion before the last one is dropped.
+constexpr size_t max_kicks = 8;
+
+uint32_t read_slot(hash_digest const& entry, size_t offset) {
+    return uint32_t(entry[offset]) |
+        uint32_t(entry[offset + 1]) << 8 |
+        uint32_t(entry[offset + 2]) << 16 |
+        uint32_t(entry[offset + 3]) << 24;
+}
+
+} // namespace
+
+// Constructors.
+//-----------------------------------------------------------------------------
+
+cuckoo_cache::cuckoo_cache(size_t memory, size_t shards) {
+    KTH_ASSERT(shards != 0);
+
+    shards_.reserve(shards);
+    for (size_t i = 0; i < shards; ++i) {
+        shards_.push_back(std::make_unique<shard>());
+    }
+
+    resize(memory);
+}
+
+// Properties.
+//-----------------------------------------------------------------------------
+
+size_t cuckoo_cache::capacity() const {
+    size_t total = 0;
+    for (auto const& item : shards_) {
+        std::shared_lock lock(item->mutex);
+        total += item->slots.size();
+    }
+    return total;
+}
+
+uint64_t cuckoo_cache::hits() const {
+    return hits_.load(std::memory_order_relaxed);
+}
+
+uint64_t cuckoo_cache::misses() const {
+    return misses_.load(std::memory_order_relaxed);
+}
+
+// Cache.
+//-----------------------------------------------------------------------------
+
+bool cuckoo_cache::contains(hash_digest const& entry) const {
+    auto const& target = shard_of(entry);
+    auto found = false;
+
+    {
+        std::shared_lock lock(target.mutex);
+        if ( ! target.slots.empty()) {
+            auto const [first, second] = slots_of(entry, target.slots.size());
+            found = target.slots[first] == entry || target.slots[second] == entry;
+        }
+    }
+
+    (found ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+void cuckoo_cache::insert(hash_digest const& entry) {
+    auto& target = shard_of(entry);
+    std::unique_lock lock(target.mutex);
+    auto& slots = target.slots;
+
+    if (slots.empty()) {
+        return;
+    }
+
+    auto const [first, second] = slots_of(entry, slots.size());
+
+    if (slots[first] == entry || slots[second] == entry) {
+        return;
+    }
+
+    if (slots[second] == null_hash) {
+        slots[second] = entry;
+        return;
+    }
+
+    // Take the first slot, moving its entry to its other slot and so on.
+    auto current = entry;
+    auto index = first;
+
+    for (size_t kick = 0; kick < max_kicks; ++kick) {
+        std::swap(current, slots[index]);
+
+        if (current == null_hash) {
+            return;
+        }
+
+        auto const [one, other] = slots_of(current, slots.size());
+        index = index == one ? other : one;
+    }
+
+    // The last evicted entry is dropped.
+}
+
+void cuckoo_cache::clear() {
+    for (auto& item : shards_) {
+        std::unique_lock lock(item->mutex);
+        std::fill(item->slots.begin(), item->slots.end(), null_hash);
+    }
+
+    hits_ = 0;
+    misses_ = 0;
+}
+
+void cuckoo_cache::resize(size_t memory) {
+    auto const per_shard = memory / sizeof(hash_digest) / shards_.size();
+
+    for (auto& item : shards_) {
+        std::vector<hash_digest> slots(per_shard, null_hash);
+        std::unique_lock lock(item->mutex);
+        item->slots.swap(slots);
+    }
+}
+
+// private
+cuckoo_cache::shard& cuckoo_cache::shard_of(hash_digest const& entry) const {
+    return *shards_[read_slot(entry, 0) % shards_.size()];
+}
+
+// private
+std::pair<size_t, size_t> cuckoo_cache::slots_of(hash_digest const& entry, size_t size) {
+    return {read_slot(entry, 4) % size, read_slot(entry, 8) % size};
+}
+
+} // namespace kth::domain
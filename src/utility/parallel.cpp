@@ -0,0 +1,24 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <kth/domain/utility/parallel.hpp>
+
+#include <algorithm>
+#include <thread>
+
+namespace kth::domain {
+
+size_t thread_count(size_t threads) {
+#if defined(__EMSCRIPTEN__)
+    return 1;
+#else
+    if (threads == 0) {
+        return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+    }
+
+    return threads;
+#endif
+}
+
+} // namespace kth::domain
@@ -12,6 +12,7 @@
 
 #include <boost/program_options.hpp>
 
+#include <kth/domain/chain/script_template.hpp>
 #include <kth/domain/multi_crypto_support.hpp>
 #include <kth/domain/wallet/ec_private.hpp>
 #include <kth/domain/wallet/ec_public.hpp>
@@ -493,28 +494,32 @@ payment_address::list payment_address::extract_input(chain::script const& script
 
 // A server should use this against the prevout instead of using extract_input.
 payment_address::list payment_address::extract_output(chain::script const& script, uint8_t p2kh_version, uint8_t p2sh_version) {
-    auto const pattern = script.output_pattern();
+    // Matched on the bytes, the operations are not materialized.
+    auto const bytes = script.bytes();
+    auto const pattern = chain::script_template::output_pattern(bytes);
+    auto const payload = chain::script_template::output_payload(bytes, pattern);
+    auto const slice = data_slice(payload.data(), payload.data() + payload.size());
 
     switch (pattern) {
         case script_pattern::pay_public_key_hash: {
             return {
-                payment_address{to_array<short_hash_size>(script[2].data()), p2kh_version}
+                payment_address{to_array<short_hash_size>(slice), p2kh_version}
             };
         }
         case script_pattern::pay_script_hash: {
             return {
-                payment_address{to_array<short_hash_size>(script[1].data()), p2sh_version}
+                payment_address{to_array<short_hash_size>(slice), p2sh_version}
             };
         }
         case script_pattern::pay_script_hash_32: {
             return {
-                payment_address{to_array<hash_size>(script[1].data()), p2sh_version}
+                payment_address{to_array<hash_size>(slice), p2sh_version}
             };
         }
         case script_pattern::pay_public_key: {
             return {
                 // pay_public_key is not p2kh but we conflate for tracking.
-                payment_address{ec_public{script[0].data()}, p2kh_version}
+                payment_address{ec_public{to_chunk(slice)}, p2kh_version}
             };
         }
 
@@ -0,0 +1,150 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/domain/chain/abla_schedule.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::chain;
+
+namespace {
+
+std::vector<uint64_t> make_block_sizes(size_t count) {
+    std::vector<uint64_t> sizes;
+    sizes.reserve(count);
+    uint64_t seed = 42;
+
+    for (size_t index = 0; index < count; ++index) {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+        sizes.push_back((seed >> 33) % 40'000'000u);
+    }
+
+    return sizes;
+}
+
+} // namespace
+
+// Start Test Suite: abla schedule tests
+
+TEST_CASE("abla schedule  at  any height  sequential replay state", "[abla schedule]") {
+    auto const cfg = abla::default_config();
+    abla::state const anchor(cfg, 1'000'000);
+    auto const sizes = make_block_sizes(2500);
+
+    abla::schedule instance(cfg, 800'000, anchor, 100);
+    REQUIRE(instance.push(sizes) == sizes.size());
+    REQUIRE(instance.top_height() == 800'000 + sizes.size());
+
+    auto expected = anchor;
+    for (size_t index = 0; index <= sizes.size(); ++index) {
+        auto const state = instance.at(800'000 + index);
+        REQUIRE(state);
+        REQUIRE(state->block_size == expected.block_size);
+        REQUIRE(state->control_block_size == expected.control_block_size);
+        REQUIRE(state->elastic_buffer_size == expected.elastic_buffer_size);
+
+        if (index < sizes.size()) {
+            expected = *abla::next(expected, cfg, sizes[index]);
+        }
+    }
+
+    REQUIRE(instance.top().control_block_size == instance.at(instance.top_height())->control_block_size);
+}
+
+TEST_CASE("abla schedule  at  out of range  nullopt", "[abla schedule]") {
+    auto const cfg = abla::default_config();
+    abla::schedule instance(cfg, 10, abla::state(cfg, 0), 4);
+    REQUIRE(instance.push(1'000'000));
+    REQUIRE( ! instance.at(9));
+    REQUIRE( ! instance.at(12));
+    REQUIRE( ! instance.block_size_limit(12));
+    REQUIRE(instance.block_size_limit(10) == abla::DEFAULT_CONSENSUS_BLOCK_SIZE);
+}
+
+TEST_CASE("abla schedule  truncate  then push  same states as unreorganized", "[abla schedule]") {
+    auto const cfg = abla::default_config();
+    abla::state const anchor(cfg, 0);
+    auto const sizes = make_block_sizes(50);
+
+    abla::schedule instance(cfg, 0, anchor, 8);
+    REQUIRE(instance.push(make_block_sizes(77)) == 77);
+    instance.truncate(17);
+    REQUIRE(instance.top_height() == 17);
+    REQUIRE(instance.push(std::span<uint64_t const>(sizes).subspan(17)) == sizes.size() - 17);
+
+    abla::schedule expected(cfg, 0, anchor, 8);
+    REQUIRE(expected.push(sizes) == sizes.size());
+
+    for (size_t height = 0; height <= sizes.size(); ++height) {
+        REQUIRE(instance.at(height)->elastic_buffer_size == expected.at(height)->elastic_buffer_size);
+        REQUIRE(instance.at(height)->control_block_size == expected.at(height)->control_block_size);
+    }
+}
+
+TEST_CASE("abla schedule  from data  to data  same states", "[abla schedule]") {
+    auto const cfg = abla::default_config();
+    abla::state const anchor(cfg, 1'000'000);
+    auto const sizes = make_block_sizes(1234);
+
+    abla::schedule instance(cfg, 800'000, anchor, 100);
+    REQUIRE(instance.push(sizes) == sizes.size());
+
+    auto const data = instance.to_data();
+    REQUIRE(data.size() == instance.serialized_size());
+
+    byte_reader reader(data);
+    auto const result = abla::schedule::from_data(reader);
+    REQUIRE(result);
+    REQUIRE(reader.is_exhausted());
+    REQUIRE(result->interval() == instance.interval());
+    REQUIRE(result->anchor_height() == instance.anchor_height());
+    REQUIRE(result->top_height() == instance.top_height());
+    REQUIRE(result->top().control_block_size == instance.top().control_block_size);
+    REQUIRE(result->top().elastic_buffer_size == instance.top().elastic_buffer_size);
+    REQUIRE(result->to_data() == data);
+
+    for (auto height = instance.anchor_height(); height <= instance.top_height(); ++height) {
+        REQUIRE(result->at(height)->control_block_size == instance.at(height)->control_block_size);
+        REQUIRE(result->at(height)->elastic_buffer_size == instance.at(height)->elastic_buffer_size);
+    }
+}
+
+TEST_CASE("abla schedule  from data  truncated  failure", "[abla schedule]") {
+    auto const cfg = abla::default_config();
+    abla::schedule instance(cfg, 0, abla::state(cfg, 0), 8);
+    REQUIRE(instance.push(make_block_sizes(20)) == 20);
+
+    auto data = instance.to_data();
+    data.pop_back();
+    byte_reader reader(data);
+    REQUIRE( ! abla::schedule::from_data(reader));
+}
+
+TEST_CASE("abla schedule  from data  changed block size  failure", "[abla schedule]") {
+    auto const cfg = abla::default_config();
+    abla::schedule instance(cfg, 0, abla::state(cfg, 0), 8);
+    REQUIRE(instance.push(make_block_sizes(20)) == 20);
+
+    // The block sizes follow the twelve fixed fields, the snapshot of height
+    // 8 holds the size of its block.
+    auto data = instance.to_data();
+    data[(12 + 7) * sizeof(uint64_t)] ^= 0x01;
+    byte_reader reader(data);
+    REQUIRE( ! abla::schedule::from_data(reader));
+}
+
+TEST_CASE("abla schedule  from data  zero interval  failure", "[abla schedule]") {
+    auto const cfg = abla::default_config();
+    abla::schedule instance(cfg, 0, abla::state(cfg, 0), 8);
+
+    // The interval follows the nine config fields.
+    auto data = instance.to_data();
+    std::fill_n(data.begin() + 9 * sizeof(uint64_t), sizeof(uint64_t), 0);
+    byte_reader reader(data);
+    REQUIRE( ! abla::schedule::from_data(reader));
+}
+
+// End Test Suite
@@ -2,6 +2,11 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+
 #include <test_helpers.hpp>
 
 using namespace kth;
@@ -29,6 +34,42 @@ bool all_valid(chain::transaction::list const& transactions) {
     return valid;
 }
 
+// Test helper.
+// A block of a coinbase and count transactions that spend distinct outputs,
+// with a valid merkle root and proof of work (regtest bits).
+static
+chain::block make_large_block(size_t count) {
+    chain::transaction::list txs;
+    txs.reserve(count + 1);
+
+    chain::input::list coinbase_inputs;
+    coinbase_inputs.emplace_back(chain::output_point{null_hash, chain::point::null_index}, chain::script(data_chunk{0x51, 0x51}, false), 0xffffffff);
+    chain::output::list coinbase_outputs;
+    coinbase_outputs.emplace_back(5000000000, chain::script(data_chunk{0x51}, false), chain::token_data_opt{});
+    txs.emplace_back(1, 0, std::move(coinbase_inputs), std::move(coinbase_outputs));
+
+    for (size_t index = 0; index < count; ++index) {
+        auto previous = null_hash;
+        std::memcpy(previous.data(), &index, sizeof(index));
+        previous.back() = 0x01;
+
+        chain::input::list inputs;
+        inputs.emplace_back(chain::output_point{previous, 0}, chain::script(data_chunk{0x51}, false), 0xffffffff);
+        chain::output::list outputs;
+        outputs.emplace_back(1000, chain::script(data_chunk{0x51}, false), chain::token_data_opt{});
+        txs.emplace_back(1, 0, std::move(inputs), std::move(outputs));
+    }
+
+    chain::block block(chain::header{1, null_hash, null_hash, 1500000000, 0x207fffff, 0}, std::move(txs));
+    block.header().set_merkle(block.generate_merkle_root());
+
+    for (uint32_t nonce = 0; block.header().check() != error::success; ++nonce) {
+        block.header().set_nonce(nonce);
+    }
+
+    return block;
+}
+
 // Start Test Suite: chain block tests
 
 TEST_CASE("block proof2 genesis mainnet expected", "[chain block]") {
@@ -268,6 +309,30 @@ TEST_CASE("block genesis chipnet valid structure", "[block serialization]") {
 
 #endif
 
+TEST_CASE("block  from data  monotonic resource  allocates only from the resource", "[block serialization]") {
+    auto const raw = chain::block::genesis_mainnet().to_data();
+
+    // Any allocation beyond the buffer reaches the null resource and throws.
+    std::array<std::byte, 4096> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    byte_reader reader(raw);
+    auto const block = chain::block::from_data(reader, true, &arena);
+    REQUIRE(block);
+    REQUIRE(block->to_data() == raw);
+    REQUIRE(block->transactions().get_allocator().resource() == &arena);
+
+    auto const& tx = block->transactions().front();
+    REQUIRE(tx.inputs().get_allocator().resource() == &arena);
+    REQUIRE(tx.outputs().get_allocator().resource() == &arena);
+
+    // Copies allocate from the default resource, so they may outlive the arena.
+    auto const copy = tx;
+    REQUIRE(copy.inputs().get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(copy.outputs().get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(copy == tx);
+}
+
 TEST_CASE("block  factory from data 1  genesis mainnet  success", "[block serialization]") {
     auto const genesis = chain::block::genesis_mainnet();
     REQUIRE(genesis.serialized_size() == 285u);
@@ -377,6 +442,23 @@ TEST_CASE("block  generate merkle root  block with multiple transactions  matche
     REQUIRE(header.merkle() == block100k.generate_merkle_root());
 }
 
+TEST_CASE("block  hash transactions  threaded  matches serialized hashes", "[block generate merkle root]") {
+    // Enough transactions to split across threads, of varying sizes.
+    chain::transaction::list transactions;
+    for (uint32_t index = 0; index < 2100; ++index) {
+        chain::output::list outputs(index % 5 + 1, chain::output(index, chain::script{}, chain::token_data_opt{}));
+        transactions.emplace_back(1, index, chain::input::list{}, std::move(outputs));
+    }
+
+    chain::block const block(chain::header{}, std::move(transactions));
+    block.hash_transactions(4);
+
+    for (auto const& tx : block.transactions()) {
+        REQUIRE(tx.is_hash_cached());
+        REQUIRE(tx.hash() == bitcoin_hash(tx.to_data()));
+    }
+}
+
 TEST_CASE("block  header accessor  always  returns initialized value", "[block generate merkle root]") {
     chain::header const header(10u,
                                hash_literal("000000000019d6689c085ae165831e934ff763ae46a2a6c172b3f1b60a8ce26f"),
@@ -652,4 +734,23 @@ TEST_CASE("block  is forward reference  forward reference  true", "[block is for
 
 // End Test Suite
 
+TEST_CASE("block  check  threads  same result as single thread", "[block check]") {
+    // Enough transactions for more than one thread to hash.
+    size_t const count = 4 * 512 + 100;
+    auto const single = make_large_block(count);
+    auto const threaded = make_large_block(count);
+
+    REQUIRE(single.check(1) == error::success);
+    REQUIRE(threaded.check(4) == error::success);
+    REQUIRE(threaded.to_hashes() == single.to_hashes());
+}
+
+TEST_CASE("block  is valid merkle root  threads  same result as single thread", "[block check]") {
+    auto block = make_large_block(4 * 512 + 100);
+    REQUIRE(block.is_valid_merkle_root(4));
+
+    block.header().set_merkle(null_hash);
+    REQUIRE( ! block.is_valid_merkle_root(4));
+}
+
 // End Test Suite
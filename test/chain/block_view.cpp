@@ -0,0 +1,149 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+
+// Test helper.
+static
+data_chunk block100k_data() {
+    // encodes the 100,000 block data.
+    return to_chunk(base16_literal(
+        "010000007f110631052deeee06f0754a3629ad7663e56359fd5f3aa7b3e30a00"
+        "000000005f55996827d9712147a8eb6d7bae44175fe0bcfa967e424a25bfe9f4"
+        "dc118244d67fb74c9d8e2f1bea5ee82a03010000000100000000000000000000"
+        "00000000000000000000000000000000000000000000ffffffff07049d8e2f1b"
+        "0114ffffffff0100f2052a0100000043410437b36a7221bc977dce712728a954"
+        "e3b5d88643ed5aef46660ddcfeeec132724cd950c1fdd008ad4a2dfd354d6af0"
+        "ff155fc17c1ee9ef802062feb07ef1d065f0ac000000000100000001260fd102"
+        "fab456d6b169f6af4595965c03c2296ecf25bfd8790e7aa29b404eff01000000"
+        "8c493046022100c56ad717e07229eb93ecef2a32a42ad041832ffe66bd2e1485"
+        "dc6758073e40af022100e4ba0559a4cebbc7ccb5d14d1312634664bac46f36dd"
+        "d35761edaae20cefb16f01410417e418ba79380f462a60d8dd12dcef8ebfd7ab"
+        "1741c5c907525a69a8743465f063c1d9182eea27746aeb9f1f52583040b1bc34"
+        "1b31ca0388139f2f323fd59f8effffffff0200ffb2081d0000001976a914fc7b"
+        "44566256621affb1541cc9d59f08336d276b88ac80f0fa02000000001976a914"
+        "617f0609c9fabb545105f7898f36b84ec583350d88ac00000000010000000122"
+        "cd6da26eef232381b1a670aa08f4513e9f91a9fd129d912081a3dd138cb01301"
+        "0000008c4930460221009339c11b83f234b6c03ebbc4729c2633cbc8cbd0d157"
+        "74594bfedc45c4f99e2f022100ae0135094a7d651801539df110a028d65459d2"
+        "4bc752d7512bc8a9f78b4ab368014104a2e06c38dc72c4414564f190478e3b0d"
+        "01260f09b8520b196c2f6ec3d06239861e49507f09b7568189efe8d327c3384a"
+        "4e488f8c534484835f8020b3669e5aebffffffff0200ac23fc060000001976a9"
+        "14b9a2c9700ff9519516b21af338d28d53ddf5349388ac00743ba40b00000019"
+        "76a914eb675c349c474bec8dea2d79d12cff6f330ab48788ac00000000"));
+}
+
+TEST_CASE("block view  from data  insufficient bytes  failure", "[chain block view]") {
+    data_chunk const data(10);
+    REQUIRE( ! chain::block_view::from_data(data));
+}
+
+TEST_CASE("block view  from data  insufficient transaction bytes  failure", "[chain block view]") {
+    auto const raw = block100k_data();
+    REQUIRE( ! chain::block_view::from_data(byte_span(raw).first(raw.size() - 1)));
+}
+
+TEST_CASE("block view  from data  trailing bytes  ignored", "[chain block view]") {
+    auto raw = block100k_data();
+    auto const size = raw.size();
+    raw.push_back(0x42);
+
+    auto const view = chain::block_view::from_data(raw);
+    REQUIRE(view);
+    REQUIRE(view->data().size() == size);
+}
+
+TEST_CASE("block view  block 100k  matches materialized block", "[chain block view]") {
+    auto const raw = block100k_data();
+    auto const view = chain::block_view::from_data(raw);
+    REQUIRE(view);
+
+    byte_reader reader(raw);
+    auto const block = chain::block::from_data(reader);
+    REQUIRE(block);
+
+    REQUIRE(view->data().size() == raw.size());
+    REQUIRE(view->hash() == block->hash());
+    REQUIRE(view->transaction_count() == block->transactions().size());
+
+    for (size_t index = 0; index < view->transaction_count(); ++index) {
+        auto const tx_view = view->transaction_at(index);
+        auto const& tx = block->transactions()[index];
+
+        REQUIRE(tx_view.hash() == tx.hash());
+        REQUIRE(tx_view.version() == tx.version());
+        REQUIRE(tx_view.locktime() == tx.locktime());
+        REQUIRE(tx_view.is_coinbase() == tx.is_coinbase());
+        REQUIRE(tx_view.total_output_value() == tx.total_output_value());
+        REQUIRE(tx_view.data().size() == tx.serialized_size(true));
+        REQUIRE(tx_view.input_count() == tx.inputs().size());
+        REQUIRE(tx_view.output_count() == tx.outputs().size());
+
+        for (size_t input = 0; input < tx_view.input_count(); ++input) {
+            auto const borrowed = tx_view.input_at(input);
+            auto const& expected = tx.inputs()[input];
+            auto const script = expected.script().to_data(false);
+
+            REQUIRE(borrowed.previous_output() == expected.previous_output());
+            REQUIRE(borrowed.sequence() == expected.sequence());
+            REQUIRE(data_chunk(borrowed.script().begin(), borrowed.script().end()) == script);
+            REQUIRE(borrowed.data().size() == expected.serialized_size(true));
+        }
+
+        for (size_t output = 0; output < tx_view.output_count(); ++output) {
+            auto const borrowed = tx_view.output_at(output);
+            auto const& expected = tx.outputs()[output];
+            auto const script = expected.script().to_data(false);
+
+            REQUIRE(borrowed.value() == expected.value());
+            REQUIRE( ! borrowed.has_token_data());
+            REQUIRE(data_chunk(borrowed.script().begin(), borrowed.script().end()) == script);
+            REQUIRE(borrowed.data().size() == expected.serialized_size(true));
+        }
+    }
+}
+
+TEST_CASE("block view  block 100k  check  matches block check", "[chain block view]") {
+    auto const raw = block100k_data();
+    auto const view = chain::block_view::from_data(raw);
+    REQUIRE(view);
+
+    byte_reader reader(raw);
+    auto const block = chain::block::from_data(reader);
+    REQUIRE(block);
+
+    REQUIRE(view->is_valid_merkle_root());
+    REQUIRE(view->generate_merkle_root(4) == block->generate_merkle_root());
+    REQUIRE( ! view->is_extra_coinbases());
+    REQUIRE( ! view->is_internal_double_spend());
+    REQUIRE(view->check() == block->check(raw.size()));
+    REQUIRE(view->check() == error::success);
+}
+
+TEST_CASE("block view  genesis mainnet  check  success", "[chain block view]") {
+    auto const raw = chain::block::genesis_mainnet().to_data();
+    auto const view = chain::block_view::from_data(raw);
+    REQUIRE(view);
+    REQUIRE(view->transaction_count() == 1u);
+    REQUIRE(view->check() == error::success);
+}
+
+TEST_CASE("block view  to block  with hashes  caches transaction hashes", "[chain block view]") {
+    auto const raw = block100k_data();
+    auto const view = chain::block_view::from_data(raw);
+    REQUIRE(view);
+
+    auto const hashes = view->transaction_hashes();
+    auto const block = view->to_block(hashes);
+    REQUIRE(block);
+    REQUIRE(block->to_data() == raw);
+
+    for (size_t index = 0; index < hashes.size(); ++index) {
+        REQUIRE(block->transactions()[index].is_hash_cached());
+        REQUIRE(block->transactions()[index].hash() == hashes[index]);
+    }
+}
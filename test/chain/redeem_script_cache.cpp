@@ -0,0 +1,50 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::chain;
+
+namespace {
+
+// 1 [key] [key] 2 checkmultisig
+auto const multisig = to_chunk(base16_literal("5121020b7e0f2e2d3c1a57b1c8a2b4d4f0e0b8f4c5a7d2e1f3b6c9a8d7e6f5a4b3c2d121031b7e0f2e2d3c1a57b1c8a2b4d4f0e0b8f4c5a7d2e1f3b6c9a8d7e6f5a4b3c2d152ae"));
+
+} // namespace
+
+// Start Test Suite: redeem script cache tests
+
+TEST_CASE("redeem script cache  get  same script  parsed once", "[redeem script cache]") {
+    redeem_script_cache cache;
+    auto const hash = bitcoin_short_hash(multisig);
+
+    auto const& first = cache.get(hash, multisig, machine::rule_fork::all_rules);
+    auto const& second = cache.get(hash, multisig, machine::rule_fork::all_rules);
+    REQUIRE(&first == &second);
+    REQUIRE(cache.size() == 1);
+    REQUIRE(first.redeem.to_data(false) == multisig);
+    REQUIRE(first.compiled.size() == 5);
+}
+
+TEST_CASE("redeem script cache  get  other bytes or forks  recompiled", "[redeem script cache]") {
+    redeem_script_cache cache;
+    auto const hash = bitcoin_short_hash(multisig);
+    data_chunk const other{0x51};
+
+    REQUIRE(cache.get(hash, multisig, machine::rule_fork::all_rules).compiled.size() == 5);
+    REQUIRE(cache.get(hash, other, machine::rule_fork::all_rules).compiled.size() == 1);
+    REQUIRE(cache.get(hash, other, machine::rule_fork::no_rules).forks == machine::rule_fork::no_rules);
+    REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("redeem script cache  get  full  cleared", "[redeem script cache]") {
+    redeem_script_cache cache(1);
+    cache.get(bitcoin_short_hash(multisig), multisig, machine::rule_fork::all_rules);
+    cache.get(bitcoin_hash(multisig), multisig, machine::rule_fork::all_rules);
+    REQUIRE(cache.size() == 1);
+}
+
+// End Test Suite
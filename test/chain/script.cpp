@@ -541,6 +541,31 @@ TEST_CASE("script context free invalid", "[script]") {
     }
 }
 
+// The switch is the reference of the threaded dispatch.
+TEST_CASE("script context free  threaded dispatch  same result as switch", "[script]") {
+    auto const run = [](script const& prevout_script, transaction const& tx, interpreter::dispatch mode) {
+        program input(tx.inputs().front().script(), tx, 0, rule_fork::all_rules);
+        auto const ec = interpreter::run(input, mode);
+        if (ec) {
+            return ec;
+        }
+
+        program prevout(prevout_script, input);
+        return interpreter::run(prevout, mode);
+    };
+
+    for (auto const* list : {&valid_context_free_scripts, &invalid_context_free_scripts}) {
+        for (auto const& test : *list) {
+            auto const tx = new_tx(test);
+            auto const name = test_name(test);
+            REQUIRE_MESSAGE(tx.is_valid(), name);
+
+            auto const& prevout = tx.inputs().front().previous_output().validation.cache.script();
+            CHECK_MESSAGE(run(prevout, tx, interpreter::dispatch::threaded) == run(prevout, tx, interpreter::dispatch::switched), name);
+        }
+    }
+}
+
 // Checksig tests.
 //------------------------------------------------------------------------------
 
@@ -595,6 +620,29 @@ TEST_CASE("script checksig  normal  success", "[script]") {
     REQUIRE(script::check_signature(signature, sighash_algorithm::single, pubkey, script_code, parent_tx, index));
 }
 
+TEST_CASE("script checksigverify  invalid signature  incorrect signature", "[script]") {
+    // The endorsement of 315ac7d4c26d69668129cc352851d9389b4a6868f1509c6c8b66bead11e2619f:0 does not sign this tx.
+    std::string const push = "[304402205d8feeb312478e468d0b514e63e113958d7214fa572acd87079a7f0cc026fc5c02200fa76ea05bf243af6d0f9177f241caf606d01fcfd5e62d6befbca24e569e5c2703] [02100a1a9ca2c18932d6577c58f225580184d0e08226d41959874ac963e3c1b2fe]";
+
+    // The check fails the script in place, before any following operation.
+    script_test const tests[] = {
+        {push, "checksigverify 1", "checksigverify, true"},
+        {push, "checksigverify return", "checksigverify, return"},
+        {push, "checksigverify 0", "checksigverify, false"}
+    };
+
+    for (auto const& test : tests) {
+        auto tx = new_tx(test);
+        auto const name = test_name(test);
+        REQUIRE_MESSAGE(tx.is_valid(), name);
+
+        // The version 0 signature hash commits to the prevout value.
+        tx.inputs()[0].previous_output().validation.cache.set_value(0);
+        CHECK_MESSAGE(verify(tx, 0, rule_fork::no_rules) == error::incorrect_signature, name);
+        CHECK_MESSAGE(verify(tx, 0, rule_fork::all_rules) == error::incorrect_signature, name);
+    }
+}
+
 TEST_CASE("script create endorsement  single input single output  expected", "[script]") {
     data_chunk tx_data;
     decode_base16(tx_data, "0100000001b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee0970100000000ffffffff01905f0100000000001976a91418c0bd8d1818f1bf99cb1df2269c645318ef7b7388ac00000000");
@@ -658,6 +706,72 @@ TEST_CASE("script generate signature hash  all  expected", "[script]") {
     REQUIRE(result == expected);
 }
 
+#if ! defined(KTH_CURRENCY_BCH)
+// Reference: serialize a modified copy of the transaction, as satoshi does.
+static
+hash_digest legacy_signature_hash_reference(transaction const& tx, uint32_t index, script const& script_code, uint8_t sighash_type) {
+    operation::list ops;
+    for (auto const& op : script_code.operations()) {
+        if (op.code() != opcode::codeseparator) {
+            ops.push_back(op);
+        }
+    }
+
+    script const stripped(std::move(ops));
+    auto const base = sighash_type & sighash_algorithm::mask;
+    auto const any = (sighash_type & sighash_algorithm::anyone_can_pay) != 0;
+    auto const keep_sequences = base != sighash_algorithm::none && base != sighash_algorithm::single;
+    auto const& self = tx.inputs()[index];
+
+    input::list ins;
+    if (any) {
+        ins.emplace_back(self.previous_output(), stripped, self.sequence());
+    } else {
+        for (auto const& input : tx.inputs()) {
+            ins.emplace_back(input.previous_output(), script{}, keep_sequences ? input.sequence() : 0);
+        }
+        ins[index].set_script(stripped);
+        ins[index].set_sequence(self.sequence());
+    }
+
+    output::list outs;
+    if (base == sighash_algorithm::single) {
+        outs.resize(index + 1);
+        outs.back() = tx.outputs()[index];
+    } else if (base != sighash_algorithm::none) {
+        outs = tx.outputs();
+    }
+
+    auto serialized = transaction(tx.version(), tx.locktime(), std::move(ins), std::move(outs)).to_data(true);
+    extend_data(serialized, to_little_endian(uint32_t(sighash_type)));
+    return bitcoin_hash(serialized);
+}
+
+TEST_CASE("script generate signature hash  unversioned  matches modified copy", "[script]") {
+    script code;
+    REQUIRE(code.from_string("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] codeseparator equalverify checksig"));
+
+    input::list inputs;
+    inputs.emplace_back(output_point{hash_literal("b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee097"), 0}, script{}, 0xffffffff);
+    inputs.emplace_back(output_point{hash_literal("42e7988254800876b69f24676b3e0205b77be476512ca4d970707dd5c60598ab"), 1}, code, 7);
+    inputs.emplace_back(output_point{hash_literal("5df1375ffe61ac35ca178ebb0cab9ea26dedbd0e96005dfcee7e379fa513232f"), 2}, script{}, 0xfffffffe);
+
+    output::list outputs;
+    outputs.emplace_back(90000, code, token_data_opt{});
+    outputs.emplace_back(12345, script{}, token_data_opt{});
+    outputs.emplace_back(1, code, token_data_opt{});
+
+    transaction const tx(1, 0, std::move(inputs), std::move(outputs));
+
+    for (uint8_t const type : {0x01, 0x02, 0x03, 0x81, 0x82, 0x83}) {
+        for (uint32_t index = 0; index < tx.inputs().size(); ++index) {
+            auto const result = script::generate_signature_hash(tx, index, code, type, rule_fork::no_rules);
+            REQUIRE(result.first == legacy_signature_hash_reference(tx, index, code, type));
+        }
+    }
+}
+#endif // ! KTH_CURRENCY_BCH
+
 // Ad-hoc test cases.
 //-----------------------------------------------------------------------------
 
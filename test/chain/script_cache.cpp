@@ -0,0 +1,70 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/domain/chain/script_cache.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::chain;
+using namespace kth::domain::machine;
+
+// Start Test Suite: chain script cache tests
+
+namespace {
+
+transaction make_transaction() {
+    script prevout_script;
+    REQUIRE(prevout_script.from_string("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig"));
+
+    input::list inputs;
+    inputs.emplace_back(output_point{hash_literal("b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee097"), 0}, script{}, 0xffffffff);
+    inputs.emplace_back(output_point{hash_literal("42e7988254800876b69f24676b3e0205b77be476512ca4d970707dd5c60598ab"), 1}, script{}, 0xfffffffe);
+
+    output::list outputs;
+    outputs.emplace_back(90000, prevout_script, token_data_opt{});
+
+    transaction tx(2, 500000, std::move(inputs), std::move(outputs));
+
+    for (auto& input : tx.inputs()) {
+        input.previous_output().validation.cache = output(100000, prevout_script, token_data_opt{});
+    }
+
+    return tx;
+}
+
+} // namespace
+
+TEST_CASE("script cache  entry  same transaction and forks  same entry", "[chain script cache]") {
+    script_cache const cache(1024, 1);
+    auto const tx = make_transaction();
+    REQUIRE(cache.entry(tx, rule_fork::all_rules) == cache.entry(make_transaction(), rule_fork::all_rules));
+}
+
+TEST_CASE("script cache  entry  forks changed  distinct entry", "[chain script cache]") {
+    script_cache const cache(1024, 1);
+    auto const tx = make_transaction();
+    REQUIRE(cache.entry(tx, rule_fork::all_rules) != cache.entry(tx, rule_fork::no_rules));
+}
+
+TEST_CASE("script cache  entry  previous output changed  distinct entry", "[chain script cache]") {
+    script_cache const cache(1024, 1);
+    auto tx = make_transaction();
+    auto const expected = cache.entry(tx, rule_fork::all_rules);
+
+    tx.inputs().front().previous_output().validation.cache.set_value(100001);
+    REQUIRE(cache.entry(tx, rule_fork::all_rules) != expected);
+}
+
+TEST_CASE("script cache  entry  missing previous output  distinct entry", "[chain script cache]") {
+    script_cache const cache(1024, 1);
+    auto tx = make_transaction();
+    auto const expected = cache.entry(tx, rule_fork::all_rules);
+
+    tx.inputs().front().previous_output().validation.cache = output{};
+    REQUIRE(cache.entry(tx, rule_fork::all_rules) != expected);
+}
+
+// End Test Suite
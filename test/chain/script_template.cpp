@@ -0,0 +1,95 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::chain;
+
+using infrastructure::machine::script_pattern;
+
+namespace {
+
+data_chunk script_bytes(std::string const& mnemonic) {
+    script instance;
+    REQUIRE(instance.from_string(mnemonic));
+    return instance.to_data(false);
+}
+
+} // namespace
+
+// Start Test Suite: script template tests
+
+TEST_CASE("script template  pay public key hash  matches and extracts hash", "[script template]") {
+    auto const bytes = to_chunk(base16_literal("76a914905f933de850988603aafeeb2fd7fce61e66fe5d88ac"));
+    REQUIRE(script_template::is_pay_public_key_hash(bytes));
+    REQUIRE(script_template::output_pattern(bytes) == script_pattern::pay_public_key_hash);
+
+    auto const hash = script_template::output_payload(bytes, script_pattern::pay_public_key_hash);
+    REQUIRE(encode_base16(data_chunk(hash.begin(), hash.end())) == "905f933de850988603aafeeb2fd7fce61e66fe5d");
+}
+
+TEST_CASE("script template  pay public key hash  non minimal push  matches", "[script template]") {
+    // The hash pushed with push_one_size, as matched by the operation patterns.
+    auto const bytes = to_chunk(base16_literal("76a94c14905f933de850988603aafeeb2fd7fce61e66fe5d88ac"));
+    REQUIRE(script_template::is_pay_public_key_hash(bytes));
+    REQUIRE(script_template::output_payload(bytes, script_pattern::pay_public_key_hash).size() == short_hash_size);
+}
+
+TEST_CASE("script template  pay script hash  matches", "[script template]") {
+    auto const bytes = to_chunk(base16_literal("a914748284390f9e263a4b766a75d0633c50426eb87587"));
+    REQUIRE(script_template::is_pay_script_hash(bytes));
+    REQUIRE( ! script_template::is_pay_script_hash_32(bytes));
+    REQUIRE(script_template::output_pattern(bytes) == script_pattern::pay_script_hash);
+}
+
+TEST_CASE("script template  pay public key  compressed  matches", "[script template]") {
+    auto const bytes = script_bytes("[02a1633cafcc01ebfb6d78e39f687a1f0995c62fc95f51ead10a02ee0be551b5dc] checksig");
+    REQUIRE(script_template::is_pay_public_key(bytes));
+    REQUIRE(script_template::output_pattern(bytes) == script_pattern::pay_public_key);
+    REQUIRE(script_template::output_payload(bytes, script_pattern::pay_public_key).size() == ec_compressed_size);
+}
+
+TEST_CASE("script template  multisig  matches operation patterns", "[script template]") {
+    auto const one_of_three = script_bytes("1 [03dcfd9e580de35d8c2060d76dbf9e5561fe20febd2e64380e860a4d59f15ac864] [02440e0304bf8d32b2012994393c6a477acf238dd6adb4c3cef5bfa72f30c9861c] [03624505c6cc3967352cce480d8550490dd68519cd019066a4c302fdfb7d1c9934] 3 checkmultisig");
+    REQUIRE(script_template::is_pay_multisig(one_of_three));
+    REQUIRE(script_template::output_pattern(one_of_three) == script_pattern::pay_multisig);
+
+    auto const zero_of_three = script_bytes("0 [03dcfd9e580de35d8c2060d76dbf9e5561fe20febd2e64380e860a4d59f15ac864] [02440e0304bf8d32b2012994393c6a477acf238dd6adb4c3cef5bfa72f30c9861c] [03624505c6cc3967352cce480d8550490dd68519cd019066a4c302fdfb7d1c9934] 3 checkmultisig");
+    REQUIRE( ! script_template::is_pay_multisig(zero_of_three));
+    REQUIRE(script_template::output_pattern(zero_of_three) == script_pattern::non_standard);
+}
+
+TEST_CASE("script template  null data  requires a minimal push", "[script template]") {
+    REQUIRE(script_template::is_null_data(script_bytes("return []")));
+    REQUIRE(script_template::is_null_data(script_bytes("return [0102]")));
+    REQUIRE( ! script_template::is_null_data(script_bytes("return")));
+    REQUIRE( ! script_template::is_null_data(script_bytes("return 1")));
+
+    // [02] must be pushed as 2.
+    REQUIRE( ! script_template::is_null_data(to_chunk(base16_literal("6a0102"))));
+}
+
+TEST_CASE("script template  sigops  counts multisig accurately", "[script template]") {
+    auto const bytes = script_bytes("2 [03dcfd9e580de35d8c2060d76dbf9e5561fe20febd2e64380e860a4d59f15ac864] [02440e0304bf8d32b2012994393c6a477acf238dd6adb4c3cef5bfa72f30c9861c] 2 checkmultisig checksig");
+    REQUIRE(script_template::sigops(bytes, true) == 3);
+    REQUIRE(script_template::sigops(bytes, false) == multisig_default_sigops + 1);
+}
+
+TEST_CASE("script template  sigops  skips push data and stops at truncation", "[script template]") {
+    // [ac] is data, not a checksig.
+    REQUIRE(script_template::sigops(to_chunk(base16_literal("01acac")), false) == 1);
+
+    // The truncated push ends the script.
+    REQUIRE(script_template::sigops(to_chunk(base16_literal("ac05acac")), false) == 1);
+}
+
+TEST_CASE("script template  is unspendable  return prefix", "[script template]") {
+    REQUIRE(script_template::is_unspendable(to_chunk(base16_literal("6a00"))));
+    REQUIRE( ! script_template::is_unspendable(to_chunk(base16_literal("76a914905f933de850988603aafeeb2fd7fce61e66fe5d88ac"))));
+    REQUIRE( ! script_template::is_unspendable(data_chunk{}));
+}
+
+// End Test Suite
@@ -0,0 +1,118 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/domain/chain/sighash_context.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::chain;
+using namespace kth::domain::machine;
+
+// Start Test Suite: chain sighash context tests
+
+namespace {
+
+script make_script(std::string const& mnemonic) {
+    script result;
+    REQUIRE(result.from_string(mnemonic));
+    return result;
+}
+
+// Three inputs, two outputs, the last prevout carries a fungible token.
+transaction make_transaction() {
+    auto const prevout_script = make_script("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig");
+
+    input::list inputs;
+    inputs.emplace_back(output_point{hash_literal("b3807042c92f449bbf79b33ca59d7dfec7f4cc71096704a9c526dddf496ee097"), 0}, script{}, 0xffffffff);
+    inputs.emplace_back(output_point{hash_literal("42e7988254800876b69f24676b3e0205b77be476512ca4d970707dd5c60598ab"), 1}, script{}, 0xfffffffe);
+    inputs.emplace_back(output_point{hash_literal("5df1375ffe61ac35ca178ebb0cab9ea26dedbd0e96005dfcee7e379fa513232f"), 2}, script{}, 0);
+
+    output::list outputs;
+    outputs.emplace_back(90000, prevout_script, token_data_opt{});
+    outputs.emplace_back(12345, make_script("return [00010203]"), token_data_opt{});
+
+    transaction tx(2, 500000, std::move(inputs), std::move(outputs));
+
+    uint64_t value = 100000;
+    for (auto& input : tx.inputs()) {
+        input.previous_output().validation.cache = output(value, prevout_script, token_data_opt{});
+        value += 1000;
+    }
+
+    auto const id = hash_literal("0000000000000000000000000000000000000000000000000000000000000042");
+    tx.inputs().back().previous_output().validation.cache.token_data() = token_data_t{id, fungible{amount_t{1000}}};
+    return tx;
+}
+
+std::pair<hash_digest, size_t> expected_hash(transaction const& tx, uint32_t index, script const& code, uint8_t type, uint32_t forks, uint64_t value) {
+#if defined(KTH_CURRENCY_BCH)
+    return script::generate_signature_hash(tx, index, code, type, forks, value);
+#else
+    return script::generate_signature_hash(tx, index, code, type, forks, script::script_version::zero, value);
+#endif
+}
+
+void check_all_inputs(uint32_t forks) {
+    auto const tx = make_transaction();
+    auto const code = make_script("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig");
+    sighash_context const context(tx, forks);
+
+    // all, none, single, anyone_can_pay and utxos variants (all with forkid).
+    for (uint8_t const type : {0x41, 0x42, 0x43, 0xc1, 0xc2, 0xc3, 0x61, 0x63}) {
+        for (uint32_t index = 0; index < tx.inputs().size(); ++index) {
+            auto const value = tx.inputs()[index].previous_output().validation.cache.value();
+            auto const expected = expected_hash(tx, index, code, type, forks, value);
+            auto const result = context.signature_hash(index, code, value, type);
+            REQUIRE(result.first == expected.first);
+            REQUIRE(result.second == expected.second);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("chain sighash context  constructor  components  match transaction", "[chain sighash context]") {
+    auto const tx = make_transaction();
+    sighash_context const context(tx, rule_fork::bch_descartes);
+    REQUIRE(&context.tx() == &tx);
+    REQUIRE(context.active_forks() == rule_fork::bch_descartes);
+    REQUIRE(context.inpoints_hash() == tx.inpoints_hash());
+    REQUIRE(context.sequences_hash() == tx.sequences_hash());
+    REQUIRE(context.outputs_hash() == tx.outputs_hash());
+    REQUIRE(context.utxos_hash() == tx.utxos_hash());
+}
+
+TEST_CASE("chain sighash context  constructor  descartes inactive  null utxos hash", "[chain sighash context]") {
+    auto const tx = make_transaction();
+    sighash_context const context(tx, rule_fork::no_rules);
+    REQUIRE(context.utxos_hash() == null_hash);
+}
+
+TEST_CASE("chain sighash context  signature hash  no rules  matches generate signature hash", "[chain sighash context]") {
+    check_all_inputs(rule_fork::no_rules);
+}
+
+TEST_CASE("chain sighash context  signature hash  descartes  matches generate signature hash", "[chain sighash context]") {
+    check_all_inputs(rule_fork::bch_descartes);
+}
+
+TEST_CASE("chain sighash context  generate signature hash  with context  same result", "[chain sighash context]") {
+    auto const tx = make_transaction();
+    auto const code = make_script("dup hash160 [88350574280395ad2c3e2ee20e322073d94e5e40] equalverify checksig");
+    uint32_t const forks = rule_fork::bch_descartes;
+    sighash_context const context(tx, forks);
+
+    auto const value = tx.inputs()[1].previous_output().validation.cache.value();
+    auto const expected = expected_hash(tx, 1, code, 0x41, forks, value);
+#if defined(KTH_CURRENCY_BCH)
+    auto const result = script::generate_signature_hash(tx, 1, code, 0x41, forks, value, &context);
+#else
+    auto const result = script::generate_signature_hash(tx, 1, code, 0x41, forks, script::script_version::zero, value, &context);
+#endif
+    REQUIRE(result == expected);
+}
+
+// End Test Suite
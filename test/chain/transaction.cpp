@@ -980,4 +980,25 @@ TEST_CASE("chain transaction  hash  block320670  success", "[chain transaction]"
     REQUIRE(data == instance.to_data());
 }
 
+TEST_CASE("chain transaction  copy  carries cached hash", "[chain transaction]") {
+    chain::transaction const tx(1, 0, chain::input::list{}, chain::output::list{});
+    auto const hash = tx.hash();
+    auto const copy = tx;
+    REQUIRE(copy.hash() == hash);
+
+    auto modified = copy;
+    modified.set_locktime(1);
+    REQUIRE(modified.hash() != hash);
+}
+
+TEST_CASE("chain transaction  set outputs  resets cached total", "[chain transaction]") {
+    chain::output::list outputs{chain::output(10, chain::script{}, chain::token_data_opt{})};
+    chain::transaction tx(1, 0, chain::input::list{}, outputs);
+    REQUIRE(tx.total_output_value() == 10u);
+
+    outputs.front().set_value(20);
+    tx.set_outputs(outputs);
+    REQUIRE(tx.total_output_value() == 20u);
+}
+
 // End Test Suite
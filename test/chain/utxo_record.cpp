@@ -0,0 +1,144 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::chain;
+
+namespace {
+
+chain::script make_raw_script(std::string_view hex) {
+    return chain::script(to_chunk(base16_literal(hex)), false);
+}
+
+utxo_record make_record(uint64_t value, chain::script const& script, uint32_t height, bool coinbase, token_data_opt token = {}) {
+    utxo_record record;
+    record.output = chain::output(value, script, std::move(token));
+    record.height = height;
+    record.coinbase = coinbase;
+    return record;
+}
+
+void require_round_trip(utxo_record const& expected) {
+    auto const data = expected.to_data();
+    REQUIRE(data.size() == expected.serialized_size());
+
+    byte_reader reader(data);
+    auto const result = utxo_record::from_data(reader);
+    REQUIRE(result);
+    REQUIRE(reader.is_exhausted());
+    REQUIRE(result->output == expected.output);
+    REQUIRE(result->height == expected.height);
+    REQUIRE(result->coinbase == expected.coinbase);
+}
+
+} // namespace
+
+// Start Test Suite: utxo record tests
+
+TEST_CASE("utxo record  compress amount  known values", "[utxo record]") {
+    uint64_t const coin = 100000000;
+    REQUIRE(compress_amount(0) == 0);
+    REQUIRE(compress_amount(1) == 1);
+    REQUIRE(compress_amount(1000000) == 7);
+    REQUIRE(compress_amount(coin) == 9);
+    REQUIRE(compress_amount(50 * coin) == 50);
+    REQUIRE(compress_amount(21000000 * coin) == 21000000);
+
+    for (uint64_t value : {uint64_t(0), uint64_t(1), uint64_t(12345), uint64_t(546), 50 * coin, 21000000 * coin, max_uint64 / 10}) {
+        REQUIRE(decompress_amount(compress_amount(value)) == value);
+    }
+}
+
+TEST_CASE("utxo record  p2pkh  compact round trip", "[utxo record]") {
+    auto const record = make_record(50 * 100000000, make_raw_script("76a914905f933de850988603aafeeb2fd7fce61e66fe5d88ac"), 500000, false);
+
+    // varint code (3 bytes), amount (1 byte), kind (1 byte), key hash (20 bytes).
+    REQUIRE(record.serialized_size() == 25);
+    require_round_trip(record);
+}
+
+TEST_CASE("utxo record  standard templates  round trip", "[utxo record]") {
+    // p2sh
+    require_round_trip(make_record(1234, make_raw_script("a914748284390f9e263a4b766a75d0633c50426eb87587"), 1, true));
+
+    // p2sh32
+    require_round_trip(make_record(1234, make_raw_script("aa2000112233445566778899aabbccddeeff00112233445566778899aabbccddeeff87"), 2, false));
+
+    // p2pk, both key prefixes
+    require_round_trip(make_record(5000000000, make_raw_script("2102a1633cafcc01ebfb6d78e39f687a1f0995c62fc95f51ead10a02ee0be551b5dcac"), 0, true));
+    require_round_trip(make_record(5000000000, make_raw_script("2103a1633cafcc01ebfb6d78e39f687a1f0995c62fc95f51ead10a02ee0be551b5dcac"), 0, true));
+}
+
+TEST_CASE("utxo record  non standard scripts  round trip", "[utxo record]") {
+    // Uncompressed p2pk is stored raw.
+    require_round_trip(make_record(5000000000, make_raw_script("4104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac"), 0, true));
+
+    // Op return and the empty script.
+    require_round_trip(make_record(0, make_raw_script("6a0400010203"), 700000, false));
+    require_round_trip(make_record(0, chain::script{}, 700000, false));
+}
+
+TEST_CASE("utxo record  token data  round trip", "[utxo record]") {
+    auto const id = hash_literal("0000000000000000000000000000000000000000000000000000000000000042");
+    token_data_t const token{id, fungible{amount_t{1000}}};
+    require_round_trip(make_record(1000, make_raw_script("76a914905f933de850988603aafeeb2fd7fce61e66fe5d88ac"), 800000, false, token));
+}
+
+TEST_CASE("utxo record  truncated  fails", "[utxo record]") {
+    auto const record = make_record(1000, make_raw_script("76a914905f933de850988603aafeeb2fd7fce61e66fe5d88ac"), 800000, false);
+    auto data = record.to_data();
+    data.pop_back();
+
+    byte_reader reader(data);
+    REQUIRE( ! utxo_record::from_data(reader));
+}
+
+TEST_CASE("utxo record  to utxo  keeps point value and height", "[utxo record]") {
+    output_point const point{hash_literal("4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b"), 0};
+    auto const record = make_record(5000000000, make_raw_script("6a"), 123, true);
+    auto const result = record.to_utxo(point);
+    REQUIRE(result.point() == point);
+    REQUIRE(result.amount() == 5000000000);
+    REQUIRE(result.height() == 123);
+}
+
+TEST_CASE("utxo table  insert sort find  returns records", "[utxo record]") {
+    utxo_table table;
+    auto const hash_a = hash_literal("00000000000000000000000000000000000000000000000000000000000000aa");
+    auto const hash_b = hash_literal("00000000000000000000000000000000000000000000000000000000000000bb");
+    auto const script = make_raw_script("76a914905f933de850988603aafeeb2fd7fce61e66fe5d88ac");
+
+    REQUIRE(table.insert(output_point{hash_b, 1}, make_record(3, script, 30, false)));
+    REQUIRE(table.insert(output_point{hash_a, 7}, make_record(2, script, 20, false)));
+    REQUIRE(table.insert(output_point{hash_a, 0}, make_record(1, script, 10, true)));
+    REQUIRE( ! table.is_sorted());
+
+    table.sort();
+    REQUIRE(table.is_sorted());
+    REQUIRE(table.size() == 3);
+
+    auto const found = table.find(output_point{hash_a, 7});
+    REQUIRE(found);
+    REQUIRE(found->output.value() == 2);
+    REQUIRE(found->height == 20);
+
+    auto const first = table.find(output_point{hash_a, 0});
+    REQUIRE(first);
+    REQUIRE(first->coinbase);
+
+    REQUIRE( ! table.find(output_point{hash_a, 1}));
+    REQUIRE( ! table.find(output_point{hash_b, 0}));
+
+    // A view over copies of the two arrays finds the same records.
+    std::vector<utxo_key> const keys(table.keys().begin(), table.keys().end());
+    data_chunk const records(table.records().begin(), table.records().end());
+    utxo_table_view const view(keys, records);
+    REQUIRE(view.contains(output_point{hash_b, 1}));
+    REQUIRE(view.find(output_point{hash_b, 1})->output.value() == 3);
+}
+
+// End Test Suite
@@ -0,0 +1,211 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <kth/domain/chain/script_cache.hpp>
+#include <kth/domain/chain/verification_pool.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::chain;
+
+// Start Test Suite: chain verification pool tests
+
+namespace {
+
+// [1]
+data_chunk const pass{0x51};
+
+// [1 sha256 ... sha256], slower to verify so that later jobs finish first.
+data_chunk const slow_pass = [] {
+    data_chunk script{0x51};
+    script.insert(script.end(), 200, 0xa8);
+    return script;
+}();
+
+// [0]: stack_false.
+data_chunk const stack_false{0x00};
+
+// [1 return]: op_return, a leading return would be an invalid script.
+data_chunk const op_return{0x51, 0x6a};
+
+hash_digest make_hash(uint32_t salt) {
+    auto hash = null_hash;
+    std::memcpy(hash.data(), &salt, sizeof(salt));
+    hash.back() = 0x01;
+    return hash;
+}
+
+// Each input spends its own previous output with the script.
+transaction make_transaction(std::vector<data_chunk> const& prevout_scripts, uint32_t salt) {
+    input::list inputs;
+    for (uint32_t index = 0; index < prevout_scripts.size(); ++index) {
+        inputs.emplace_back(output_point{make_hash(salt), index}, script{}, 0xffffffff);
+    }
+
+    output::list outputs;
+    outputs.emplace_back(1000, script(pass, false), token_data_opt{});
+
+    transaction tx(1, salt, std::move(inputs), std::move(outputs));
+
+    for (size_t index = 0; index < prevout_scripts.size(); ++index) {
+        tx.inputs()[index].previous_output().validation.cache = output(2000, script(prevout_scripts[index], false), token_data_opt{});
+    }
+
+    return tx;
+}
+
+// The transactions of the inputs, in inputs_per_tx groups.
+transaction::list make_transactions(std::vector<data_chunk> const& prevout_scripts, size_t inputs_per_tx, uint32_t salt) {
+    transaction::list txs;
+    for (size_t first = 0; first < prevout_scripts.size(); first += inputs_per_tx) {
+        auto const last = std::min(first + inputs_per_tx, prevout_scripts.size());
+        std::vector<data_chunk> const group(prevout_scripts.begin() + first, prevout_scripts.begin() + last);
+        txs.push_back(make_transaction(group, uint32_t(salt + first)));
+    }
+
+    return txs;
+}
+
+transaction make_coinbase(uint32_t salt) {
+    input::list inputs;
+    inputs.emplace_back(output_point{null_hash, output_point::null_index}, script(data_chunk{0x51, 0x51}, false), salt);
+
+    output::list outputs;
+    outputs.emplace_back(5000000000, script(pass, false), token_data_opt{});
+    return transaction(1, salt, std::move(inputs), std::move(outputs));
+}
+
+code connect_serial(transaction::list const& txs, chain_state const& state) {
+    block const serial(header{}, txs);
+    return serial.connect_transactions(state);
+}
+
+bool is_cached(transaction const& tx, chain_state const& state) {
+    auto const& cache = script_cache::global();
+    return cache.contains(cache.entry(tx, state.enabled_forks()));
+}
+
+} // namespace
+
+TEST_CASE("chain verification pool  constructor  explicit threads  expected size", "[chain verification pool]") {
+    chain::verification_pool pool(4);
+#if defined(__EMSCRIPTEN__)
+    REQUIRE(pool.size() == 1u);
+#else
+    REQUIRE(pool.size() == 4u);
+#endif
+}
+
+TEST_CASE("chain verification pool  constructor  zero threads  at least one", "[chain verification pool]") {
+    chain::verification_pool pool;
+    REQUIRE(pool.size() >= 1u);
+}
+
+TEST_CASE("chain verification pool  constructor  single thread  one", "[chain verification pool]") {
+    chain::verification_pool pool(1);
+    REQUIRE(pool.size() == 1u);
+}
+
+TEST_CASE("chain verification pool  connect  failure at any position  serial code", "[chain verification pool]") {
+    auto const state = make_chain_state(1000, 11, 0x207fffff, 1500000000);
+    chain::verification_pool pool(4);
+
+    for (size_t const position : {size_t(0), size_t(57), size_t(150), size_t(398), size_t(399)}) {
+        std::vector<data_chunk> scripts(400, pass);
+        scripts[position] = stack_false;
+        auto const txs = make_transactions(scripts, 50, uint32_t(1000 + position * 1000));
+
+        auto const expected = connect_serial(txs, *state);
+        REQUIRE(expected == error::stack_false);
+        REQUIRE(pool.connect(txs, *state) == expected);
+    }
+}
+
+TEST_CASE("chain verification pool  connect  later job fails first  first serial failure", "[chain verification pool]") {
+    auto const state = make_chain_state(1000, 11, 0x207fffff, 1500000000);
+    chain::verification_pool pool(4);
+
+    // The slice of worker 0 verifies slowly up to its failure, the first job
+    // of worker 3 fails immediately with another code.
+    std::vector<data_chunk> scripts(400, pass);
+    std::fill(scripts.begin(), scripts.begin() + 99, slow_pass);
+    scripts[99] = stack_false;
+    scripts[300] = op_return;
+
+    for (uint32_t run = 0; run < 20; ++run) {
+        auto const txs = make_transactions(scripts, 100, 2000000 + run * 1000);
+        REQUIRE(pool.connect(txs, *state) == error::stack_false);
+        REQUIRE(pool.parallel());
+        REQUIRE(connect_serial(txs, *state) == error::stack_false);
+    }
+}
+
+TEST_CASE("chain verification pool  connect  coinbase and validated  skipped", "[chain verification pool]") {
+    auto const state = make_chain_state(1000, 11, 0x207fffff, 1500000000);
+    chain::verification_pool pool(4);
+
+    transaction::list txs;
+    txs.push_back(make_coinbase(3000000));
+    txs.push_back(make_transaction({pass, pass, pass}, 3000001));
+    txs.push_back(make_transaction({stack_false, op_return}, 3000002));
+    txs.back().validation.validated = true;
+
+    REQUIRE(pool.connect(txs, *state) == error::success);
+    REQUIRE(pool.jobs() == 3u);
+    REQUIRE(connect_serial(txs, *state) == error::success);
+}
+
+TEST_CASE("chain verification pool  connect  single job  serial", "[chain verification pool]") {
+    auto const state = make_chain_state(1000, 11, 0x207fffff, 1500000000);
+    chain::verification_pool pool(4);
+
+    auto const passing = make_transaction({pass}, 4000000);
+    REQUIRE(pool.connect(passing, *state) == error::success);
+    REQUIRE(pool.jobs() == 1u);
+    REQUIRE( ! pool.parallel());
+
+    auto const failing = make_transaction({op_return}, 4000001);
+    REQUIRE(pool.connect(failing, *state) == error::op_return);
+    REQUIRE( ! pool.parallel());
+}
+
+TEST_CASE("chain verification pool  connect  passing set  cached", "[chain verification pool]") {
+    auto const state = make_chain_state(1000, 11, 0x207fffff, 1500000000);
+    chain::verification_pool pool(4);
+
+    auto const txs = make_transactions(std::vector<data_chunk>(40, pass), 10, 5000000);
+    REQUIRE( ! is_cached(txs.front(), *state));
+    REQUIRE(pool.connect(txs, *state) == error::success);
+
+    for (auto const& tx : txs) {
+        REQUIRE(is_cached(tx, *state));
+    }
+
+    // Cached transactions have no jobs.
+    REQUIRE(pool.connect(txs, *state) == error::success);
+    REQUIRE(pool.jobs() == 0u);
+}
+
+TEST_CASE("chain verification pool  connect  failing set  not cached", "[chain verification pool]") {
+    auto const state = make_chain_state(1000, 11, 0x207fffff, 1500000000);
+    chain::verification_pool pool(4);
+
+    std::vector<data_chunk> scripts(40, pass);
+    scripts.back() = stack_false;
+    auto const txs = make_transactions(scripts, 10, 6000000);
+
+    REQUIRE(pool.connect(txs, *state) == error::stack_false);
+
+    for (auto const& tx : txs) {
+        REQUIRE( ! is_cached(tx, *state));
+    }
+}
+
+// End Test Suite
@@ -0,0 +1,74 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::machine;
+
+// Start Test Suite: bytecode tests
+
+TEST_CASE("bytecode  construct  pay public key hash  borrows push data", "[bytecode]") {
+    auto const script = to_chunk(base16_literal("76a914905f933de850988603aafeeb2fd7fce61e66fe5d88ac"));
+    bytecode const instance(script, rule_fork::no_rules, max_push_data_size_legacy);
+    REQUIRE(instance.is_valid());
+    REQUIRE(instance.size() == 5);
+
+    REQUIRE(instance[2].code == opcode::push_size_20);
+    REQUIRE(instance[2].offset == 2);
+    REQUIRE(instance[2].data_offset == 3);
+    REQUIRE(instance[2].data_size == 20);
+
+    auto const push = instance.at(2);
+    REQUIRE(push.data().data() == script.data() + 3);
+    REQUIRE(instance.at(4).code() == opcode::checksig);
+    REQUIRE(instance.counted(0, instance.size()) == 4);
+}
+
+TEST_CASE("bytecode  construct  extended push sizes  decoded", "[bytecode]") {
+    auto const script = to_chunk(base16_literal("4c02abcd4d0100ef"));
+    bytecode const instance(script, rule_fork::no_rules, max_push_data_size_legacy);
+    REQUIRE(instance.is_valid());
+    REQUIRE(instance.size() == 2);
+    REQUIRE(encode_base16(data_chunk(instance.at(0).data().begin(), instance.at(0).data().end())) == "abcd");
+    REQUIRE(encode_base16(data_chunk(instance.at(1).data().begin(), instance.at(1).data().end())) == "ef");
+}
+
+TEST_CASE("bytecode  construct  truncated push  invalid", "[bytecode]") {
+    auto const script = to_chunk(base16_literal("764c05abcd"));
+    bytecode const instance(script, rule_fork::no_rules, max_push_data_size_legacy);
+    REQUIRE( ! instance.is_valid());
+    REQUIRE(instance.size() == 2);
+    REQUIRE(instance[1].code == opcode::invalidopcode);
+}
+
+TEST_CASE("bytecode  skip  flat branch  next conditional", "[bytecode]") {
+    // [if dup dup endif dup]
+    auto const script = to_chunk(base16_literal("6376766876"));
+    bytecode const instance(script, rule_fork::no_rules, max_push_data_size_legacy);
+    REQUIRE(instance[0].skip == 3);
+    REQUIRE(instance[1].skip == 3);
+    REQUIRE(instance[3].skip == 5);
+    REQUIRE(instance.counted(1, 3) == 2);
+}
+
+TEST_CASE("bytecode  skip  oversized push in branch  next instruction", "[bytecode]") {
+    // [if [3 bytes] endif] with pushes limited to 2 bytes.
+    auto const script = to_chunk(base16_literal("6303abcdef68"));
+    bytecode const instance(script, rule_fork::no_rules, 2);
+    REQUIRE((instance[1].flags & bytecode::instruction::oversized) != 0);
+    REQUIRE(instance[0].skip == 1);
+    REQUIRE(instance[1].skip == 2);
+}
+
+TEST_CASE("bytecode  script from  code separator  remaining bytes", "[bytecode]") {
+    // [dup codeseparator checksig]
+    auto const script = to_chunk(base16_literal("76abac"));
+    bytecode const instance(script, rule_fork::no_rules, max_push_data_size_legacy);
+    REQUIRE(instance.script_from(2).size() == 1);
+    REQUIRE(instance.script_from(3).empty());
+}
+
+// End Test Suite
@@ -0,0 +1,70 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <sstream>
+#include <thread>
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::machine;
+
+// Start Test Suite: opcode profile tests
+
+TEST_CASE("opcode profile  record  accumulates per opcode", "[opcode profile]") {
+    opcode_profile instance;
+    instance.record(opcode::dup, 10, 33);
+    instance.record(opcode::dup, 5, 20);
+    instance.record(opcode::checksig, 100, 72);
+
+    auto const dup = instance.get(opcode::dup);
+    REQUIRE(dup.count == 2);
+    REQUIRE(dup.cycles == 15);
+    REQUIRE(dup.bytes == 53);
+    REQUIRE(instance.get(opcode::add).count == 0);
+    REQUIRE(instance.total_count() == 3);
+    REQUIRE(instance.total_cycles() == 115);
+}
+
+TEST_CASE("opcode profile  merge  sums entries", "[opcode profile]") {
+    opcode_profile first;
+    opcode_profile second;
+    first.record(opcode::dup, 10, 1);
+    second.record(opcode::dup, 20, 2);
+    second.record(opcode::equal, 7, 3);
+
+    first.merge(second);
+    REQUIRE(first.get(opcode::dup).cycles == 30);
+    REQUIRE(first.get(opcode::equal).count == 1);
+
+    first.reset();
+    REQUIRE(first.total_count() == 0);
+}
+
+TEST_CASE("opcode profile  dump  folded lines for executed opcodes", "[opcode profile]") {
+    opcode_profile instance;
+    instance.record(opcode::dup, 42, 0);
+
+    std::ostringstream out;
+    instance.dump(out);
+    REQUIRE(out.str() == "script;dup 42\n");
+}
+
+TEST_CASE("opcode profile  collect  includes ended threads", "[opcode profile]") {
+    opcode_profile::reset_all();
+
+    std::thread worker([] {
+        opcode_profile::local().record(opcode::sha256, 50, 32);
+    });
+    worker.join();
+    opcode_profile::local().record(opcode::sha256, 25, 32);
+
+    auto const total = opcode_profile::collect();
+    REQUIRE(total.get(opcode::sha256).count == 2);
+    REQUIRE(total.get(opcode::sha256).cycles == 75);
+    opcode_profile::reset_all();
+}
+
+// End Test Suite
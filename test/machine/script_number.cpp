@@ -0,0 +1,93 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <limits>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::machine;
+
+// Start Test Suite: script number tests
+
+namespace {
+
+std::string encode(int64_t value) {
+    stack_element element;
+    script_number::encode(element, value);
+    return encode_base16(element.to_chunk());
+}
+
+} // namespace
+
+TEST_CASE("script number  encode  values  minimal sign and magnitude", "[script number]") {
+    REQUIRE(encode(0).empty());
+    REQUIRE(encode(1) == "01");
+    REQUIRE(encode(-1) == "81");
+    REQUIRE(encode(127) == "7f");
+    REQUIRE(encode(128) == "8000");
+    REQUIRE(encode(-128) == "8080");
+    REQUIRE(encode(256) == "0001");
+    REQUIRE(encode(std::numeric_limits<int64_t>::max()) == "ffffffffffffff7f");
+    REQUIRE(script_number::encoded_size(-128) == 2);
+}
+
+TEST_CASE("script number  decode  values  matches number", "[script number]") {
+    for (int64_t const value : {int64_t(0), int64_t(1), int64_t(-1), int64_t(-255), int64_t(32768), int64_t(-2147483647), std::numeric_limits<int64_t>::max()}) {
+        stack_element element;
+        script_number::encode(element, value);
+
+        int64_t decoded;
+        REQUIRE(script_number::decode(decoded, byte_span(element.data(), element.size()), max_number_size_64_bits));
+        REQUIRE(decoded == value);
+
+        infrastructure::machine::number expected;
+        REQUIRE(expected.set_data(element.to_chunk(), max_number_size_64_bits));
+        REQUIRE(expected.int64() == value);
+    }
+}
+
+TEST_CASE("script number  decode  oversized  false", "[script number]") {
+    auto const data = to_chunk(base16_literal("0000000001"));
+    int64_t decoded;
+    REQUIRE( ! script_number::decode(decoded, data, max_number_size_32_bits));
+    REQUIRE(script_number::decode(decoded, data, max_number_size_64_bits));
+    REQUIRE(decoded == 0x0100000000);
+}
+
+TEST_CASE("script number  decode  negative zero  zero", "[script number]") {
+    auto const data = to_chunk(base16_literal("0080"));
+    int64_t decoded;
+    REQUIRE(script_number::decode(decoded, data, max_number_size_32_bits));
+    REQUIRE(decoded == 0);
+}
+
+TEST_CASE("script number  minimally encode  padded  trimmed", "[script number]") {
+    stack_element padded{0x01, 0x00, 0x00, 0x80};
+    script_number::minimally_encode(padded);
+    REQUIRE(encode_base16(padded.to_chunk()) == "81");
+
+    stack_element sign{0x80, 0x00, 0x00};
+    script_number::minimally_encode(sign);
+    REQUIRE(encode_base16(sign.to_chunk()) == "8000");
+
+    stack_element zero{0x00, 0x80};
+    script_number::minimally_encode(zero);
+    REQUIRE(zero.empty());
+}
+
+TEST_CASE("script number  checked operations  out of range  nullopt", "[script number]") {
+    auto const max = std::numeric_limits<int64_t>::max();
+    REQUIRE( ! script_number::add(max, 1));
+    REQUIRE( ! script_number::sub(-max, 1));
+    REQUIRE( ! script_number::mul(max, 2));
+    REQUIRE( ! script_number::mul(-max, -2));
+    REQUIRE(script_number::add(max, -1) == max - 1);
+    REQUIRE(script_number::sub(-max, -1) == -max + 1);
+    REQUIRE(script_number::mul(-3, 7) == -21);
+    REQUIRE(script_number::mul(0, max) == 0);
+}
+
+// End Test Suite
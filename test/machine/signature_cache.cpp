@@ -0,0 +1,43 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::machine;
+
+// Start Test Suite: signature cache tests
+
+namespace {
+
+hash_digest make_entry(signature_cache const& cache, uint8_t seed) {
+    hash_digest sighash{};
+    sighash[0] = seed;
+    data_chunk const public_key(33, 0x02);
+    ec_signature const signature{};
+    return cache.entry(sighash, public_key, signature);
+}
+
+} // namespace
+
+TEST_CASE("signature cache  contains  inserted  hit", "[signature cache]") {
+    signature_cache cache(1024, 2);
+    auto const entry = make_entry(cache, 1);
+    REQUIRE( ! cache.contains(entry));
+    cache.insert(entry);
+    REQUIRE(cache.contains(entry));
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 1);
+}
+
+TEST_CASE("signature cache  entry  distinct salts  distinct entries", "[signature cache]") {
+    signature_cache const first(1024, 1);
+    signature_cache const second(1024, 1);
+    REQUIRE(make_entry(first, 1) != make_entry(second, 1));
+    REQUIRE(make_entry(first, 1) == make_entry(first, 1));
+    REQUIRE(make_entry(first, 1) != make_entry(first, 2));
+}
+
+// End Test Suite
@@ -0,0 +1,107 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <memory_resource>
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+using namespace kth::domain::machine;
+
+namespace {
+
+// Counts the outstanding allocations.
+class counting_resource : public std::pmr::memory_resource {
+public:
+    size_t outstanding{0};
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ++outstanding;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {
+        --outstanding;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+// Start Test Suite: stack element tests
+
+TEST_CASE("stack element  construct  signature size  inline", "[stack element]") {
+    stack_element const instance(data_chunk(72, 0x30));
+    REQUIRE(instance.is_inline());
+    REQUIRE(instance.size() == 72);
+    REQUIRE(instance == stack_element(data_chunk(72, 0x30)));
+}
+
+TEST_CASE("stack element  construct  initializer list  bytes", "[stack element]") {
+    REQUIRE(stack_element{}.empty());
+    REQUIRE((stack_element{0x01, 0x02} == data_chunk{0x01, 0x02}));
+}
+
+TEST_CASE("stack element  push back  past inline capacity  allocated from resource", "[stack element]") {
+    counting_resource resource;
+    {
+        stack_element instance(&resource);
+        for (size_t i = 0; i <= stack_element::inline_capacity; ++i) {
+            instance.push_back(uint8_t(i));
+        }
+
+        REQUIRE( ! instance.is_inline());
+        REQUIRE(instance.size() == stack_element::inline_capacity + 1);
+        REQUIRE(instance.back() == stack_element::inline_capacity);
+        REQUIRE(resource.outstanding == 1);
+    }
+
+    REQUIRE(resource.outstanding == 0);
+}
+
+TEST_CASE("stack element  element stack  items use the stack resource", "[stack element]") {
+    counting_resource resource;
+    {
+        element_stack stack(&resource);
+        stack.reserve(4);
+        auto const reserved = resource.outstanding;
+
+        stack.push_back(data_chunk(33, 0x02));
+        stack.push_back(data_chunk(100, 0xff));
+        REQUIRE(stack[1].get_allocator().resource() == &resource);
+        REQUIRE(resource.outstanding == reserved + 1);
+
+        // Items of the same resource swap their buffers.
+        std::swap(stack[0], stack[1]);
+        REQUIRE(stack[0].size() == 100);
+        REQUIRE(stack[1].size() == 33);
+        REQUIRE(resource.outstanding == reserved + 1);
+    }
+
+    REQUIRE(resource.outstanding == 0);
+}
+
+TEST_CASE("stack element  insert  cat of two items", "[stack element]") {
+    stack_element first(data_chunk(50, 0x01));
+    stack_element const second(data_chunk(50, 0x02));
+    first.insert(first.end(), second.begin(), second.end());
+    REQUIRE(first.size() == 100);
+    REQUIRE(first[49] == 0x01);
+    REQUIRE(first[50] == 0x02);
+}
+
+TEST_CASE("stack element  resize  grow  zero filled", "[stack element]") {
+    stack_element instance{0x01};
+    instance.resize(3);
+    REQUIRE((instance == data_chunk{0x01, 0x00, 0x00}));
+    REQUIRE(instance.to_chunk() == data_chunk{0x01, 0x00, 0x00});
+}
+
+// End Test Suite
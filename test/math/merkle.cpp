@@ -0,0 +1,96 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/domain/math/merkle.hpp>
+#include <kth/domain/math/sha256.hpp>
+
+using namespace kth;
+using namespace kd;
+
+namespace {
+
+// The pairwise definition, one level at a time.
+hash_digest reference_root(hash_list nodes) {
+    while (nodes.size() > 1) {
+        if (nodes.size() % 2 != 0) {
+            nodes.push_back(nodes.back());
+        }
+
+        hash_list parents;
+        for (size_t i = 0; i < nodes.size(); i += 2) {
+            parents.push_back(bitcoin_hash(build_chunk({nodes[i], nodes[i + 1]})));
+        }
+        nodes = std::move(parents);
+    }
+
+    return nodes.front();
+}
+
+hash_list make_leaves(size_t count) {
+    hash_list leaves(count);
+    for (size_t i = 0; i < count; ++i) {
+        leaves[i] = bitcoin_hash(to_little_endian(uint64_t(i)));
+    }
+    return leaves;
+}
+
+// Restores the selected kernels at the end of a test.
+struct implementation_guard {
+    ~implementation_guard() {
+        select_sha256_implementation(sha256_implementations().front());
+    }
+};
+
+} // namespace
+
+// Start Test Suite: merkle tests
+
+TEST_CASE("merkle root  empty  null hash", "[merkle]") {
+    REQUIRE(merkle_root({}) == null_hash);
+}
+
+TEST_CASE("merkle root  single leaf  leaf", "[merkle]") {
+    auto const leaves = make_leaves(1);
+    REQUIRE(merkle_root(leaves) == leaves.front());
+}
+
+TEST_CASE("merkle root  small trees  matches pairwise hashing", "[merkle]") {
+    for (size_t count = 2; count <= 40; ++count) {
+        auto const leaves = make_leaves(count);
+        REQUIRE(merkle_root(leaves) == reference_root(leaves));
+    }
+}
+
+TEST_CASE("merkle root  threaded  matches single threaded", "[merkle]") {
+    // Uneven sizes exercise a partial rightmost subtree.
+    for (size_t const count : {size_t(8192), size_t(8193), size_t(20001)}) {
+        auto const leaves = make_leaves(count);
+        auto const expected = reference_root(leaves);
+
+        for (size_t const threads : {size_t(1), size_t(2), size_t(3), size_t(4)}) {
+            REQUIRE(merkle_root(leaves, threads) == expected);
+        }
+    }
+}
+
+TEST_CASE("merkle root  every implementation  matches pairwise hashing", "[merkle]") {
+    implementation_guard const guard;
+
+    for (auto const name : sha256_implementations()) {
+        INFO(name);
+        REQUIRE(select_sha256_implementation(name));
+
+        for (size_t count = 2; count <= 40; ++count) {
+            auto const leaves = make_leaves(count);
+            REQUIRE(merkle_root(leaves) == reference_root(leaves));
+        }
+
+        auto const leaves = make_leaves(8193);
+        REQUIRE(merkle_root(leaves, 3) == reference_root(leaves));
+    }
+}
+
+// End Test Suite
@@ -0,0 +1,221 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/domain/math/sha256.hpp>
+
+using namespace kth;
+using namespace kd;
+
+namespace {
+
+// Restores the selected kernels at the end of a test.
+struct implementation_guard {
+    ~implementation_guard() {
+        select_sha256_implementation(sha256_implementations().front());
+    }
+};
+
+} // namespace
+
+// Start Test Suite: sha256 context tests
+
+TEST_CASE("sha256 context  finalize  empty  expected", "[sha256 context]") {
+    sha256_context const context;
+    REQUIRE(context.size() == 0u);
+    REQUIRE(encode_base16(context.finalize()) == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+}
+
+TEST_CASE("sha256 context  finalize  abc  expected", "[sha256 context]") {
+    sha256_context context;
+    context.write_bytes(to_chunk(std::string("abc")));
+    REQUIRE(context.size() == 3u);
+    REQUIRE(encode_base16(context.finalize()) == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+}
+
+TEST_CASE("sha256 context  finalize  two block message  expected", "[sha256 context]") {
+    sha256_context context;
+    context.write_bytes(to_chunk(std::string("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq")));
+    REQUIRE(encode_base16(context.finalize()) == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+}
+
+TEST_CASE("sha256 context  finalize  split writes  matches sha256 hash", "[sha256 context]") {
+    data_chunk data(300);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 7 + 3);
+    }
+
+    for (size_t size = 0; size <= data.size(); size += 13) {
+        sha256_context context;
+        size_t offset = 0;
+        while (offset < size) {
+            auto const chunk = std::min(size - offset, offset % 70 + 1);
+            context.write(data.data() + offset, chunk);
+            offset += chunk;
+        }
+
+        data_chunk const prefix(data.begin(), data.begin() + size);
+        REQUIRE(context.finalize() == sha256_hash(prefix));
+        REQUIRE(context.finalize_double() == bitcoin_hash(prefix));
+    }
+}
+
+TEST_CASE("sha256 context  copy  resumed midstate  matches full hash", "[sha256 context]") {
+    data_chunk const prefix(100, 0x2a);
+    sha256_context midstate;
+    midstate.write_bytes(prefix);
+
+    auto first = midstate;
+    first.write_4_bytes_little_endian(1);
+    auto second = midstate;
+    second.write_4_bytes_little_endian(2);
+
+    auto expected = prefix;
+    extend_data(expected, to_little_endian(uint32_t(1)));
+    REQUIRE(first.finalize_double() == bitcoin_hash(expected));
+
+    expected = prefix;
+    extend_data(expected, to_little_endian(uint32_t(2)));
+    REQUIRE(second.finalize_double() == bitcoin_hash(expected));
+}
+
+TEST_CASE("sha256 context  write variable little endian  matches ostream writer", "[sha256 context]") {
+    for (uint64_t const value : {uint64_t(0xfc), uint64_t(0xfd), uint64_t(0x10000), uint64_t(0x100000000)}) {
+        data_chunk data;
+        data_sink ostream(data);
+        ostream_writer sink_w(ostream);
+        sink_w.write_variable_little_endian(value);
+        ostream.flush();
+
+        sha256_context context;
+        context.write_variable_little_endian(value);
+        REQUIRE(context.size() == data.size());
+        REQUIRE(context.finalize() == sha256_hash(data));
+    }
+}
+
+TEST_CASE("double sha256 64  in place  matches bitcoin hash", "[sha256 context]") {
+    // Enough messages to cover every multi-buffer width plus a remainder.
+    size_t const count = 16 + 8 + 4 + 3;
+    data_chunk data(64 * count);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 13 + 5);
+    }
+
+    hash_list expected;
+    for (size_t i = 0; i < count; ++i) {
+        expected.push_back(bitcoin_hash(data_chunk(data.begin() + 64 * i, data.begin() + 64 * (i + 1))));
+    }
+
+    double_sha256_64(data.data(), data.data(), count);
+
+    for (size_t i = 0; i < count; ++i) {
+        REQUIRE(std::equal(expected[i].begin(), expected[i].end(), data.begin() + 32 * i));
+    }
+}
+
+TEST_CASE("double sha256  messages of any size  matches bitcoin hash", "[sha256 context]") {
+    // Sizes around the padding boundaries, more messages than any lane count.
+    std::vector<data_chunk> data;
+    for (size_t size = 0; size < 200; size += 7) {
+        data.emplace_back(size, uint8_t(size));
+    }
+
+    std::vector<data_slice> messages(data.begin(), data.end());
+    hash_list hashes(messages.size());
+    double_sha256(hashes.data(), messages.data(), messages.size());
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        REQUIRE(hashes[i] == bitcoin_hash(data[i]));
+    }
+}
+
+TEST_CASE("sha256 implementations  selected first  generic available", "[sha256 context]") {
+    auto const names = sha256_implementations();
+    REQUIRE( ! names.empty());
+    REQUIRE(std::string(names.front()) == sha256_implementation());
+    REQUIRE(std::find_if(names.begin(), names.end(), [](char const* name) { return std::string(name) == "generic"; }) != names.end());
+    REQUIRE( ! select_sha256_implementation("unknown"));
+}
+
+TEST_CASE("double sha256 64  every implementation  matches bitcoin hash", "[sha256 context]") {
+    implementation_guard const guard;
+
+    // Every count up to twice the widest lanes, so each kernel runs full
+    // lanes plus every remainder.
+    size_t const maximum = 2 * 16 + 1;
+    data_chunk data(64 * maximum);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 29 + 11);
+    }
+
+    hash_list expected;
+    for (size_t i = 0; i < maximum; ++i) {
+        expected.push_back(bitcoin_hash(data_chunk(data.begin() + 64 * i, data.begin() + 64 * (i + 1))));
+    }
+
+    for (auto const name : sha256_implementations()) {
+        INFO(name);
+        REQUIRE(select_sha256_implementation(name));
+
+        for (size_t count = 0; count <= maximum; ++count) {
+            data_chunk out(32 * count);
+            double_sha256_64(out.data(), data.data(), count);
+
+            for (size_t i = 0; i < count; ++i) {
+                REQUIRE(std::equal(expected[i].begin(), expected[i].end(), out.begin() + 32 * i));
+            }
+        }
+    }
+}
+
+TEST_CASE("double sha256  every implementation  matches bitcoin hash", "[sha256 context]") {
+    implementation_guard const guard;
+
+    // Sizes around the padding boundaries.
+    std::vector<data_chunk> data;
+    for (size_t size = 0; size < 300; size += 7) {
+        data.emplace_back(size, uint8_t(size));
+    }
+
+    std::vector<data_slice> const messages(data.begin(), data.end());
+
+    for (auto const name : sha256_implementations()) {
+        INFO(name);
+        REQUIRE(select_sha256_implementation(name));
+
+        // Every count, so the lanes drain with every number of messages left.
+        for (size_t count = 0; count <= messages.size(); ++count) {
+            hash_list hashes(count);
+            double_sha256(hashes.data(), messages.data(), count);
+
+            for (size_t i = 0; i < count; ++i) {
+                REQUIRE(hashes[i] == bitcoin_hash(data[i]));
+            }
+        }
+    }
+}
+
+TEST_CASE("sha256 context  every implementation  matches sha256 hash", "[sha256 context]") {
+    implementation_guard const guard;
+    data_chunk data(1000);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = uint8_t(i * 7 + 3);
+    }
+
+    for (auto const name : sha256_implementations()) {
+        INFO(name);
+        REQUIRE(select_sha256_implementation(name));
+
+        for (size_t size = 0; size <= data.size(); size += 61) {
+            sha256_context context;
+            context.write(data.data(), size);
+            data_chunk const prefix(data.begin(), data.begin() + size);
+            REQUIRE(context.finalize() == sha256_hash(prefix));
+        }
+    }
+}
+
+// End Test Suite
@@ -0,0 +1,97 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/domain/math/sip_hash.hpp>
+#include <kth/infrastructure/math/sip_hash.hpp>
+
+using namespace kth;
+using namespace kd;
+
+namespace {
+
+// Restores the selected kernel at the end of a test.
+struct implementation_guard {
+    ~implementation_guard() {
+        select_sip_hash_implementation(sip_hash_implementations().front());
+    }
+};
+
+} // namespace
+
+// Start Test Suite: sip hash tests
+
+TEST_CASE("sip hash uint256 batch  one value  expected", "[sip hash]") {
+    hash_digest value;
+    for (size_t i = 0; i < value.size(); ++i) {
+        value[i] = uint8_t(i);
+    }
+
+    uint64_t result = 0;
+    sip_hash_uint256_batch(&result, 0x0706050403020100, 0x0f0e0d0c0b0a0908, &value, 1);
+    REQUIRE(result == 0x7127512f72f27cce);
+}
+
+TEST_CASE("sip hash uint256 batch  any count  matches sip hash uint256", "[sip hash]") {
+    hash_list values(37);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = bitcoin_hash(to_chunk(std::to_string(i)));
+    }
+
+    uint64_t const k0 = 0x0123456789abcdef;
+    uint64_t const k1 = 0xfedcba9876543210;
+
+    for (size_t count = 0; count <= values.size(); ++count) {
+        std::vector<uint64_t> result(count + 1, 42);
+        sip_hash_uint256_batch(result.data(), k0, k1, values.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            REQUIRE(result[i] == sip_hash_uint256(k0, k1, values[i]));
+        }
+
+        REQUIRE(result[count] == 42);
+    }
+}
+
+TEST_CASE("sip hash uint256 batch  every implementation  matches sip hash uint256", "[sip hash]") {
+    implementation_guard const guard;
+
+    // Every count up to twice the widest lanes, so each kernel runs full
+    // lanes plus every remainder.
+    hash_list values(2 * 8 + 1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = bitcoin_hash(to_chunk(std::to_string(i * 7)));
+    }
+
+    uint64_t const k0 = 0x0706050403020100;
+    uint64_t const k1 = 0x0f0e0d0c0b0a0908;
+
+    for (auto const name : sip_hash_implementations()) {
+        INFO(name);
+        REQUIRE(select_sip_hash_implementation(name));
+        REQUIRE(std::string(sip_hash_implementation()) == name);
+
+        for (size_t count = 0; count <= values.size(); ++count) {
+            std::vector<uint64_t> result(count + 1, 42);
+            sip_hash_uint256_batch(result.data(), k0, k1, values.data(), count);
+
+            for (size_t i = 0; i < count; ++i) {
+                REQUIRE(result[i] == sip_hash_uint256(k0, k1, values[i]));
+            }
+
+            REQUIRE(result[count] == 42);
+        }
+    }
+}
+
+TEST_CASE("sip hash implementations  selected first  generic available", "[sip hash]") {
+    auto const names = sip_hash_implementations();
+    REQUIRE( ! names.empty());
+    REQUIRE(std::string(names.front()) == sip_hash_implementation());
+    REQUIRE(std::find_if(names.begin(), names.end(), [](char const* name) { return std::string(name) == "generic"; }) != names.end());
+    REQUIRE( ! select_sip_hash_implementation("unknown"));
+}
+
+// End Test Suite
@@ -0,0 +1,135 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+using namespace kth;
+using namespace kd;
+
+// Start Test Suite: compact block reconstructor tests
+
+namespace {
+
+// A block of distinct empty transactions with a valid merkle root.
+message::block make_block(size_t count) {
+    chain::transaction::list transactions;
+    for (size_t index = 0; index < count; ++index) {
+        transactions.emplace_back(1, uint32_t(index), chain::input::list{}, chain::output::list{});
+    }
+
+    chain::block block(chain::header{}, std::move(transactions));
+    block.header().set_merkle(block.generate_merkle_root());
+    return message::block(block);
+}
+
+} // namespace
+
+TEST_CASE("compact block reconstructor  fill  whole pool  complete", "[compact block reconstructor]") {
+    auto const block = make_block(5);
+    auto const compact = message::compact_block::factory_from_block(block);
+
+    message::compact_block_reconstructor instance(compact);
+    REQUIRE(instance.is_valid());
+    REQUIRE(instance.size() == 5);
+    REQUIRE(instance.missing() == 4);
+
+    instance.fill(block.transactions());
+    REQUIRE(instance.missing() == 0);
+    REQUIRE(instance.request().indexes().empty());
+
+    auto const result = instance.complete();
+    REQUIRE(result);
+    REQUIRE(result->hash() == block.hash());
+}
+
+TEST_CASE("compact block reconstructor  fill  partial pool  requests missing", "[compact block reconstructor]") {
+    auto const block = make_block(6);
+    auto const compact = message::compact_block::factory_from_block(block);
+    auto const& transactions = block.transactions();
+
+    message::compact_block_reconstructor instance(compact);
+    chain::transaction::list const pool{transactions[1], transactions[3], transactions[4]};
+    instance.fill(pool);
+    REQUIRE(instance.missing() == 2);
+    REQUIRE( ! instance.complete());
+
+    // Slots 2 and 5, differentially encoded.
+    auto const request = instance.request();
+    REQUIRE(request.block_hash() == block.hash());
+    REQUIRE(request.indexes() == std::vector<uint64_t>{2, 2});
+
+    message::block_transactions const response(block.hash(), {transactions[2], transactions[5]});
+    auto const result = instance.complete(response);
+    REQUIRE(result);
+    REQUIRE(result->hash() == block.hash());
+    REQUIRE(result->transactions() == transactions);
+}
+
+TEST_CASE("compact block reconstructor  fill  colliding short ids  requests ambiguous", "[compact block reconstructor]") {
+    auto const block = make_block(4);
+    auto const compact = message::compact_block::factory_from_block(block);
+    auto const& transactions = block.transactions();
+
+    // Another transaction given the short id of slot 1.
+    chain::transaction const other(1, 99, chain::input::list{}, chain::output::list{});
+    chain::transaction::list const pool{transactions[1], transactions[2], transactions[3], other};
+
+    message::compact_block_reconstructor instance(compact);
+    auto const colliding = instance.to_short_id(transactions[1].hash());
+    std::vector<message::compact_block_reconstructor::short_id> const ids{
+        colliding,
+        instance.to_short_id(transactions[2].hash()),
+        instance.to_short_id(transactions[3].hash()),
+        colliding
+    };
+
+    instance.fill(pool, ids);
+    REQUIRE(instance.collisions() == 1);
+    REQUIRE(instance.missing() == 1);
+    REQUIRE( ! instance.complete());
+    REQUIRE(instance.request().indexes() == std::vector<uint64_t>{1});
+
+    // A later match of the ambiguous slot does not make it known.
+    instance.fill(pool);
+    REQUIRE(instance.collisions() == 1);
+    REQUIRE(instance.missing() == 1);
+
+    message::block_transactions const response(block.hash(), {transactions[1]});
+    auto const result = instance.complete(response);
+    REQUIRE(result);
+    REQUIRE(result->hash() == block.hash());
+}
+
+TEST_CASE("compact block reconstructor  complete  wrong transactions  merkle mismatch", "[compact block reconstructor]") {
+    auto const block = make_block(3);
+    auto const compact = message::compact_block::factory_from_block(block);
+    auto const& transactions = block.transactions();
+
+    message::compact_block_reconstructor instance(compact);
+    message::block_transactions const swapped(block.hash(), {transactions[2], transactions[1]});
+    REQUIRE(instance.complete(swapped).error() == error::merkle_mismatch);
+
+    message::block_transactions const short_answer(block.hash(), {transactions[1]});
+    REQUIRE(instance.complete(short_answer).error() == error::invalid_compact_block);
+}
+
+TEST_CASE("compact block reconstructor  construct  repeated short id  invalid", "[compact block reconstructor]") {
+    auto const block = make_block(3);
+    auto compact = message::compact_block::factory_from_block(block);
+    compact.short_ids()[1] = compact.short_ids()[0];
+
+    message::compact_block_reconstructor const instance(compact);
+    REQUIRE( ! instance.is_valid());
+}
+
+TEST_CASE("compact block reconstructor  construct  prefilled index out of range  invalid", "[compact block reconstructor]") {
+    auto const block = make_block(3);
+    auto compact = message::compact_block::factory_from_block(block);
+    compact.transactions()[0].set_index(3);
+
+    message::compact_block_reconstructor const instance(compact);
+    REQUIRE( ! instance.is_valid());
+}
+
+// End Test Suite
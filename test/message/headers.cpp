@@ -591,4 +591,82 @@ TEST_CASE("headers  is sequential  disordered  false", "[headers]") {
     REQUIRE( ! instance.is_sequential());
 }
 
+TEST_CASE("headers  hash elements  many headers  caches wire hashes", "[headers]") {
+    header::list elements;
+    for (uint32_t index = 0; index < 1100; ++index) {
+        elements.emplace_back(1u, null_hash, null_hash, index, 0x1d00ffffu, index);
+    }
+
+    headers const instance(elements);
+    instance.hash_elements(2);
+
+    for (size_t index = 0; index < elements.size(); ++index) {
+        auto const& element = instance.elements()[index];
+        REQUIRE(element.is_hash_cached());
+        REQUIRE(element.hash() == bitcoin_hash(static_cast<chain::header const&>(elements[index]).to_data()));
+    }
+}
+
+TEST_CASE("headers  check  genesis  success", "[headers]") {
+    headers const instance({header(chain::block::genesis_mainnet().header())});
+    REQUIRE(instance.check() == error::success);
+    REQUIRE(instance.elements().front().is_hash_cached());
+}
+
+TEST_CASE("headers  check  unlinked  orphan block", "[headers]") {
+    auto const genesis = chain::block::genesis_mainnet().header();
+    header const second{1u, null_hash, null_hash, genesis.timestamp() + 600, genesis.bits(), 0u};
+    headers const instance({header(genesis), second});
+    REQUIRE(instance.check() == error::orphan_block);
+}
+
+TEST_CASE("headers  accept  linked headers  success", "[headers]") {
+    uint32_t const bits = 0x207fffff;
+    uint32_t const timestamp = 1'600'000'000;
+    auto const pool = chain::make_chain_state(1000, 147, bits, timestamp);
+
+    header const first{1u, null_hash, null_hash, timestamp + 600, bits, 0u};
+    header const second{1u, first.hash(), null_hash, timestamp + 1200, bits, 0u};
+    header const third{1u, second.hash(), null_hash, timestamp + 1800, bits, 0u};
+    headers const instance({first, second, third});
+    REQUIRE(instance.accept(*pool) == error::success);
+}
+
+TEST_CASE("headers  accept  second header bad bits  incorrect proof of work", "[headers]") {
+    uint32_t const bits = 0x207fffff;
+    uint32_t const timestamp = 1'600'000'000;
+    auto const pool = chain::make_chain_state(1000, 147, bits, timestamp);
+
+    header const first{1u, null_hash, null_hash, timestamp + 600, bits, 0u};
+    header const second{1u, first.hash(), null_hash, timestamp + 1200, 0x1d00ffffu, 0u};
+    headers const instance({first, second});
+    REQUIRE(instance.accept(*pool) == error::incorrect_proof_of_work);
+}
+
+TEST_CASE("headers  accept  second header before median time past  timestamp too early", "[headers]") {
+    uint32_t const bits = 0x207fffff;
+    uint32_t const timestamp = 1'600'000'000;
+    auto const pool = chain::make_chain_state(1000, 147, bits, timestamp);
+
+    // The second header is after the median time past of the pool (timestamp
+    // - 3000) but not after that of the state promoted by the first header
+    // (timestamp - 2400).
+    header const first{1u, null_hash, null_hash, timestamp + 600, bits, 0u};
+    header const second{1u, first.hash(), null_hash, timestamp - 2700, bits, 0u};
+    headers const instance({first, second});
+    REQUIRE(instance.accept(*pool) == error::timestamp_too_early);
+}
+
+TEST_CASE("headers  accept  history too short to promote  operation failed", "[headers]") {
+    uint32_t const bits = 0x207fffff;
+    uint32_t const timestamp = 1'600'000'000;
+    auto const pool = chain::make_chain_state(1000, 5, bits, timestamp);
+
+    // The first header is accepted, the state it promotes needs more history.
+    header const first{1u, null_hash, null_hash, timestamp + 600, bits, 0u};
+    header const second{1u, first.hash(), null_hash, timestamp + 1200, bits, 0u};
+    REQUIRE(headers({first}).accept(*pool) == error::success);
+    REQUIRE(headers({first, second}).accept(*pool) == error::operation_failed);
+}
+
 // End Test Suite
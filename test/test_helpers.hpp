@@ -92,4 +92,43 @@ std::ostream& operator<<(std::ostream& os, prefilled_transaction const& x) {
 // #include <kth/infrastructure.hpp>
 #include <kth/domain.hpp>
 
+namespace kth::domain::chain {
+
+// A memory pool state at the height, without retargeting (work required is
+// the bits of the previous block), whose previous blocks (as many as the
+// history size) have the bits and are spaced ten minutes up to the timestamp.
+inline
+chain_state::ptr make_chain_state(size_t height, size_t history, uint32_t bits, uint32_t timestamp, uint32_t forks = machine::rule_fork::no_rules) {
+    chain_state::data values{};
+    values.height = height;
+    values.hash = null_hash;
+    values.allow_collisions_hash = null_hash;
+    values.bits.self = bits;
+    values.version.self = first_version;
+    values.timestamp.self = timestamp;
+    values.timestamp.retarget = timestamp;
+
+    for (size_t index = history; index != 0; --index) {
+        values.bits.ordered.push_back(bits);
+        values.timestamp.ordered.push_back(uint32_t(timestamp - (index - 1) * 600));
+    }
+
+#if defined(KTH_CURRENCY_BCH)
+    auto const abla_config = abla::default_config();
+    values.abla_state = abla::state(abla_config, 0);
+#endif
+
+    return std::make_shared<chain_state>(std::move(values), forks, chain_state::checkpoints{}, domain::config::network::mainnet
+#if defined(KTH_CURRENCY_BCH)
+        , chain_state::assert_anchor_block_info_t{0, 0, bits}
+        , uint32_t(2 * 24 * 60 * 60)
+        , abla_config
+        , bch_leibniz_activation_time
+        , bch_cantor_activation_time
+#endif
+    );
+}
+
+} // namespace kth::domain::chain
+
 #endif // KTH_DOMAIN_TEST_HELPERS_HPP
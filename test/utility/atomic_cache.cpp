@@ -0,0 +1,79 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <kth/domain/utility/atomic_cache.hpp>
+
+using namespace kth;
+using namespace kd;
+
+// Start Test Suite: atomic cache tests
+
+TEST_CASE("atomic cache  get  computes once  returns cached value", "[atomic cache]") {
+    atomic_cache<uint64_t> cache;
+    size_t calls = 0;
+    auto const compute = [&] { ++calls; return uint64_t(42); };
+
+    REQUIRE( ! cache.has_value());
+    REQUIRE(cache.get(compute) == 42u);
+    REQUIRE(cache.get(compute) == 42u);
+    REQUIRE(calls == 1u);
+    REQUIRE(cache.load() == uint64_t(42));
+}
+
+TEST_CASE("atomic cache  reset  recomputes", "[atomic cache]") {
+    atomic_cache<uint64_t> cache{1};
+    REQUIRE(cache.get([] { return uint64_t(2); }) == 1u);
+
+    cache.reset();
+    REQUIRE( ! cache.has_value());
+    REQUIRE(cache.load() == std::nullopt);
+    REQUIRE(cache.get([] { return uint64_t(2); }) == 2u);
+}
+
+TEST_CASE("atomic cache  copy  carries published value", "[atomic cache]") {
+    atomic_cache<hash_digest> empty;
+    auto const empty_copy = empty;
+    REQUIRE( ! empty_copy.has_value());
+
+    atomic_cache<hash_digest> cache;
+    cache.store(null_hash);
+    auto const copy = cache;
+    REQUIRE(copy.load() == null_hash);
+
+    atomic_cache<hash_digest> moved{std::move(cache)};
+    REQUIRE(moved.load() == null_hash);
+}
+
+TEST_CASE("atomic cache  get  concurrent readers  same value", "[atomic cache]") {
+    atomic_cache<hash_digest> cache;
+    auto const expected = bitcoin_hash(to_chunk(std::string("knuth")));
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::thread> threads;
+
+    for (size_t thread = 0; thread < 8; ++thread) {
+        threads.emplace_back([&] {
+            for (size_t i = 0; i < 1000; ++i) {
+                auto const value = cache.get([] { return bitcoin_hash(to_chunk(std::string("knuth"))); });
+                if (value != expected) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(mismatches == 0u);
+    REQUIRE(cache.load() == expected);
+}
+
+// End Test Suite
@@ -0,0 +1,69 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test_helpers.hpp>
+
+#include <kth/domain/utility/cuckoo_cache.hpp>
+
+using namespace kth;
+using namespace kd;
+
+// Start Test Suite: cuckoo cache tests
+
+namespace {
+
+hash_digest make_entry(uint8_t seed) {
+    data_chunk const data{seed};
+    return sha256_hash(data);
+}
+
+} // namespace
+
+TEST_CASE("cuckoo cache  contains  inserted  hit", "[cuckoo cache]") {
+    cuckoo_cache cache(1024, 2);
+    auto const entry = make_entry(1);
+    REQUIRE( ! cache.contains(entry));
+    cache.insert(entry);
+    REQUIRE(cache.contains(entry));
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 1);
+}
+
+TEST_CASE("cuckoo cache  insert  over capacity  bounded", "[cuckoo cache]") {
+    cuckoo_cache cache(64 * sizeof(hash_digest), 4);
+    REQUIRE(cache.capacity() == 64);
+
+    for (size_t seed = 0; seed < 255; ++seed) {
+        cache.insert(make_entry(uint8_t(seed)));
+    }
+
+    size_t found = 0;
+    for (size_t seed = 0; seed < 255; ++seed) {
+        found += cache.contains(make_entry(uint8_t(seed))) ? 1 : 0;
+    }
+
+    REQUIRE(found <= 64);
+    REQUIRE(found > 0);
+    REQUIRE(cache.capacity() == 64);
+}
+
+TEST_CASE("cuckoo cache  clear  empty", "[cuckoo cache]") {
+    cuckoo_cache cache(1024, 2);
+    auto const entry = make_entry(1);
+    cache.insert(entry);
+    cache.clear();
+    REQUIRE(cache.hits() == 0);
+    REQUIRE( ! cache.contains(entry));
+}
+
+TEST_CASE("cuckoo cache  resize  zero  never contains", "[cuckoo cache]") {
+    cuckoo_cache cache(1024, 2);
+    cache.resize(0);
+    auto const entry = make_entry(1);
+    cache.insert(entry);
+    REQUIRE(cache.capacity() == 0);
+    REQUIRE( ! cache.contains(entry));
+}
+
+// End Test Suite
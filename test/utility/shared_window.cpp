@@ -0,0 +1,82 @@
+// Copyright (c) 2016-2025 Knuth Project developers.
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <deque>
+#include <utility>
+
+#include <test_helpers.hpp>
+
+#include <kth/domain/utility/shared_window.hpp>
+
+using namespace kth;
+using namespace kd;
+
+// Start Test Suite: shared window tests
+
+TEST_CASE("shared window  push back  pop front  sliding values", "[shared window]") {
+    shared_window<uint32_t> window;
+    std::deque<uint32_t> expected;
+
+    for (uint32_t value = 0; value < 1000; ++value) {
+        window.push_back(value);
+        expected.push_back(value);
+        if (expected.size() > 147) {
+            window.pop_front();
+            expected.pop_front();
+        }
+    }
+
+    REQUIRE(window.size() == 147);
+    REQUIRE(window.front() == 853);
+    REQUIRE(window.back() == 999);
+    REQUIRE(std::equal(window.begin(), window.end(), expected.begin(), expected.end()));
+}
+
+TEST_CASE("shared window  copy  append at end  shares storage", "[shared window]") {
+    shared_window<uint32_t> const first{1, 2, 3};
+    auto second = first;
+    second.push_back(4);
+    second.pop_front();
+
+    REQUIRE(second.is_shared());
+    REQUIRE(&std::as_const(second).front() == &first[1]);
+    REQUIRE(first == shared_window<uint32_t>{1, 2, 3});
+    REQUIRE(second == shared_window<uint32_t>{2, 3, 4});
+}
+
+TEST_CASE("shared window  copies  append at same position  independent", "[shared window]") {
+    shared_window<uint32_t> const parent{1, 2};
+    auto left = parent;
+    auto right = parent;
+    left.push_back(3);
+    right.push_back(4);
+
+    REQUIRE(parent == shared_window<uint32_t>{1, 2});
+    REQUIRE(left == shared_window<uint32_t>{1, 2, 3});
+    REQUIRE(right == shared_window<uint32_t>{1, 2, 4});
+}
+
+TEST_CASE("shared window  mutable access  unshares", "[shared window]") {
+    shared_window<uint32_t> const original{1, 2, 3};
+    auto copy = original;
+    copy[0] = 9;
+
+    REQUIRE( ! copy.is_shared());
+    REQUIRE(original[0] == 1);
+    REQUIRE(copy[0] == 9);
+}
+
+TEST_CASE("shared window  resize  value initialized", "[shared window]") {
+    shared_window<uint32_t> window{5};
+    window.resize(3);
+    REQUIRE(window == shared_window<uint32_t>{5, 0, 0});
+
+    window.resize(1);
+    REQUIRE(window == shared_window<uint32_t>{5});
+
+    window.clear();
+    REQUIRE(window.empty());
+}
+
+// End Test Suite